@@ -0,0 +1,264 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Accuracy and speed of the calibration kernels (convert.c), against the
+ * float conversions that algorithm_step() used to do.
+ *
+ * Calibrations are drawn at random from the ranges that calibrate.c accepts,
+ * and derived as ReadCalibrationFromSettings() does. The kernels are checked
+ * against the calibration evaluated in double precision; the differences
+ * from the float conversions, which round the gains to float and the output
+ * offsets to whole codes, are shown for comparison. Errors are in codec
+ * LSBs; inputs are compared as volts, scaled by the input's gain.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "convert.h"
+#include "host.h"
+
+enum { kCalibrations = 200 };
+enum { kBenchBlocks = 1 << 12 };
+
+// the calibration in double precision
+static double exactZeroIn[6], exactBf[6];
+static double exactDd[4], exactErf[4];
+
+static int randomRange( int min, int max )
+{
+    return min + (int)( ( (double)rand() / RAND_MAX ) * ( max - min ) );
+}
+
+static void randomCalibration(void)
+// as ReadCalibrationFromSettings(), from random settings
+{
+    static const BYTE half[6] = { 0, 0, 1, 1, 0, 1 };
+    static const BYTE in[6] = { 0, 1, 0, 1, 2, 2 };
+    int w;
+    for ( w=0; w<6; ++w )
+    {
+        int zeroIn = randomRange( -0x100000, 0x100000 );
+        int threeVolt = randomRange( zeroIn + 0x100000, 0x380000 );
+        double Bf = ( threeVolt - zeroIn ) / 3.0;
+        _halfState* h = &halfState[ half[w] ];
+        h->Brf[ in[w] ] = 1.0 / Bf;
+        inputCalibrations[w].Brf = h->Brf[ in[w] ];
+        inputCalibrations[w].mABrf = ( -zeroIn ) * inputCalibrations[w].Brf;
+        convertSetInputCalibration( w, zeroIn, Bf );
+        exactZeroIn[w] = zeroIn;
+        exactBf[w] = Bf;
+        if ( in[w] < 2 )
+        {
+            int zeroOut = randomRange( -0x100000, 0x100000 );
+            int halfOut = randomRange( 0x200000, 0x600000 );
+            double Df = ( zeroOut - zeroIn )/Bf;
+            double Ef = ( halfOut - zeroOut ) / ( Bf * 0x400000 );
+            double Dd = Df / Ef;
+            h->Dd[ in[w] ] = Dd;
+            h->Ddf[ in[w] ] = Dd;
+            h->Erf[ in[w] ] = 1.0 / Ef;
+            convertSetOutputCalibration( 2*half[w] + in[w], -Dd, 1.0 / Ef );
+            exactDd[ 2*half[w] + in[w] ] = Dd;
+            exactErf[ 2*half[w] + in[w] ] = 1.0 / Ef;
+        }
+    }
+}
+
+static void randomBlocks( _algorithm_blocks* blocks )
+{
+    int i, j;
+    for ( i=0; i<3; ++i )
+        for ( j=0; j<2*k_maxFramesPerBlock*2; ++j )
+            blocks->in[i][j] = ( rand() & 0xffffff ) - 0x800000;
+}
+
+static void randomVolts( float volts[4][k_maxFramesPerBlock] )
+// a little beyond the outputs' range, so the clamping is tested too
+{
+    int i, j;
+    for ( i=0; i<4; ++i )
+        for ( j=0; j<k_maxFramesPerBlock; ++j )
+            volts[i][j] = 24.0f * rand() / RAND_MAX - 12.0f;
+}
+
+static void floatInputs( const _algorithm_blocks* blocks, int ping, float volts[6][k_maxFramesPerBlock] )
+{
+    int i;
+    for ( i=0; i<k_maxFramesPerBlock; ++i )
+    {
+        volts[0][i] = blocks->in[0][ ping + 2*i + 0 ] * inputCalibrations[0].Brf + inputCalibrations[0].mABrf;
+        volts[1][i] = blocks->in[0][ ping + 2*i + 1 ] * inputCalibrations[1].Brf + inputCalibrations[1].mABrf;
+        volts[2][i] = blocks->in[1][ ping + 2*i + 0 ] * inputCalibrations[2].Brf + inputCalibrations[2].mABrf;
+        volts[3][i] = blocks->in[1][ ping + 2*i + 1 ] * inputCalibrations[3].Brf + inputCalibrations[3].mABrf;
+        volts[4][i] = blocks->in[2][ ping + 2*i + 1 ] * inputCalibrations[4].Brf + inputCalibrations[4].mABrf;
+        volts[5][i] = blocks->in[2][ ping + 2*i + 0 ] * inputCalibrations[5].Brf + inputCalibrations[5].mABrf;
+    }
+}
+
+static void floatOutputs( const float volts[4][k_maxFramesPerBlock], _algorithm_blocks* blocks, int ping )
+{
+    int i;
+    for ( i=0; i<k_maxFramesPerBlock; ++i )
+    {
+        int c1 = ( (int)( volts[0][i] * halfState[0].Erf[0] ) ) - halfState[0].Dd[0];
+        int c2 = ( (int)( volts[1][i] * halfState[0].Erf[1] ) ) - halfState[0].Dd[1];
+        int c3 = ( (int)( volts[2][i] * halfState[1].Erf[0] ) ) - halfState[1].Dd[0];
+        int c4 = ( (int)( volts[3][i] * halfState[1].Erf[1] ) ) - halfState[1].Dd[1];
+        CLAMP( c1 );
+        CLAMP( c2 );
+        CLAMP( c3 );
+        CLAMP( c4 );
+        blocks->out[0][ping+2*i+1] = c1;
+        blocks->out[0][ping+2*i+0] = c2;
+        blocks->out[1][ping+2*i+1] = c3;
+        blocks->out[1][ping+2*i+0] = c4;
+    }
+}
+
+static void voltsToQ24( const float volts[4][k_maxFramesPerBlock], int q[4][k_maxFramesPerBlock] )
+{
+    int i, j;
+    for ( i=0; i<4; ++i )
+        for ( j=0; j<k_maxFramesPerBlock; ++j )
+            q[i][j] = volts[i][j] * kQ24One;
+}
+
+static _algorithm_blocks blocks, reference;
+
+// globals, so the compiler can't discard the benchmarked work
+float benchVolts[6][k_maxFramesPerBlock];
+int benchQ[6][k_maxFramesPerBlock];
+float benchOutVolts[4][k_maxFramesPerBlock];
+int benchOutQ[4][k_maxFramesPerBlock];
+
+int main( int argc, char** argv )
+{
+    int repeats = ( argc > 1 ) ? atoi( argv[1] ) : 10;
+    if ( repeats < 1 )
+    {
+        fprintf( stderr, "usage: convert_bench [repeats]\n" );
+        return 2;
+    }
+    srand( 1 );
+
+    // accuracy
+    double inputError = 0.0, inputFloatError = 0.0;
+    double outputError = 0.0;
+    int outputFloatError = 0;
+    int c, i, j, ping;
+    for ( c=0; c<kCalibrations; ++c )
+    {
+        randomCalibration();
+        randomBlocks( &blocks );
+        for ( ping=0; ping<=2*k_maxFramesPerBlock; ping += 2*k_maxFramesPerBlock )
+        {
+            float volts[6][k_maxFramesPerBlock];
+            int q[6][k_maxFramesPerBlock];
+            floatInputs( &blocks, ping, volts );
+            convertInputs( &blocks, ping, k_maxFramesPerBlock, q );
+            for ( i=0; i<6; ++i )
+                for ( j=0; j<k_maxFramesPerBlock; ++j )
+                {
+                    static const BYTE buffer[6] = { 0, 0, 1, 1, 2, 2 };
+                    static const BYTE side[6] = { 0, 1, 0, 1, 1, 0 };
+                    int code = blocks.in[ buffer[i] ][ ping + 2*j + side[i] ];
+                    double v = q[i][j] / (double)kQ24One;
+                    double e = fabs( v - ( code - exactZeroIn[i] ) / exactBf[i] ) * exactBf[i];
+                    if ( e > inputError )
+                        inputError = e;
+                    e = fabs( v - volts[i][j] ) * exactBf[i];
+                    if ( e > inputFloatError )
+                        inputFloatError = e;
+                }
+
+            float outVolts[4][k_maxFramesPerBlock];
+            int outQ[4][k_maxFramesPerBlock];
+            randomVolts( outVolts );
+            voltsToQ24( outVolts, outQ );
+            floatOutputs( outVolts, &reference, ping );
+            convertOutputs( outQ, &blocks, ping, k_maxFramesPerBlock );
+            for ( i=0; i<4; ++i )
+                for ( j=0; j<k_maxFramesPerBlock; ++j )
+                {
+                    int k = ping + 2*j + 1 - ( i & 1 );
+                    int code = blocks.out[ i >> 1 ][k];
+                    double exact = outQ[i][j] / (double)kQ24One * exactErf[i] - exactDd[i];
+                    APPLY_RANGE( exact, -0x800000, 0x7fffff );
+                    double e = fabs( code - exact );
+                    if ( e > outputError )
+                        outputError = e;
+                    int f = abs( code - reference.out[ i >> 1 ][k] );
+                    if ( f > outputFloatError )
+                        outputFloatError = f;
+                }
+        }
+    }
+    printf( "# %d random calibrations, errors in codec LSBs\n", kCalibrations );
+    printf( "#          error  vs. float\n" );
+    printf( "inputs    %5.3f  %5.3f\n", inputError, inputFloatError );
+    printf( "outputs   %5.3f  %5d\n", outputError, outputFloatError );
+
+    // speed, per frame of all channels, the fastest of the repeats
+    double best[4] = { 0.0 };
+    int r;
+    for ( r=0; r<repeats; ++r )
+    {
+        randomVolts( benchOutVolts );
+        voltsToQ24( benchOutVolts, benchOutQ );
+        double ns[4];
+        int b;
+        uint64_t t0 = hostNanoseconds();
+        for ( b=0; b<kBenchBlocks; ++b )
+            floatInputs( &blocks, ( b & 1 ) * 2*k_maxFramesPerBlock, benchVolts );
+        uint64_t t1 = hostNanoseconds();
+        for ( b=0; b<kBenchBlocks; ++b )
+            convertInputs( &blocks, ( b & 1 ) * 2*k_maxFramesPerBlock, k_maxFramesPerBlock, benchQ );
+        uint64_t t2 = hostNanoseconds();
+        for ( b=0; b<kBenchBlocks; ++b )
+            floatOutputs( benchOutVolts, &blocks, ( b & 1 ) * 2*k_maxFramesPerBlock );
+        uint64_t t3 = hostNanoseconds();
+        for ( b=0; b<kBenchBlocks; ++b )
+            convertOutputs( benchOutQ, &blocks, ( b & 1 ) * 2*k_maxFramesPerBlock, k_maxFramesPerBlock );
+        uint64_t t4 = hostNanoseconds();
+        ns[0] = (double)( t1 - t0 );
+        ns[1] = (double)( t2 - t1 );
+        ns[2] = (double)( t3 - t2 );
+        ns[3] = (double)( t4 - t3 );
+        for ( i=0; i<4; ++i )
+        {
+            ns[i] /= (double)kBenchBlocks * k_maxFramesPerBlock;
+            if ( r == 0 || ns[i] < best[i] )
+                best[i] = ns[i];
+        }
+    }
+    printf( "# ns per frame     float  kernel\n" );
+    printf( "inputs (6)      %7.2f %7.2f\n", best[0], best[1] );
+    printf( "outputs (4)     %7.2f %7.2f\n", best[2], best[3] );
+
+    return ( inputError > 1.0 || outputError > 1.0 ) ? 1 : 0;
+}
@@ -0,0 +1,46 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * The drawing that the algorithms call, for the host tools that don't
+ * draw anything (screen_test links the real display.c and text.c).
+ */
+
+#include "app.h"
+#include "display.h"
+
+int displayWindowWidth = 128;
+
+void setDisplayWindow( int x, int width )
+{
+    displayWindowWidth = width;
+}
+
+void drawString88( int x, int y, const char* str )
+{
+}
+
+void orScreen( int x0, int x1, unsigned int mask )
+{
+}
@@ -0,0 +1,1381 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Virtual disting EX.
+ *
+ * Runs the unmodified firmware - APP_Initialize() and the display loop -
+ * against emulated peripherals, on a virtual clock that only advances
+ * when the firmware does something: a fixed cost per special function
+ * register access, a fixed cost per function call, and a configurable
+ * cost per algorithm_step(). Audio DMA, the UARTs, the I2C slave, the
+ * display SPIs and their DMAs, the ADC, timer 3 and the flash controller
+ * all run on that clock, so every run of the same script is identical.
+ *
+ * The point is to find the worst-case delay between an audio block
+ * becoming ready and the firmware getting round to processing it, and
+ * what the firmware was doing at the time, under scripted MIDI, I2C and
+ * front panel activity.
+ *
+ * Interrupts are taken at register accesses and function calls, and
+ * nest by priority level as they do on the hardware.
+ */
+
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "app.h"
+#include "algorithm.h"
+#include "cpuload.h"
+#include "display.h"
+#include "nvm.h"
+
+#define NO_INSTRUMENT __attribute__((no_instrument_function))
+
+// the firmware's interrupt handlers
+void UART2RXInterruptHandler(void);
+void UART4RXInterruptHandler(void);
+void I2C4SlaveInterruptHandler(void);
+void DMA5InterruptHandler(void) __attribute__((weak));
+
+extern BYTE doServiceAudio;
+
+int hostPeaksNVM[0x4000/4];
+int hostSettingsNVM[0x4000/4];
+char hostSRAM[SRAM_SIZE] __attribute__((aligned(16)));
+
+enum {
+    kCyclesPerMs        = SYS_CLK_FREQ / 1000,
+    kCyclesPerUARTByte  = (int)( SYS_CLK_FREQ * 10ull / 31250 ),
+    kCyclesPerSPIByte   = (int)( SYS_CLK_FREQ * 8ull / 800000 ),
+    kCyclesPerI2CByte   = (int)( SYS_CLK_FREQ * 9ull / 100000 ),
+    kCyclesPerADC       = SYS_CLK_FREQ / 500000,
+    kCyclesPerEncPhase  = 2 * kCyclesPerMs,
+
+    // nominal flash timings
+    kCyclesNVMWord      = SYS_CLK_FREQ / 50000,
+    kCyclesNVMRow       = 2 * kCyclesPerMs,
+    kCyclesNVMErase     = 20 * kCyclesPerMs,
+
+    kUARTFIFOSize       = 8,
+    kSPIFIFOSize        = 16,
+    kStackSize          = 128,
+    kStackSnapshot      = 8,
+    kHistogramSize      = 21,
+    kHostSentinel       = 0xA5A5A5A5u,
+};
+
+static struct {
+    int         cyclesPerAccess;
+    int         cyclesPerCall;
+    int         stepPercent;
+    double      seconds;
+    int         verbose;
+    FILE*       midiOut;
+} config = { 10, 20, 50, 2.0, 0, NULL };
+
+// virtual time, in system clock cycles
+static uint64_t cycles = 0;
+static uint64_t endCycles = 0;
+static jmp_buf endJump;
+static BYTE running = 0;
+
+//
+// script events
+//
+
+enum {
+    kEventUART2,
+    kEventUART4,
+    kEventI2C,
+    kEventPortH,
+    kEventPortB,
+    kEventPot,
+};
+
+typedef struct {
+    uint64_t    when;
+    int         type;
+    int         a;
+    int         b;
+} _event;
+
+static _event* events = NULL;
+static int numEvents = 0;
+static int nextEvent = 0;
+
+//
+// interrupt controller
+//
+
+static BYTE interruptsEnabled = 1;
+static int currentIPL = 0;
+static BYTE intEnable[ INT_SOURCE_NUMBER ];
+static BYTE intFlag[ INT_SOURCE_NUMBER ];
+
+//
+// peripherals
+//
+
+typedef struct {
+    BYTE        rx[ kUARTFIFOSize ];
+    int         rxCount;
+    uint64_t    rxLineFree;
+    uint64_t    txBusyUntil;
+    int         overruns;
+    int         bytesIn;
+    int         bytesOut;
+} _uart;
+
+static _uart uart2, uart4;
+
+typedef struct {
+    uint64_t    busyUntil;
+    int         bytes;
+    int         dataBytes;
+} _spi;
+
+static _spi spi1, spi5;
+static int displayFrames = 0;
+static int displayFrameBytes = 0;
+
+// the main display's controller, in vertical addressing mode, to check
+// what it shows against the firmware's idea of it
+static struct {
+    BYTE        ram[128][4];
+    BYTE        command[3];
+    int         commandLength;
+    int         x0, x1, p0, p1;
+    int         x, p;
+} oled = { .x1 = 127, .p1 = 3 };
+
+// the display DMAs, each feeding an SPI from the screen
+typedef struct {
+    _hostSFR*   con;
+    _hostSFR*   intr;
+    _spi*       spi;
+    const BYTE* src;
+    int         remaining;
+} _displayDMA;
+
+static _displayDMA displayDMAs[2] = {
+    { &hostSFR_DCH1CON, &hostSFR_DCH1INT, &spi5 },
+    { &hostSFR_DCH2CON, &hostSFR_DCH2INT, &spi1 },
+};
+
+typedef struct {
+    BYTE        pending;
+    BYTE        data;
+    uint64_t    lineFree;
+    int         overflows;
+    int         bytesIn;
+    int         bytesOut;
+} _i2c;
+
+static _i2c i2c4;
+
+static int potValue[2] = { 2048, 2048 };
+static unsigned int portHInputs = 0xffff;
+static unsigned int portBInputs = 0xffff;
+static int encPhase[2] = { 0, 0 };
+static uint64_t encLineFree[2] = { 0, 0 };
+
+static BYTE adcPending = 0;
+static uint64_t adcReadyAt = 0;
+
+static BYTE timer3Running = 0;
+static uint64_t timer3Start = 0;
+
+static int nvmKeyState = 0;
+static int nvmOp = 0;
+static uint64_t nvmDoneAt = 0;
+
+//
+// audio
+//
+
+static BYTE audioRunning = 0;
+static BYTE audioHalf = 0;
+static uint64_t audioNextBlock = 0;
+static uint64_t blockCycles = 0;
+
+// per half of the DMA buffers
+static struct {
+    uint64_t    ready;
+    BYTE        pending;
+    void*       stack[ kStackSnapshot ];
+} halves[2];
+
+static struct {
+    uint64_t    blocks;
+    uint64_t    latencyTotal;
+    uint64_t    latencyMax;
+    uint64_t    latencyMaxAt;
+    void*       latencyMaxStack[ kStackSnapshot ];
+    uint64_t    intervalMax;
+    uint64_t    intervalMaxAt;
+    uint64_t    lastStart;
+    uint64_t    missedDeadlines;
+    uint64_t    dropped;
+    uint64_t    repeated;
+    uint64_t    histogram[ kHistogramSize ];
+} audio;
+
+// the block that algorithm_step() is working on
+static BYTE inStep = 0;
+static int stepHalf = -1;
+
+//
+// call stack, from -finstrument-functions
+//
+
+static void* callStack[ kStackSize ];
+static int callDepth = 0;
+
+static _hostSFR* lastSFR = NULL;
+static unsigned int lastValue = 0;
+
+NO_INSTRUMENT static void snapshotStack( void** dst )
+{
+    int i;
+    for ( i=0; i<kStackSnapshot; ++i )
+    {
+        int d = callDepth - 1 - i;
+        dst[i] = ( d >= 0 && d < kStackSize ) ? callStack[d] : NULL;
+    }
+}
+
+NO_INSTRUMENT static void advance( int cost );
+NO_INSTRUMENT static void commit(void);
+
+NO_INSTRUMENT void __cyg_profile_func_enter( void* fn, void* site )
+{
+    if ( callDepth < kStackSize )
+        callStack[ callDepth ] = fn;
+    callDepth += 1;
+
+    // algorithm_step() is costed as a whole
+    if ( inStep )
+        return;
+    if ( running )
+    {
+        // a write lands straight away on the hardware, so don't leave it
+        // pending until the firmware next touches a register
+        commit();
+        advance( config.cyclesPerCall );
+    }
+    else
+        cycles += config.cyclesPerCall;
+}
+
+NO_INSTRUMENT void __cyg_profile_func_exit( void* fn, void* site )
+{
+    callDepth -= 1;
+}
+
+// the firmware's algorithm_step(), renamed in the emulator build
+void firmware_algorithm_step( _algorithm_blocks* blocks, int ping );
+
+void algorithm_step( _algorithm_blocks* blocks, int ping )
+{
+    uint64_t now = cycles;
+    int h = ping ? 1 : 0;
+
+    stepHalf = -1;
+    if ( halves[h].pending )
+    {
+        halves[h].pending = 0;
+        stepHalf = h;
+
+        uint64_t latency = now - halves[h].ready;
+        audio.blocks += 1;
+        audio.latencyTotal += latency;
+        if ( latency > audio.latencyMax )
+        {
+            audio.latencyMax = latency;
+            audio.latencyMaxAt = halves[h].ready;
+            memcpy( audio.latencyMaxStack, halves[h].stack, sizeof audio.latencyMaxStack );
+        }
+        int bucket = ( latency * 10 ) / blockCycles;
+        if ( bucket >= kHistogramSize )
+            bucket = kHistogramSize - 1;
+        audio.histogram[ bucket ] += 1;
+
+        if ( audio.lastStart && now - audio.lastStart > audio.intervalMax )
+        {
+            audio.intervalMax = now - audio.lastStart;
+            audio.intervalMaxAt = now;
+        }
+        audio.lastStart = now;
+    }
+    else if ( audio.blocks )
+    {
+        // this half has already been processed since the DMA last filled it
+        audio.repeated += 1;
+    }
+
+    inStep = 1;
+    firmware_algorithm_step( blocks, ping );
+    inStep = 0;
+    cycles += ( blockCycles * config.stepPercent ) / 100;
+
+    // the output has to be ready before the DMA comes back round to it
+    if ( stepHalf >= 0 && cycles > halves[ stepHalf ].ready + blockCycles )
+        audio.missedDeadlines += 1;
+}
+
+static const char* symbolName( void* fn )
+{
+    static char buf[256];
+    Dl_info info;
+    if ( !fn || !dladdr( fn, &info ) )
+        return "?";
+    if ( info.dli_sname )
+        return info.dli_sname;
+
+    // static functions aren't in the dynamic symbol table
+    snprintf( buf, sizeof buf, "addr2line -f -e %s %p", info.dli_fname, (void*)( (char*)fn - (char*)info.dli_fbase ) );
+    FILE* p = popen( buf, "r" );
+    if ( p )
+    {
+        int ok = fgets( buf, sizeof buf, p ) != NULL;
+        pclose( p );
+        if ( ok && buf[0] != '?' )
+        {
+            buf[ strcspn( buf, "\n" ) ] = 0;
+            return buf;
+        }
+    }
+    snprintf( buf, sizeof buf, "%p", fn );
+    return buf;
+}
+
+//
+// audio DMA
+//
+
+NO_INSTRUMENT static void startAudio(void)
+{
+    // DCH5DSIZ covers two blocks, of 8 bytes per frame
+    int framesPerBlock = hostSFR_DCH5DSIZ.reg / 16;
+    if ( framesPerBlock <= 0 )
+        return;
+    blockCycles = ( (uint64_t)framesPerBlock * SYS_CLK_FREQ ) / SAMPLE_RATE;
+    audioRunning = 1;
+    audioHalf = 0;
+    audioNextBlock = cycles + blockCycles;
+}
+
+NO_INSTRUMENT static void audioBlockReady(void)
+{
+    // CHDHIF at half way, CHDDIF at the end
+    int h = audioHalf;
+    hostSFR_DCH5INT.reg |= h ? BIT_5 : BIT_4;
+    audioHalf ^= 1;
+
+    if ( !doServiceAudio )
+        return;
+    if ( halves[h].pending && audio.blocks )
+        audio.dropped += 1;
+    halves[h].pending = 1;
+    halves[h].ready = audioNextBlock;
+    snapshotStack( halves[h].stack );
+}
+
+//
+// interrupts
+//
+
+void PLIB_INT_SourceEnable( INT_MODULE_ID index, INT_SOURCE source )
+{
+    intEnable[ source ] = 1;
+}
+
+void PLIB_INT_SourceDisable( INT_MODULE_ID index, INT_SOURCE source )
+{
+    intEnable[ source ] = 0;
+}
+
+bool PLIB_INT_SourceFlagGet( INT_MODULE_ID index, INT_SOURCE source )
+{
+    return intFlag[ source ];
+}
+
+void PLIB_INT_SourceFlagClear( INT_MODULE_ID index, INT_SOURCE source )
+{
+    intFlag[ source ] = 0;
+}
+
+unsigned int hostDisableInterrupts(void)
+{
+    unsigned int status = interruptsEnabled;
+    interruptsEnabled = 0;
+    return status;
+}
+
+unsigned int hostEnableInterrupts(void)
+{
+    unsigned int status = interruptsEnabled;
+    interruptsEnabled = 1;
+    return status;
+}
+
+// what the interrupt handler that's running interrupted
+static void* exceptionFn = NULL;
+
+unsigned int hostExceptionPC(void)
+{
+    // as an offset into the executable, for addr2line, since the firmware
+    // keeps 32 bits
+    Dl_info info;
+    if ( !exceptionFn || !dladdr( exceptionFn, &info ) )
+        return 0;
+    return (unsigned int)( (char*)exceptionFn - (char*)info.dli_fbase );
+}
+
+NO_INSTRUMENT static void* exceptionAddress( unsigned int offset )
+{
+    Dl_info info;
+    if ( !offset || !dladdr( (void*)hostExceptionPC, &info ) )
+        return NULL;
+    return (char*)info.dli_fbase + offset;
+}
+
+NO_INSTRUMENT static void callISR( void (*handler)(void), int ipl )
+{
+    int saved = currentIPL;
+    void* savedFn = exceptionFn;
+    commit();
+    currentIPL = ipl;
+    exceptionFn = ( callDepth > 0 && callDepth <= kStackSize ) ? callStack[ callDepth-1 ] : NULL;
+    handler();
+    commit();
+    exceptionFn = savedFn;
+    currentIPL = saved;
+}
+
+NO_INSTRUMENT static void takeInterrupts(void)
+{
+    if ( !interruptsEnabled )
+        return;
+
+    // in priority order, each only preempting lower priorities,
+    // with the levels the firmware sets up
+    intFlag[ INT_SOURCE_DMA_5 ] |= ( ( hostSFR_DCH5INT.reg >> 16 ) & hostSFR_DCH5INT.reg & ( BIT_4 | BIT_5 ) ) != 0;
+    if ( DMA5InterruptHandler && currentIPL < 6 && intEnable[ INT_SOURCE_DMA_5 ] && intFlag[ INT_SOURCE_DMA_5 ] )
+        callISR( DMA5InterruptHandler, 6 );
+
+    intFlag[ INT_SOURCE_USART_2_RECEIVE ] |= ( uart2.rxCount > 0 );
+    if ( currentIPL < 4 && intEnable[ INT_SOURCE_USART_2_RECEIVE ] && intFlag[ INT_SOURCE_USART_2_RECEIVE ] )
+        callISR( UART2RXInterruptHandler, 4 );
+
+    intFlag[ INT_SOURCE_I2C_4_SLAVE ] |= i2c4.pending;
+    if ( currentIPL < 3 && intEnable[ INT_SOURCE_I2C_4_SLAVE ] && intFlag[ INT_SOURCE_I2C_4_SLAVE ] )
+    {
+        callISR( I2C4SlaveInterruptHandler, 3 );
+        i2c4.pending = 0;
+    }
+
+    intFlag[ INT_SOURCE_USART_4_RECEIVE ] |= ( uart4.rxCount > 0 );
+    if ( currentIPL < 1 && intEnable[ INT_SOURCE_USART_4_RECEIVE ] && intFlag[ INT_SOURCE_USART_4_RECEIVE ] )
+        callISR( UART4RXInterruptHandler, 1 );
+}
+
+//
+// register side effects
+//
+
+NO_INSTRUMENT static void uartReceive( _uart* u, BYTE b )
+{
+    u->bytesIn += 1;
+    if ( u->rxCount == kUARTFIFOSize )
+    {
+        u->overruns += 1;
+        return;
+    }
+    u->rx[ u->rxCount++ ] = b;
+}
+
+NO_INSTRUMENT static unsigned int uartStatus( _uart* u, unsigned int reg )
+{
+    reg &= ~( BIT_0 | BIT_8 | BIT_9 );
+    if ( u->rxCount > 0 )
+        reg |= BIT_0;           // URXDA
+    uint64_t queued = u->txBusyUntil > cycles ? ( u->txBusyUntil - cycles + kCyclesPerUARTByte - 1 ) / kCyclesPerUARTByte : 0;
+    if ( queued == 0 )
+        reg |= BIT_8;           // TRMT
+    if ( queued > kUARTFIFOSize )
+        reg |= BIT_9;           // UTXBF
+    return reg;
+}
+
+NO_INSTRUMENT static BYTE uartRead( _uart* u )
+{
+    if ( u->rxCount == 0 )
+        return 0;
+    BYTE b = u->rx[0];
+    u->rxCount -= 1;
+    memmove( u->rx, u->rx + 1, u->rxCount );
+    return b;
+}
+
+NO_INSTRUMENT static void uartWrite( _uart* u, BYTE b )
+{
+    uint64_t start = u->txBusyUntil > cycles ? u->txBusyUntil : cycles;
+    u->txBusyUntil = start + kCyclesPerUARTByte;
+    u->bytesOut += 1;
+    if ( u == &uart4 && config.midiOut )
+        fputc( b, config.midiOut );
+    if ( config.verbose )
+        printf( "%10.3f ms  %s out %02x\n", cycles / (double)kCyclesPerMs, u == &uart4 ? "MIDI" : "select", b );
+}
+
+NO_INSTRUMENT static uint64_t spiQueued( _spi* s )
+// bytes in the FIFO and the shift register
+{
+    return s->busyUntil > cycles ? ( s->busyUntil - cycles + kCyclesPerSPIByte - 1 ) / kCyclesPerSPIByte : 0;
+}
+
+NO_INSTRUMENT static unsigned int spiStatus( _spi* s, unsigned int reg )
+{
+    reg &= ~( BIT_0 | BIT_1 | BIT_3 | BIT_5 | BIT_11 );
+    reg |= BIT_5;               // SPIRBE
+    uint64_t queued = spiQueued( s );
+    if ( queued > kSPIFIFOSize )
+        reg |= BIT_1;           // SPITBF
+    if ( queued <= 1 )
+        reg |= BIT_3;           // SPITBE
+    if ( queued > 0 )
+        reg |= BIT_11;          // SPIBUSY
+    return reg;
+}
+
+NO_INSTRUMENT static int oledArguments( BYTE c )
+{
+    switch ( c )
+    {
+        case 0x21:      // column start and end
+        case 0x22:      // page start and end
+            return 2;
+        case 0x20:
+        case 0x81:
+        case 0x8d:
+        case 0xa8:
+        case 0xad:
+        case 0xd3:
+        case 0xd5:
+        case 0xd9:
+        case 0xda:
+        case 0xdb:
+            return 1;
+    }
+    return 0;
+}
+
+NO_INSTRUMENT static void oledCommand( BYTE b )
+{
+    oled.command[ oled.commandLength++ ] = b;
+    if ( oled.commandLength <= oledArguments( oled.command[0] ) )
+        return;
+    oled.commandLength = 0;
+    if ( oled.command[0] == 0x21 )
+    {
+        oled.x0 = oled.x = oled.command[1] & 127;
+        oled.x1 = oled.command[2] & 127;
+    }
+    else if ( oled.command[0] == 0x22 )
+    {
+        oled.p0 = oled.p = oled.command[1] & 3;
+        oled.p1 = oled.command[2] & 3;
+    }
+}
+
+NO_INSTRUMENT static void oledData( BYTE b )
+{
+    oled.ram[ oled.x ][ oled.p ] = b;
+    if ( ++oled.p > oled.p1 )
+    {
+        oled.p = oled.p0;
+        if ( ++oled.x > oled.x1 )
+            oled.x = oled.x0;
+    }
+}
+
+NO_INSTRUMENT static void spiWrite( _spi* s, BYTE b )
+{
+    uint64_t start = s->busyUntil > cycles ? s->busyUntil : cycles;
+    s->busyUntil = start + kCyclesPerSPIByte;
+    s->bytes += 1;
+    // with the display selected
+    if ( s == &spi5 && !( hostSFR_PORTA.reg & BIT_0 ) )
+    {
+        if ( hostSFR_PORTJ.reg & BIT_9 )
+        {
+            s->dataBytes += 1;
+            displayFrameBytes += 1;
+            oledData( b );
+        }
+        else
+            oledCommand( b );
+    }
+}
+
+NO_INSTRUMENT static void startDisplayDMA( _displayDMA* d, _hostSFR* ssa, _hostSFR* ssiz )
+{
+    // physical addresses are truncated host addresses
+    const BYTE* regions[] = { (const BYTE*)screenBuffers[0], (const BYTE*)screenBuffers[1] };
+    int i;
+    d->src = NULL;
+    for ( i=0; i<ARRAY_SIZE(regions); ++i )
+    {
+        unsigned int base = (uintptr_t)regions[i] & 0x1FFFFFFF;
+        if ( ssa->reg - base < 512 )
+            d->src = regions[i] + ( ssa->reg - base );
+    }
+    d->remaining = ssiz->reg;
+}
+
+NO_INSTRUMENT static void serviceDisplayDMAs(void)
+// the SPI transmit interrupt triggers a byte whenever the FIFO isn't full
+{
+    int i;
+    for ( i=0; i<ARRAY_SIZE(displayDMAs); ++i )
+    {
+        _displayDMA* d = &displayDMAs[i];
+        if ( d->remaining <= 0 )
+            continue;
+        while ( d->remaining > 0 && spiQueued( d->spi ) <= kSPIFIFOSize )
+        {
+            spiWrite( d->spi, d->src ? *d->src++ : 0 );
+            d->remaining -= 1;
+        }
+        if ( !d->remaining )
+        {
+            // CHEN off, CHBCIF
+            d->con->reg &= ~BIT_7;
+            d->intr->reg |= BIT_3;
+        }
+    }
+}
+
+NO_INSTRUMENT static void nvmComplete(void)
+{
+    // physical addresses are truncated host addresses
+    static const struct { void* ptr; size_t size; } regions[] = {
+        { hostPeaksNVM, sizeof hostPeaksNVM },
+        { hostSettingsNVM, sizeof hostSettingsNVM },
+        { pageBuffer, sizeof pageBuffer },
+    };
+    BYTE* dst = NULL;
+    const BYTE* src = NULL;
+    int i;
+    for ( i=0; i<ARRAY_SIZE(regions); ++i )
+    {
+        unsigned int base = (uintptr_t)regions[i].ptr & 0x1FFFFFFF;
+        if ( hostSFR_NVMADDR.reg - base < regions[i].size )
+            dst = (BYTE*)regions[i].ptr + ( hostSFR_NVMADDR.reg - base );
+        if ( hostSFR_NVMSRCADDR.reg - base < regions[i].size )
+            src = (const BYTE*)regions[i].ptr + ( hostSFR_NVMSRCADDR.reg - base );
+    }
+    if ( !dst )
+        return;
+    switch ( nvmOp )
+    {
+        case 0x1:
+            memcpy( dst, (const void*)&hostSFR_NVMDATA0.reg, 4 );
+            break;
+        case 0x3:
+            if ( src )
+                memcpy( dst, src, 0x800 );
+            break;
+        case 0x4:
+            memset( dst, 0xff, 0x4000 );
+            break;
+    }
+}
+
+NO_INSTRUMENT static int isWriteOnly( _hostSFR* sfr )
+{
+    return sfr == &hostSFR_SPI1BUF || sfr == &hostSFR_SPI5BUF
+        || sfr == &hostSFR_U2TXREG || sfr == &hostSFR_U4TXREG
+        || sfr == &hostSFR_I2C4TRN || sfr == &hostSFR_NVMKEY;
+}
+
+NO_INSTRUMENT static void written( _hostSFR* sfr, unsigned int value )
+{
+    if ( sfr == &hostSFR_SPI5BUF )
+        spiWrite( &spi5, value );
+    else if ( sfr == &hostSFR_SPI1BUF )
+        spiWrite( &spi1, value );
+    else if ( sfr == &hostSFR_U4TXREG )
+        uartWrite( &uart4, value );
+    else if ( sfr == &hostSFR_U2TXREG )
+        uartWrite( &uart2, value );
+    else if ( sfr == &hostSFR_I2C4TRN )
+    {
+        i2c4.bytesOut += 1;
+        if ( config.verbose )
+            printf( "%10.3f ms  I2C out %02x\n", cycles / (double)kCyclesPerMs, value & 0xff );
+    }
+    else if ( sfr == &hostSFR_NVMKEY )
+    {
+        if ( value == 0 )
+            nvmKeyState = 1;
+        else if ( value == NVM_UNLOCK_KEY1 && nvmKeyState == 1 )
+            nvmKeyState = 2;
+        else if ( value == NVM_UNLOCK_KEY2 && nvmKeyState == 2 )
+            nvmKeyState = 3;
+        else
+            nvmKeyState = 0;
+    }
+}
+
+NO_INSTRUMENT static void changed( _hostSFR* sfr, unsigned int before, unsigned int after )
+{
+    unsigned int rose = after & ~before;
+    unsigned int fell = before & ~after;
+
+    if ( sfr == &hostSFR_SPI6CON )
+    {
+        // the audio SPIs are clocked by the codec, and trigger the DMAs
+        if ( rose & BIT_15 )
+            startAudio();
+        if ( fell & BIT_15 )
+            audioRunning = 0;
+    }
+    else if ( sfr == &hostSFR_DCH1CON )
+    {
+        if ( rose & BIT_7 )
+            startDisplayDMA( &displayDMAs[0], &hostSFR_DCH1SSA, &hostSFR_DCH1SSIZ );
+    }
+    else if ( sfr == &hostSFR_DCH2CON )
+    {
+        if ( rose & BIT_7 )
+            startDisplayDMA( &displayDMAs[1], &hostSFR_DCH2SSA, &hostSFR_DCH2SSIZ );
+    }
+    else if ( sfr == &hostSFR_PORTA )
+    {
+        // the end of a frame, when CS goes high after at least a column
+        // (rather than the single bytes of the startup sequence)
+        if ( ( rose & BIT_0 ) && displayFrameBytes >= 4 )
+            displayFrames += 1;
+        if ( rose & BIT_0 )
+            displayFrameBytes = 0;
+    }
+    else if ( sfr == &hostSFR_T3CON )
+    {
+        if ( rose & TxCON_ON_MASK )
+        {
+            timer3Running = 1;
+            timer3Start = cycles;
+        }
+        if ( fell & TxCON_ON_MASK )
+            timer3Running = 0;
+    }
+    else if ( sfr == &hostSFR_ADCCON3 )
+    {
+        if ( rose & BIT_6 )
+        {
+            // GSWTRG - self-clearing
+            sfr->reg &= ~BIT_6;
+            adcPending = 1;
+            adcReadyAt = cycles + kCyclesPerADC;
+        }
+    }
+    else if ( sfr == &hostSFR_NVMCON )
+    {
+        if ( rose & BIT_15 )
+        {
+            if ( nvmKeyState == 3 )
+            {
+                nvmOp = after & 0xf;
+                nvmDoneAt = cycles + ( nvmOp == 0x4 ? kCyclesNVMErase : nvmOp == 0x3 ? kCyclesNVMRow : kCyclesNVMWord );
+            }
+            else
+            {
+                // not unlocked - WRERR
+                sfr->reg = ( after & ~BIT_15 ) | BIT_13;
+            }
+            nvmKeyState = 0;
+        }
+    }
+}
+
+NO_INSTRUMENT static void commit(void)
+{
+    // apply whatever the firmware did through the last register it accessed
+    _hostSFR* sfr = lastSFR;
+    if ( !sfr )
+        return;
+    lastSFR = NULL;
+
+    unsigned int value = sfr->reg;
+    if ( sfr->clr )
+    {
+        value &= ~sfr->clr;
+        sfr->clr = 0;
+    }
+    if ( sfr->set )
+    {
+        value |= sfr->set;
+        sfr->set = 0;
+    }
+    if ( sfr->inv )
+    {
+        value ^= sfr->inv;
+        sfr->inv = 0;
+    }
+
+    if ( isWriteOnly( sfr ) )
+    {
+        sfr->reg = 0;
+        if ( value != kHostSentinel )
+            written( sfr, value );
+        return;
+    }
+
+    sfr->reg = value;
+    if ( value != lastValue )
+        changed( sfr, lastValue, value );
+}
+
+NO_INSTRUMENT static void present( _hostSFR* sfr )
+{
+    // update the register to show the state of its peripheral
+    if ( isWriteOnly( sfr ) )
+        sfr->reg = kHostSentinel;
+    else if ( sfr == &hostSFR_SPI5STAT )
+        sfr->reg = spiStatus( &spi5, sfr->reg );
+    else if ( sfr == &hostSFR_SPI1STAT )
+        sfr->reg = spiStatus( &spi1, sfr->reg );
+    else if ( sfr == &hostSFR_U4STA )
+        sfr->reg = uartStatus( &uart4, sfr->reg );
+    else if ( sfr == &hostSFR_U2STA )
+        sfr->reg = uartStatus( &uart2, sfr->reg );
+    else if ( sfr == &hostSFR_U4RXREG )
+        sfr->reg = uartRead( &uart4 );
+    else if ( sfr == &hostSFR_U2RXREG )
+        sfr->reg = uartRead( &uart2 );
+    else if ( sfr == &hostSFR_I2C4RCV )
+    {
+        sfr->reg = i2c4.data;
+        hostSFR_I2C4STAT.reg &= ~BIT_1;
+    }
+    else if ( sfr == &hostSFR_ADCDSTAT2 )
+    {
+        if ( adcPending && cycles >= adcReadyAt )
+            sfr->reg |= BIT_7;
+        else
+            sfr->reg &= ~BIT_7;
+    }
+    else if ( sfr == &hostSFR_ADCDATA38 )
+        sfr->reg = potValue[0];
+    else if ( sfr == &hostSFR_ADCDATA39 )
+    {
+        sfr->reg = potValue[1];
+        adcPending = 0;
+    }
+    else if ( sfr == &hostSFR_ADCCON2 )
+        sfr->reg = ( sfr->reg | BIT_31 ) & ~BIT_30;
+    else if ( sfr == &hostSFR_ADCANCON )
+        sfr->reg = ( sfr->reg & ~BIT_15 ) | ( ( sfr->reg & BIT_7 ) << 8 );
+    else if ( sfr == &hostSFR_IFS0 )
+    {
+        if ( timer3Running && cycles - timer3Start >= kCyclesPerMs )
+        {
+            sfr->reg |= _IFS0_T3IF_MASK;
+            timer3Start += kCyclesPerMs;
+        }
+    }
+    else if ( sfr == &hostSFR_NVMCON )
+    {
+        if ( nvmOp && cycles >= nvmDoneAt )
+        {
+            nvmComplete();
+            nvmOp = 0;
+            sfr->reg &= ~BIT_15;
+        }
+    }
+    else if ( sfr == &hostSFR_PORTH )
+    {
+        static const unsigned int inputs = BIT_4 | BIT_5 | BIT_6 | BIT_12 | BIT_13 | BIT_14 | BIT_15;
+        sfr->reg = ( sfr->reg & ~inputs ) | ( portHInputs & inputs );
+    }
+    else if ( sfr == &hostSFR_PORTB )
+        sfr->reg = ( sfr->reg & ~BIT_12 ) | ( portBInputs & BIT_12 );
+}
+
+NO_INSTRUMENT static void applyEvent( const _event* e )
+{
+    switch ( e->type )
+    {
+        case kEventUART2:
+            uartReceive( &uart2, e->a );
+            break;
+        case kEventUART4:
+            uartReceive( &uart4, e->a );
+            break;
+        case kEventI2C:
+            if ( i2c4.pending )
+            {
+                i2c4.overflows += 1;
+                hostSFR_I2C4STAT.reg |= BIT_6;          // I2COV
+            }
+            i2c4.pending = 1;
+            i2c4.data = e->a;
+            i2c4.bytesIn += 1;
+            // RBF, D_A, R_W
+            hostSFR_I2C4STAT.reg &= ~( BIT_1 | BIT_2 | BIT_5 );
+            hostSFR_I2C4STAT.reg |= BIT_1 | ( ( e->b & 1 ) ? BIT_5 : 0 ) | ( ( e->b & 2 ) ? BIT_2 : 0 );
+            break;
+        case kEventPortH:
+            portHInputs = ( portHInputs & ~e->a ) | ( e->b ? e->a : 0 );
+            break;
+        case kEventPortB:
+            portBInputs = ( portBInputs & ~e->a ) | ( e->b ? e->a : 0 );
+            break;
+        case kEventPot:
+            potValue[ e->a ] = e->b;
+            break;
+    }
+}
+
+NO_INSTRUMENT static void advance( int cost )
+{
+    cycles += cost;
+
+    while ( audioRunning && cycles >= audioNextBlock )
+    {
+        audioBlockReady();
+        audioNextBlock += blockCycles;
+    }
+
+    while ( nextEvent < numEvents && events[ nextEvent ].when <= cycles )
+        applyEvent( &events[ nextEvent++ ] );
+
+    serviceDisplayDMAs();
+
+    takeInterrupts();
+
+    if ( cycles >= endCycles && !currentIPL )
+        longjmp( endJump, 1 );
+}
+
+void hostTick( _hostSFR* sfr )
+{
+    commit();
+    advance( config.cyclesPerAccess );
+    present( sfr );
+    lastSFR = sfr;
+    lastValue = sfr->reg;
+}
+
+unsigned int hostCoreTimer(void)
+{
+    advance( config.cyclesPerAccess );
+    // the core timer ticks at half the system clock
+    return (unsigned int)( cycles / 2 );
+}
+
+void _pic32_flush_dcache(void)
+{
+}
+
+void _pic32_clean_dcache( uint32_t addr, size_t len )
+{
+}
+
+void _pic32_clean_dcache_nowrite( uint32_t addr, size_t len )
+{
+}
+
+//
+// script
+//
+
+static int eventCapacity = 0;
+
+static void addEvent( uint64_t when, int type, int a, int b )
+{
+    if ( numEvents == eventCapacity )
+    {
+        eventCapacity = eventCapacity ? 2 * eventCapacity : 1024;
+        events = realloc( events, eventCapacity * sizeof *events );
+    }
+    _event* e = &events[ numEvents++ ];
+    e->when = when;
+    e->type = type;
+    e->a = a;
+    e->b = b;
+}
+
+static int compareEvents( const void* a, const void* b )
+{
+    const _event* ea = a;
+    const _event* eb = b;
+    if ( ea->when != eb->when )
+        return ea->when < eb->when ? -1 : 1;
+    // keep script order
+    return ea < eb ? -1 : 1;
+}
+
+typedef struct {
+    uint64_t    when;
+    int         line;
+    char        text[256];
+} _command;
+
+static int compareCommands( const void* a, const void* b )
+{
+    const _command* ca = a;
+    const _command* cb = b;
+    if ( ca->when != cb->when )
+        return ca->when < cb->when ? -1 : 1;
+    return ca->line - cb->line;
+}
+
+static int parseBytes( char* args, BYTE* bytes, int max )
+{
+    int n = 0;
+    char* tok;
+    for ( tok = strtok( args, " \t" ); tok && n < max; tok = strtok( NULL, " \t" ) )
+        bytes[ n++ ] = strtol( tok, NULL, 16 );
+    return n;
+}
+
+static int scheduleCommand( uint64_t when, char* text )
+{
+    char cmd[32];
+    int used = 0;
+    if ( sscanf( text, "%31s%n", cmd, &used ) != 1 )
+        return 1;
+    char* args = text + used;
+    BYTE bytes[256];
+    int a = 0, b = 0;
+
+    if ( !strcmp( cmd, "midi" ) || !strcmp( cmd, "select" ) )
+    {
+        _uart* u = cmd[0] == 'm' ? &uart4 : &uart2;
+        int n = parseBytes( args, bytes, sizeof bytes ), i;
+        for ( i=0; i<n; ++i )
+        {
+            uint64_t t = u->rxLineFree > when ? u->rxLineFree : when;
+            u->rxLineFree = t + kCyclesPerUARTByte;
+            addEvent( u->rxLineFree, u == &uart4 ? kEventUART4 : kEventUART2, bytes[i], 0 );
+        }
+    }
+    else if ( !strcmp( cmd, "i2c" ) || !strcmp( cmd, "i2cread" ) )
+    {
+        int read = cmd[3] == 'r';
+        int n, i;
+        if ( read )
+            n = sscanf( args, "%d", &n ) == 1 ? n : 1;
+        else
+            n = parseBytes( args, bytes, sizeof bytes );
+        // address byte, then the data
+        for ( i=-1; i<n; ++i )
+        {
+            uint64_t t = i2c4.lineFree > when ? i2c4.lineFree : when;
+            i2c4.lineFree = t + kCyclesPerI2CByte;
+            int value = i < 0 ? ( ( 0x31 << 1 ) | read ) : read ? 0 : bytes[i];
+            addEvent( i2c4.lineFree, kEventI2C, value, ( i >= 0 ? 1 : 0 ) | ( read ? 2 : 0 ) );
+        }
+    }
+    else if ( !strcmp( cmd, "enc" ) && sscanf( args, "%d %d", &a, &b ) == 2 && ( a & ~1 ) == 0 )
+    {
+        // quadrature phases (A,B), clockwise: 11 -> 10 -> 00 -> 01 -> 11
+        static const BYTE phases[4] = { 3, 1, 0, 2 };
+        unsigned int bitA = a ? BIT_12 : BIT_4;
+        unsigned int bitB = a ? BIT_13 : BIT_5;
+        int steps = abs( b ) * 4, i;
+        for ( i=0; i<steps; ++i )
+        {
+            uint64_t t = encLineFree[a] > when ? encLineFree[a] : when;
+            encLineFree[a] = t + kCyclesPerEncPhase;
+            encPhase[a] = ( encPhase[a] + ( b > 0 ? 1 : 3 ) ) & 3;
+            int p = phases[ encPhase[a] ];
+            addEvent( encLineFree[a], kEventPortH, bitA, p & 1 );
+            addEvent( encLineFree[a], kEventPortH, bitB, p >> 1 );
+        }
+    }
+    else if ( !strcmp( cmd, "encsw" ) && sscanf( args, "%d %d", &a, &b ) == 2 && ( a & ~1 ) == 0 )
+    {
+        // pressed is low
+        addEvent( when, kEventPortH, a ? BIT_14 : BIT_6, !b );
+    }
+    else if ( !strcmp( cmd, "potsw" ) && sscanf( args, "%d %d", &a, &b ) == 2 && ( a & ~1 ) == 0 )
+    {
+        if ( a )
+            addEvent( when, kEventPortH, BIT_15, !b );
+        else
+            addEvent( when, kEventPortB, BIT_12, !b );
+    }
+    else if ( !strcmp( cmd, "pot" ) && sscanf( args, "%d %d", &a, &b ) == 2 && ( a & ~1 ) == 0 )
+    {
+        addEvent( when, kEventPot, a, b & 0xfff );
+    }
+    else
+    {
+        return 1;
+    }
+    return 0;
+}
+
+static int readScript( const char* path )
+{
+    FILE* f = fopen( path, "r" );
+    if ( !f )
+    {
+        fprintf( stderr, "could not open %s\n", path );
+        return 1;
+    }
+
+    _command* commands = NULL;
+    int numCommands = 0, capacity = 0;
+    char line[256];
+    int lineNumber = 0;
+    while ( fgets( line, sizeof line, f ) )
+    {
+        lineNumber += 1;
+        char* hash = strchr( line, '#' );
+        if ( hash )
+            *hash = 0;
+        double ms;
+        int used = 0;
+        if ( sscanf( line, "%lf%n", &ms, &used ) != 1 )
+            continue;
+        char* rest = line + used;
+        rest[ strcspn( rest, "\r\n" ) ] = 0;
+
+        // repeat <count> <interval ms> <command>
+        int count = 1;
+        double interval = 0;
+        char word[16];
+        int used2 = 0;
+        if ( sscanf( rest, "%15s%n", word, &used2 ) == 1 && !strcmp( word, "repeat" ) )
+        {
+            int used3 = 0;
+            if ( sscanf( rest + used2, "%d %lf%n", &count, &interval, &used3 ) != 2 )
+            {
+                fprintf( stderr, "%s:%d: bad repeat\n", path, lineNumber );
+                fclose( f );
+                return 1;
+            }
+            rest += used2 + used3;
+        }
+
+        int i;
+        for ( i=0; i<count; ++i )
+        {
+            if ( numCommands == capacity )
+            {
+                capacity = capacity ? 2 * capacity : 256;
+                commands = realloc( commands, capacity * sizeof *commands );
+            }
+            _command* c = &commands[ numCommands++ ];
+            c->when = ( ms + i * interval ) * kCyclesPerMs;
+            c->line = lineNumber;
+            strncpy( c->text, rest, sizeof c->text - 1 );
+            c->text[ sizeof c->text - 1 ] = 0;
+        }
+    }
+    fclose( f );
+
+    // bytes on the same line queue up behind each other, so go in time order
+    qsort( commands, numCommands, sizeof *commands, compareCommands );
+    int i;
+    for ( i=0; i<numCommands; ++i )
+    {
+        if ( scheduleCommand( commands[i].when, commands[i].text ) )
+        {
+            fprintf( stderr, "%s:%d: bad command '%s'\n", path, commands[i].line, commands[i].text );
+            free( commands );
+            return 1;
+        }
+    }
+    free( commands );
+
+    qsort( events, numEvents, sizeof *events, compareEvents );
+    return 0;
+}
+
+//
+// report
+//
+
+static double toMicroseconds( uint64_t c )
+{
+    return c * 1e6 / SYS_CLK_FREQ;
+}
+
+static void report(void)
+{
+    printf( "virtual time           %.3f s\n", cycles / (double)SYS_CLK_FREQ );
+    printf( "block period           %.2f us\n", toMicroseconds( blockCycles ) );
+    printf( "blocks processed       %llu\n", (unsigned long long)audio.blocks );
+    if ( audio.blocks )
+    {
+        printf( "service latency mean   %.2f us\n", toMicroseconds( audio.latencyTotal / audio.blocks ) );
+        printf( "service latency max    %.2f us (%.0f%% of a block) for the block ready at %.3f ms\n",
+                toMicroseconds( audio.latencyMax ), ( 100.0 * audio.latencyMax ) / blockCycles,
+                audio.latencyMaxAt / (double)kCyclesPerMs );
+        printf( "  when the block became ready, the firmware was in\n" );
+        int i;
+        for ( i=0; i<kStackSnapshot && audio.latencyMaxStack[i]; ++i )
+            printf( "    %s\n", symbolName( audio.latencyMaxStack[i] ) );
+        printf( "longest gap            %.2f us between blocks, at %.3f ms\n",
+                toMicroseconds( audio.intervalMax ), audio.intervalMaxAt / (double)kCyclesPerMs );
+        printf( "missed deadlines       %llu\n", (unsigned long long)audio.missedDeadlines );
+        printf( "dropped blocks         %llu\n", (unsigned long long)audio.dropped );
+        printf( "repeated blocks        %llu\n", (unsigned long long)audio.repeated );
+        printf( "latency histogram (%% of a block)\n" );
+        for ( i=0; i<kHistogramSize; ++i )
+        {
+            if ( !audio.histogram[i] )
+                continue;
+            if ( i == kHistogramSize-1 )
+                printf( "  >=%3d%%  %llu\n", i * 10, (unsigned long long)audio.histogram[i] );
+            else
+                printf( "  %3d%%    %llu\n", i * 10, (unsigned long long)audio.histogram[i] );
+        }
+    }
+    printf( "firmware's deadlines   %u late, %u missed, %u overruns\n",
+            audioDeadlines.late, audioDeadlines.missed, audioDeadlines.overruns );
+    if ( audioDeadlines.numEvents )
+    {
+        const _deadlineEvent* e = &audioDeadlines.events[ ( audioDeadlines.numEvents - 1 ) % kDeadlineEvents ];
+        printf( "  the latest %.2f us late, in %s, task %s\n", toMicroseconds( 2 * e->lateness ),
+                e->address ? symbolName( exceptionAddress( e->address ) ) : "-",
+                ( e->task < numTasks ) ? tasks[ e->task ].name : "-" );
+    }
+    printf( "MIDI in/out            %d/%d bytes, %d overruns\n", uart4.bytesIn, uart4.bytesOut, uart4.overruns );
+    printf( "select bus in/out      %d/%d bytes, %d overruns\n", uart2.bytesIn, uart2.bytesOut, uart2.overruns );
+    printf( "I2C in/out             %d/%d bytes, %d overflows\n", i2c4.bytesIn, i2c4.bytesOut, i2c4.overflows );
+    printf( "display frames         %d, %d data bytes\n", displayFrames, spi5.dataBytes );
+    if ( displayBytesToSend >= 0 )
+        printf( "display RAM            (a frame is being sent)\n" );
+    else
+    {
+        int x, p, wrong = 0;
+        for ( x=0; x<128; ++x )
+            for ( p=0; p<4; ++p )
+                wrong += oled.ram[x][p] != (BYTE)( displayFront[x] >> ( 8*p ) );
+        if ( wrong )
+            printf( "display RAM            %d bytes differ from the screen\n", wrong );
+        else
+            printf( "display RAM            matches the screen\n" );
+    }
+}
+
+static void usage( const char* name )
+{
+    fprintf( stderr,
+            "usage: %s [options]\n"
+            "  -s file      event script\n"
+            "  -t seconds   virtual time to run for (default %.1f)\n"
+            "  -a percent   cost of algorithm_step(), as a percentage of a block (default %d)\n"
+            "  -x cycles    cost of a register access (default %d)\n"
+            "  -c cycles    cost of a function call (default %d)\n"
+            "  -v           log MIDI, select bus and I2C output\n"
+            "  -m file      save the MIDI output (for SysEx replies, such as a trace dump)\n"
+            "\n"
+            "Script lines are '<ms> <command>', or '<ms> repeat <count> <interval ms> <command>':\n"
+            "  midi <hex bytes>         MIDI in\n"
+            "  select <hex bytes>       select bus in\n"
+            "  i2c <hex bytes>          I2C write to the disting\n"
+            "  i2cread <count>          I2C read from the disting\n"
+            "  enc <0|1> <steps>        turn an encoder (negative for anticlockwise)\n"
+            "  encsw <0|1> <0|1>        press (1) or release (0) an encoder\n"
+            "  potsw <0|1> <0|1>        press or release a pot\n"
+            "  pot <0|1> <0-4095>       set a pot\n",
+            name, config.seconds, config.stepPercent, config.cyclesPerAccess, config.cyclesPerCall );
+}
+
+int main( int argc, char* argv[] )
+{
+    const char* scriptPath = NULL;
+    int c;
+    while ( ( c = getopt( argc, argv, "s:t:a:x:c:m:vh" ) ) != -1 )
+    {
+        switch ( c )
+        {
+            case 's':
+                scriptPath = optarg;
+                break;
+            case 't':
+                config.seconds = atof( optarg );
+                break;
+            case 'a':
+                config.stepPercent = atoi( optarg );
+                break;
+            case 'x':
+                config.cyclesPerAccess = atoi( optarg );
+                break;
+            case 'c':
+                config.cyclesPerCall = atoi( optarg );
+                break;
+            case 'v':
+                config.verbose = 1;
+                break;
+            case 'm':
+                config.midiOut = fopen( optarg, "wb" );
+                if ( !config.midiOut )
+                {
+                    fprintf( stderr, "could not write %s\n", optarg );
+                    return 1;
+                }
+                break;
+            default:
+                usage( argv[0] );
+                return 1;
+        }
+    }
+
+    // the flash starts out erased
+    memset( hostPeaksNVM, 0xff, sizeof hostPeaksNVM );
+    memset( hostSettingsNVM, 0xff, sizeof hostSettingsNVM );
+
+    if ( scriptPath && readScript( scriptPath ) )
+        return 1;
+
+    endCycles = config.seconds * SYS_CLK_FREQ;
+    if ( !setjmp( endJump ) )
+    {
+        running = 1;
+        APP_Initialize();
+        for ( ;; )
+            APP_Tasks();
+    }
+
+    running = 0;
+    if ( config.midiOut )
+        fclose( config.midiOut );
+    report();
+    return audio.missedDeadlines ? 2 : 0;
+}
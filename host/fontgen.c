@@ -0,0 +1,161 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Rasterises the fonts for text.c, writing src/fonts/fonts.h (see
+ * 'make fonts'). Each glyph becomes a word per column, with its top row in
+ * bit 0, so it can be shifted to any row and ORed straight into a screen
+ * column. The proportional fonts are the 8x8 font with its blank columns
+ * trimmed, and the large font is that again, at twice the size.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+typedef unsigned char BYTE;
+
+static const BYTE font_8x8[96][8] = {
+#include "../src/fonts/codeman38_deluxefont/dlxfont.ttf.h"
+};
+
+enum { kGlyphs = 96 };
+
+// the width of a space, which has no columns to measure
+enum { kSpaceWidth = 3 };
+
+typedef struct {
+    const char* name;
+    int         numColumns;
+    unsigned int columns[ kGlyphs * 16 ];
+    int         offsets[ kGlyphs ];
+    int         widths[ kGlyphs ];
+} _rasterFont;
+
+static _rasterFont fonts[3];
+
+static void addColumn( _rasterFont* f, unsigned int c )
+{
+    f->columns[ f->numColumns++ ] = c;
+}
+
+static unsigned int doubled( BYTE b )
+// each row twice
+{
+    unsigned int c = 0;
+    int i;
+    for ( i=0; i<8; ++i )
+        if ( b & ( 1 << i ) )
+            c |= 3 << ( 2*i );
+    return c;
+}
+
+static void rasterise(void)
+{
+    _rasterFont* fixed = &fonts[0];
+    _rasterFont* proportional = &fonts[1];
+    _rasterFont* large = &fonts[2];
+    fixed->name = "font8x8";
+    proportional->name = "fontProportional";
+    large->name = "fontLarge";
+
+    int g, i;
+    for ( g=0; g<kGlyphs; ++g )
+    {
+        const BYTE* glyph = font_8x8[g];
+
+        fixed->offsets[g] = fixed->numColumns;
+        fixed->widths[g] = 8;
+        for ( i=0; i<8; ++i )
+            addColumn( fixed, glyph[i] );
+
+        int first = 0, last = 7;
+        while ( first < 8 && !glyph[first] )
+            first += 1;
+        while ( last >= first && !glyph[last] )
+            last -= 1;
+
+        proportional->offsets[g] = proportional->numColumns;
+        large->offsets[g] = large->numColumns;
+        if ( first > last )
+        {
+            proportional->widths[g] = kSpaceWidth;
+            large->widths[g] = 2 * kSpaceWidth;
+            for ( i=0; i<kSpaceWidth; ++i )
+            {
+                addColumn( proportional, 0 );
+                addColumn( large, 0 );
+                addColumn( large, 0 );
+            }
+            continue;
+        }
+        proportional->widths[g] = last - first + 1;
+        large->widths[g] = 2 * ( last - first + 1 );
+        for ( i=first; i<=last; ++i )
+        {
+            addColumn( proportional, glyph[i] );
+            addColumn( large, doubled( glyph[i] ) );
+            addColumn( large, doubled( glyph[i] ) );
+        }
+    }
+}
+
+static void writeFont( FILE* out, const _rasterFont* f )
+{
+    int i;
+    fprintf( out, "\nstatic const unsigned int %sColumns[%d] = {", f->name, f->numColumns );
+    for ( i=0; i<f->numColumns; ++i )
+        fprintf( out, "%s0x%x,", ( i % 8 ) ? " " : "\n    ", f->columns[i] );
+    fprintf( out, "\n};\n" );
+    fprintf( out, "\nstatic const WORD %sOffsets[%d] = {", f->name, kGlyphs );
+    for ( i=0; i<kGlyphs; ++i )
+        fprintf( out, "%s%d,", ( i % 12 ) ? " " : "\n    ", f->offsets[i] );
+    fprintf( out, "\n};\n" );
+    fprintf( out, "\nstatic const BYTE %sWidths[%d] = {", f->name, kGlyphs );
+    for ( i=0; i<kGlyphs; ++i )
+        fprintf( out, "%s%d,", ( i % 16 ) ? " " : "\n    ", f->widths[i] );
+    fprintf( out, "\n};\n" );
+}
+
+int main( int argc, char** argv )
+{
+    if ( argc != 2 )
+    {
+        fprintf( stderr, "usage: %s <fonts.h>\n", argv[0] );
+        return 1;
+    }
+    FILE* out = fopen( argv[1], "w" );
+    if ( !out )
+    {
+        perror( argv[1] );
+        return 1;
+    }
+    rasterise();
+    fprintf( out, "// Generated by host/fontgen.c from codeman38_deluxefont/dlxfont.ttf.h\n" );
+    fprintf( out, "// ('make fonts' in host/) - don't edit.\n" );
+    int i;
+    for ( i=0; i<3; ++i )
+        writeFont( out, &fonts[i] );
+    fclose( out );
+    return 0;
+}
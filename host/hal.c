@@ -0,0 +1,152 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Stub HAL for the host build.
+ * Provides the globals that the algorithm code expects from app.c,
+ * calibrate.c and friends, with the default (uncalibrated) values.
+ */
+
+#include "app.h"
+#include "algorithm.h"
+#include "display.h"
+#include "nvm.h"
+#include "convert.h"
+#include "host.h"
+#include "sramtest.h"
+
+unsigned int time = 0;
+int framesPerBlock = k_minFramesPerBlock;
+
+_adcs adcs = { 0 };
+_halfState halfState[2] = { 0 };
+_input_calibration inputCalibrations[6];
+BYTE pageBuffer[0x4000] __attribute__((aligned(16))) = { 0 };
+
+int hostPeaksNVM[0x4000/4] = { 0 };
+char hostSRAM[SRAM_SIZE] __attribute__((aligned(16)));
+
+void hostTick( _hostSFR* sfr )
+{
+    // the peripherals don't exist - registers are just memory
+}
+
+unsigned int hostCoreTimer(void)
+{
+    // the core timer ticks at half the system clock
+    return (unsigned int)( ( hostNanoseconds() * ( SYS_CLK_FREQ/2/1000 ) ) / 1000000 );
+}
+
+unsigned int hostExceptionPC(void)
+{
+    // nothing is interrupted
+    return 0;
+}
+
+// there are no interrupts either
+unsigned int hostDisableInterrupts(void)
+{
+    return 0;
+}
+
+unsigned int hostEnableInterrupts(void)
+{
+    return 0;
+}
+
+void sendBytes( int code, const BYTE* ptr, int count )
+{
+}
+
+void sramTestStop(void)
+{
+    // there's no SRAM test without midi.c to start it
+}
+
+unsigned int NVMOpWithAudioService( unsigned int nvmop )
+{
+    // only the settings page is backed, by hostPeaksNVM
+    if ( NVMADDR != ( (uintptr_t)hostPeaksNVM & 0x1FFFFFFF ) )
+        return 0;
+    switch ( nvmop )
+    {
+        case 0x4004:
+            // erase page
+            memset( hostPeaksNVM, 0xff, sizeof hostPeaksNVM );
+            break;
+        case 0x4003:
+            // write row
+            if ( NVMSRCADDR == ( (uintptr_t)pageBuffer & 0x1FFFFFFF ) )
+                memcpy( hostPeaksNVM, pageBuffer, 0x800 );
+            break;
+    }
+    return 0;
+}
+
+void hostInitialise(void)
+{
+    // as ReadCalibrationFromSettings() with wiped settings
+    static const BYTE half[6] = { 0, 0, 1, 1, 0, 1 };
+    static const BYTE in[6] = { 0, 1, 0, 1, 2, 2 };
+
+    double Bf = 0x266666 / 3.0;
+    int d, i;
+    for ( d=0; d<2; ++d )
+    {
+        memset( &halfState[d], 0, sizeof halfState[d] );
+        for ( i=0; i<3; ++i )
+            halfState[d].Brf[i] = 1.0 / Bf;
+        for ( i=0; i<2; ++i )
+        {
+            halfState[d].Erf[i] = Bf;
+            halfState[d].Dd[i] = 0;
+            halfState[d].Ddf[i] = 0;
+            convertSetOutputCalibration( 2*d+i, 0, Bf );
+        }
+        halfState[d].encA = 1;
+        halfState[d].encB = 1;
+        halfState[d].encSW = 1;
+        halfState[d].potSW = 1;
+        halfState[d].lastEncA = 1;
+    }
+    for ( i=0; i<6; ++i )
+    {
+        inputCalibrations[i].Brf = halfState[ half[i] ].Brf[ in[i] ];
+        inputCalibrations[i].mABrf = 0;
+        convertSetInputCalibration( i, 0, Bf );
+    }
+    memset( &adcs, 0, sizeof adcs );
+    time = 0;
+}
+
+float hostInputCode( int channel, float volts )
+{
+    return ( volts - inputCalibrations[channel].mABrf ) / inputCalibrations[channel].Brf;
+}
+
+float hostOutputVolts( int channel, int code )
+{
+    const _halfState* h = &halfState[ channel >> 1 ];
+    return ( code + h->Dd[ channel & 1 ] ) / h->Erf[ channel & 1 ];
+}
@@ -0,0 +1,172 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Benchmark and frequency response of the half-band filters (halfband.c),
+ * for every tap count.
+ *
+ * The responses are measured from the fixed point code itself, by feeding
+ * it impulses. The passband is 0-20kHz and the stopband 28-48kHz, at 96kHz.
+ * The multiply-accumulates per sample are the lower bound on PIC32MZ cycles,
+ * where each is a single madd.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "halfband.h"
+#include "host.h"
+
+enum { kResponseLength = 128 };
+enum { kBenchSamples = 1 << 16 };
+enum { kImpulse = 1 << 22 };
+
+static const double kHighRate = 96000.0;
+static const double kPassbandEdge = 20000.0;
+static const double kStopbandEdge = 28000.0;
+
+typedef struct {
+    double  ripple;         // dB, peak deviation from 0dB in the passband
+    double  stopband;       // dB, worst case in the stopband
+} _response;
+
+static double magnitude( const double* h, int n, double f )
+{
+    double re = 0.0, im = 0.0;
+    int i;
+    for ( i=0; i<n; ++i )
+    {
+        re += h[i] * cos( 2.0 * M_PI * f * i / kHighRate );
+        im -= h[i] * sin( 2.0 * M_PI * f * i / kHighRate );
+    }
+    return sqrt( re * re + im * im );
+}
+
+static _response measure( const double* h, int n )
+{
+    _response r = { 0.0, -1000.0 };
+    int i;
+    for ( i=0; i<=200; ++i )
+    {
+        double p = 20.0 * log10( magnitude( h, n, kPassbandEdge * i / 200 ) );
+        if ( fabs( p ) > r.ripple )
+            r.ripple = fabs( p );
+        double s = 20.0 * log10( magnitude( h, n, kStopbandEdge + ( kHighRate/2 - kStopbandEdge ) * i / 200 ) + 1e-12 );
+        if ( s > r.stopband )
+            r.stopband = s;
+    }
+    return r;
+}
+
+static _response interpolatorResponse( int taps )
+// the impulse response at 96kHz, normalised for the interpolator's gain of two
+{
+    _halfband h;
+    halfbandInit( &h, taps );
+    int in[ kResponseLength/2 ] = { kImpulse };
+    int out[ kResponseLength ];
+    halfbandInterpolate( &h, in, out, kResponseLength/2 );
+
+    double ir[ kResponseLength ];
+    int i;
+    for ( i=0; i<kResponseLength; ++i )
+        ir[i] = out[i] / ( 2.0 * kImpulse );
+    return measure( ir, kResponseLength );
+}
+
+static _response decimatorResponse( int taps )
+// the underlying filter's impulse response, from impulses at either phase
+{
+    double ir[ kResponseLength ];
+    int phase, i;
+    for ( phase=0; phase<2; ++phase )
+    {
+        _halfband h;
+        halfbandInit( &h, taps );
+        int in[ kResponseLength ] = { 0 };
+        int out[ kResponseLength/2 ];
+        in[ 1 - phase ] = kImpulse;
+        halfbandDecimate( &h, in, out, kResponseLength/2 );
+        for ( i=0; i<kResponseLength/2; ++i )
+            ir[ 2*i + phase ] = out[i] / (double)kImpulse;
+    }
+    return measure( ir, kResponseLength );
+}
+
+static double nsPerSample( int taps, int decimate, int repeats )
+// per sample at 96kHz, the fastest of the repeats
+{
+    static int in[ kBenchSamples ], out[ kBenchSamples ];
+    int i;
+    srand( 1 );
+    for ( i=0; i<kBenchSamples; ++i )
+        in[i] = ( rand() & 0xffffff ) - 0x800000;
+
+    double best = 0.0;
+    int r;
+    for ( r=0; r<repeats; ++r )
+    {
+        _halfband h;
+        halfbandInit( &h, taps );
+        uint64_t t0 = hostNanoseconds();
+        if ( decimate )
+            halfbandDecimate( &h, in, out, kBenchSamples/2 );
+        else
+            halfbandInterpolate( &h, in, out, kBenchSamples/2 );
+        double ns = (double)( hostNanoseconds() - t0 ) / kBenchSamples;
+        if ( r == 0 || ns < best )
+            best = ns;
+    }
+    return best;
+}
+
+int main( int argc, char** argv )
+{
+    int repeats = ( argc > 1 ) ? atoi( argv[1] ) : 10;
+    if ( repeats < 1 )
+    {
+        fprintf( stderr, "usage: halfband_bench [repeats]\n" );
+        return 2;
+    }
+
+    printf( "# passband 0-%.0fHz, stopband %.0f-%.0fHz, per sample at %.0fHz\n",
+            kPassbandEdge, kStopbandEdge, kHighRate/2, kHighRate );
+    printf( "# taps latency  ripple-dB  interp: stop-dB  MACs  ns    decim: stop-dB  MACs  ns\n" );
+    int pairs;
+    for ( pairs=kHalfbandMinPairs; pairs<=kHalfbandMaxPairs; ++pairs )
+    {
+        int taps = 4 * pairs - 1;
+        _halfband h;
+        halfbandInit( &h, taps );
+        _response ri = interpolatorResponse( taps );
+        _response rd = decimatorResponse( taps );
+        printf( "%6d %7d %10.4f %15.1f %5.1f %5.2f %14.1f %5.1f %5.2f\n",
+                taps, halfbandLatency( &h ), ri.ripple,
+                ri.stopband, pairs / 2.0, nsPerSample( taps, 0, repeats ),
+                rd.stopband, ( pairs + 1 ) / 2.0, nsPerSample( taps, 1, repeats ) );
+    }
+    return 0;
+}
@@ -0,0 +1,182 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * The special function registers that the host build knows about.
+ * Included with HOST_SFR defined to declare or define each one.
+ */
+
+HOST_SFR( ADC7CFG )
+HOST_SFR( ADCANCON )
+HOST_SFR( ADCCON1 )
+HOST_SFR( ADCCON2 )
+HOST_SFR( ADCCON3 )
+HOST_SFR( ADCCSS1 )
+HOST_SFR( ADCCSS2 )
+HOST_SFR( ADCDATA27 )
+HOST_SFR( ADCDATA28 )
+HOST_SFR( ADCDATA38 )
+HOST_SFR( ADCDATA39 )
+HOST_SFR( ADCDSTAT2 )
+HOST_SFR( ADCIMCON2 )
+HOST_SFR( ADCIMCON3 )
+HOST_SFR( ADCTRGSNS )
+HOST_SFR( CFGEBIA )
+HOST_SFR( CFGEBIC )
+HOST_SFR( DCH0CON )
+HOST_SFR( DCH0CSIZ )
+HOST_SFR( DCH0DSA )
+HOST_SFR( DCH0DSIZ )
+HOST_SFR( DCH0ECON )
+HOST_SFR( DCH0INT )
+HOST_SFR( DCH0SSA )
+HOST_SFR( DCH0SSIZ )
+HOST_SFR( DCH1CON )
+HOST_SFR( DCH1CSIZ )
+HOST_SFR( DCH1DSA )
+HOST_SFR( DCH1DSIZ )
+HOST_SFR( DCH1ECON )
+HOST_SFR( DCH1INT )
+HOST_SFR( DCH1SSA )
+HOST_SFR( DCH1SSIZ )
+HOST_SFR( DCH2CON )
+HOST_SFR( DCH2CSIZ )
+HOST_SFR( DCH2DSA )
+HOST_SFR( DCH2DSIZ )
+HOST_SFR( DCH2ECON )
+HOST_SFR( DCH2INT )
+HOST_SFR( DCH2SSA )
+HOST_SFR( DCH2SSIZ )
+HOST_SFR( DCH3CON )
+HOST_SFR( DCH3CSIZ )
+HOST_SFR( DCH3DSA )
+HOST_SFR( DCH3DSIZ )
+HOST_SFR( DCH3ECON )
+HOST_SFR( DCH3INT )
+HOST_SFR( DCH3SSA )
+HOST_SFR( DCH3SSIZ )
+HOST_SFR( DCH4CON )
+HOST_SFR( DCH4CSIZ )
+HOST_SFR( DCH4DSA )
+HOST_SFR( DCH4DSIZ )
+HOST_SFR( DCH4ECON )
+HOST_SFR( DCH4INT )
+HOST_SFR( DCH4SSA )
+HOST_SFR( DCH4SSIZ )
+HOST_SFR( DCH5CON )
+HOST_SFR( DCH5CSIZ )
+HOST_SFR( DCH5DSA )
+HOST_SFR( DCH5DSIZ )
+HOST_SFR( DCH5ECON )
+HOST_SFR( DCH5INT )
+HOST_SFR( DCH5SSA )
+HOST_SFR( DCH5SSIZ )
+HOST_SFR( DCH6CON )
+HOST_SFR( DCH6CSIZ )
+HOST_SFR( DCH6DSA )
+HOST_SFR( DCH6DSIZ )
+HOST_SFR( DCH6ECON )
+HOST_SFR( DCH6INT )
+HOST_SFR( DCH6SSA )
+HOST_SFR( DCH6SSIZ )
+HOST_SFR( DCH7CON )
+HOST_SFR( DCH7CSIZ )
+HOST_SFR( DCH7DSA )
+HOST_SFR( DCH7DSIZ )
+HOST_SFR( DCH7ECON )
+HOST_SFR( DCH7INT )
+HOST_SFR( DCH7SSA )
+HOST_SFR( DCH7SSIZ )
+HOST_SFR( DMACON )
+HOST_SFR( EBICS0 )
+HOST_SFR( EBIMSK0 )
+HOST_SFR( EBISMCON )
+HOST_SFR( EBISMT0 )
+HOST_SFR( I2C2BRG )
+HOST_SFR( I2C2CON )
+HOST_SFR( I2C2STAT )
+HOST_SFR( I2C4BRG )
+HOST_SFR( I2C4CON )
+HOST_SFR( I2C4RCV )
+HOST_SFR( I2C4STAT )
+HOST_SFR( I2C4TRN )
+HOST_SFR( IEC0 )
+HOST_SFR( IEC1 )
+HOST_SFR( IEC2 )
+HOST_SFR( IEC3 )
+HOST_SFR( IEC4 )
+HOST_SFR( IEC5 )
+HOST_SFR( IEC6 )
+HOST_SFR( IFS0 )
+HOST_SFR( IFS1 )
+HOST_SFR( IFS2 )
+HOST_SFR( IFS3 )
+HOST_SFR( IFS4 )
+HOST_SFR( IFS5 )
+HOST_SFR( IFS6 )
+HOST_SFR( LATB )
+HOST_SFR( NVMADDR )
+HOST_SFR( NVMCON )
+HOST_SFR( NVMDATA0 )
+HOST_SFR( NVMKEY )
+HOST_SFR( NVMSRCADDR )
+HOST_SFR( OC8CON )
+HOST_SFR( OC8R )
+HOST_SFR( OC8RS )
+HOST_SFR( OC9CON )
+HOST_SFR( OC9R )
+HOST_SFR( OC9RS )
+HOST_SFR( PORTA )
+HOST_SFR( PORTB )
+HOST_SFR( PORTC )
+HOST_SFR( PORTD )
+HOST_SFR( PORTE )
+HOST_SFR( PORTF )
+HOST_SFR( PORTG )
+HOST_SFR( PORTH )
+HOST_SFR( PORTJ )
+HOST_SFR( SPI1BUF )
+HOST_SFR( SPI1CON )
+HOST_SFR( SPI1STAT )
+HOST_SFR( SPI3BUF )
+HOST_SFR( SPI3CON )
+HOST_SFR( SPI3CON2 )
+HOST_SFR( SPI4BUF )
+HOST_SFR( SPI4CON )
+HOST_SFR( SPI4CON2 )
+HOST_SFR( SPI5BUF )
+HOST_SFR( SPI5CON )
+HOST_SFR( SPI5STAT )
+HOST_SFR( SPI6BUF )
+HOST_SFR( SPI6CON )
+HOST_SFR( SPI6CON2 )
+HOST_SFR( T3CON )
+HOST_SFR( TMR3 )
+HOST_SFR( TRISB )
+HOST_SFR( U2RXREG )
+HOST_SFR( U2STA )
+HOST_SFR( U2TXREG )
+HOST_SFR( U4RXREG )
+HOST_SFR( U4STA )
+HOST_SFR( U4TXREG )
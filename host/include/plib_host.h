@@ -0,0 +1,117 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Host stubs of the Harmony peripheral libraries.
+ * Calls that only configure hardware compile away; the interrupt flag
+ * calls are implemented by the host tool that needs them.
+ */
+
+#ifndef _HOST_PLIB_H
+#define _HOST_PLIB_H
+
+#include <stdbool.h>
+#include <xc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    INT_ID_0,
+} INT_MODULE_ID;
+
+typedef enum {
+    INT_SOURCE_DMA_0,
+    INT_SOURCE_DMA_5,
+    INT_SOURCE_USART_2_RECEIVE,
+    INT_SOURCE_USART_4_RECEIVE,
+    INT_SOURCE_I2C_4_SLAVE,
+    INT_SOURCE_NUMBER
+} INT_SOURCE;
+
+void PLIB_INT_SourceEnable( INT_MODULE_ID index, INT_SOURCE source );
+void PLIB_INT_SourceDisable( INT_MODULE_ID index, INT_SOURCE source );
+bool PLIB_INT_SourceFlagGet( INT_MODULE_ID index, INT_SOURCE source );
+void PLIB_INT_SourceFlagClear( INT_MODULE_ID index, INT_SOURCE source );
+
+#define PLIB_INT_VectorPrioritySet( index, vector, priority )           ((void)0)
+#define PLIB_INT_VectorSubPrioritySet( index, vector, subPriority )     ((void)0)
+
+typedef enum {
+    DMA_TRIGGER_SPI_1_TRANSMIT = 111,
+    DMA_TRIGGER_SPI_5_TRANSMIT = 182,
+    DMA_TRIGGER_SPI_6_RECEIVE = 190,
+} DMA_TRIGGER_SOURCE;
+
+#define PLIB_DMA_Enable( index )                                        ((void)0)
+#define PLIB_DMA_Disable( index )                                       ((void)0)
+
+#define PLIB_PORTS_RemapInput( index, function, pin )                   ((void)0)
+#define PLIB_PORTS_RemapOutput( index, function, pin )                  ((void)0)
+
+#define PLIB_OSC_ReferenceOscDisable( index, reference )                ((void)0)
+
+#define PLIB_SPI_Enable( index )                                        ((void)0)
+#define PLIB_SPI_Disable( index )                                       ((void)0)
+#define PLIB_SPI_MasterEnable( index )                                  ((void)0)
+#define PLIB_SPI_PinEnable( index, pin )                                ((void)0)
+#define PLIB_SPI_CommunicationWidthSelect( index, width )               ((void)0)
+#define PLIB_SPI_SlaveSelectEnable( index )                             ((void)0)
+#define PLIB_SPI_BaudRateSet( index, clockFrequency, baudRate )         ((void)0)
+
+#define PLIB_TMR_Mode16BitEnable( index )                               ((void)0)
+#define PLIB_TMR_PrescaleSelect( index, prescale )                      ((void)0)
+#define PLIB_TMR_Period16BitSet( index, period )                        ((void)0)
+#define PLIB_TMR_Start( index )                                         ((void)0)
+#define PLIB_TMR_Stop( index )                                          ((void)0)
+
+#define PLIB_USART_InitializeOperation( index, rx, tx, mode )           ((void)0)
+#define PLIB_USART_TransmitterEnable( index )                           ((void)0)
+#define PLIB_USART_ReceiverEnable( index )                              ((void)0)
+#define PLIB_USART_BaudSetAndEnable( index, clockFrequency, baud )      ((void)0)
+
+// the codec and expansion I2C masters always succeed at once
+enum { I2C_WRITE = 0, I2C_READ = 1 };
+
+#define PLIB_I2C_MasterStart( index )                                   ((void)0)
+#define PLIB_I2C_MasterStartRepeat( index )                             ((void)0)
+#define PLIB_I2C_MasterStop( index )                                    ((void)0)
+#define PLIB_I2C_BusIsIdle( index )                                     (true)
+#define PLIB_I2C_ArbitrationLossHasOccurred( index )                    (false)
+#define PLIB_I2C_TransmitterIsReady( index )                            (true)
+#define PLIB_I2C_TransmitterByteSend( index, data )                     ((void)0)
+#define PLIB_I2C_TransmitterOverflowHasOccurred( index )                (false)
+#define PLIB_I2C_TransmitterByteHasCompleted( index )                   (true)
+#define PLIB_I2C_TransmitterByteWasAcknowledged( index )                (true)
+#define PLIB_I2C_SlaveAddress7BitSet( index, address )                  ((void)0)
+
+#define NVM_UNLOCK_KEY1         0xAA996655
+#define NVM_UNLOCK_KEY2         0x556699AA
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_PLIB_H */
@@ -0,0 +1,921 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Host stub of the XC32 device header.
+ *
+ * Each special function register is a _hostSFR, laid out like the
+ * hardware's register/CLR/SET/INV quad. Every access goes through
+ * hostTick(), which the host tools implement: the renderer does nothing,
+ * the emulator advances its virtual clock and the peripherals behind
+ * the registers.
+ */
+
+#ifndef _HOST_XC_H
+#define _HOST_XC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    volatile unsigned int reg;
+    volatile unsigned int clr;
+    volatile unsigned int set;
+    volatile unsigned int inv;
+} _hostSFR;
+
+#define HOST_SFR( name )    extern _hostSFR hostSFR_##name;
+#include "host_sfr_list.h"
+#undef HOST_SFR
+
+void hostTick( _hostSFR* sfr );
+
+static inline __attribute__((always_inline, no_instrument_function)) _hostSFR* hostAccess( _hostSFR* sfr )
+{
+    hostTick( sfr );
+    return sfr;
+}
+
+#define HOST_REG( name )            ( hostAccess( &hostSFR_##name )->reg )
+#define HOST_CLR( name )            ( hostAccess( &hostSFR_##name )->clr )
+#define HOST_SET( name )            ( hostAccess( &hostSFR_##name )->set )
+#define HOST_INV( name )            ( hostAccess( &hostSFR_##name )->inv )
+#define HOST_BITS( name, type )     ( *(volatile type*)&hostAccess( &hostSFR_##name )->reg )
+
+#define ADC7CFG              HOST_REG( ADC7CFG )
+#define ADC7CFGCLR           HOST_CLR( ADC7CFG )
+#define ADC7CFGSET           HOST_SET( ADC7CFG )
+#define ADC7CFGINV           HOST_INV( ADC7CFG )
+#define ADCANCON             HOST_REG( ADCANCON )
+#define ADCANCONCLR          HOST_CLR( ADCANCON )
+#define ADCANCONSET          HOST_SET( ADCANCON )
+#define ADCANCONINV          HOST_INV( ADCANCON )
+#define ADCCON1              HOST_REG( ADCCON1 )
+#define ADCCON1CLR           HOST_CLR( ADCCON1 )
+#define ADCCON1SET           HOST_SET( ADCCON1 )
+#define ADCCON1INV           HOST_INV( ADCCON1 )
+#define ADCCON2              HOST_REG( ADCCON2 )
+#define ADCCON2CLR           HOST_CLR( ADCCON2 )
+#define ADCCON2SET           HOST_SET( ADCCON2 )
+#define ADCCON2INV           HOST_INV( ADCCON2 )
+#define ADCCON3              HOST_REG( ADCCON3 )
+#define ADCCON3CLR           HOST_CLR( ADCCON3 )
+#define ADCCON3SET           HOST_SET( ADCCON3 )
+#define ADCCON3INV           HOST_INV( ADCCON3 )
+#define ADCCSS1              HOST_REG( ADCCSS1 )
+#define ADCCSS1CLR           HOST_CLR( ADCCSS1 )
+#define ADCCSS1SET           HOST_SET( ADCCSS1 )
+#define ADCCSS1INV           HOST_INV( ADCCSS1 )
+#define ADCCSS2              HOST_REG( ADCCSS2 )
+#define ADCCSS2CLR           HOST_CLR( ADCCSS2 )
+#define ADCCSS2SET           HOST_SET( ADCCSS2 )
+#define ADCCSS2INV           HOST_INV( ADCCSS2 )
+#define ADCDATA27            HOST_REG( ADCDATA27 )
+#define ADCDATA27CLR         HOST_CLR( ADCDATA27 )
+#define ADCDATA27SET         HOST_SET( ADCDATA27 )
+#define ADCDATA27INV         HOST_INV( ADCDATA27 )
+#define ADCDATA28            HOST_REG( ADCDATA28 )
+#define ADCDATA28CLR         HOST_CLR( ADCDATA28 )
+#define ADCDATA28SET         HOST_SET( ADCDATA28 )
+#define ADCDATA28INV         HOST_INV( ADCDATA28 )
+#define ADCDATA38            HOST_REG( ADCDATA38 )
+#define ADCDATA38CLR         HOST_CLR( ADCDATA38 )
+#define ADCDATA38SET         HOST_SET( ADCDATA38 )
+#define ADCDATA38INV         HOST_INV( ADCDATA38 )
+#define ADCDATA39            HOST_REG( ADCDATA39 )
+#define ADCDATA39CLR         HOST_CLR( ADCDATA39 )
+#define ADCDATA39SET         HOST_SET( ADCDATA39 )
+#define ADCDATA39INV         HOST_INV( ADCDATA39 )
+#define ADCDSTAT2            HOST_REG( ADCDSTAT2 )
+#define ADCDSTAT2CLR         HOST_CLR( ADCDSTAT2 )
+#define ADCDSTAT2SET         HOST_SET( ADCDSTAT2 )
+#define ADCDSTAT2INV         HOST_INV( ADCDSTAT2 )
+#define ADCIMCON2            HOST_REG( ADCIMCON2 )
+#define ADCIMCON2CLR         HOST_CLR( ADCIMCON2 )
+#define ADCIMCON2SET         HOST_SET( ADCIMCON2 )
+#define ADCIMCON2INV         HOST_INV( ADCIMCON2 )
+#define ADCIMCON3            HOST_REG( ADCIMCON3 )
+#define ADCIMCON3CLR         HOST_CLR( ADCIMCON3 )
+#define ADCIMCON3SET         HOST_SET( ADCIMCON3 )
+#define ADCIMCON3INV         HOST_INV( ADCIMCON3 )
+#define ADCTRGSNS            HOST_REG( ADCTRGSNS )
+#define ADCTRGSNSCLR         HOST_CLR( ADCTRGSNS )
+#define ADCTRGSNSSET         HOST_SET( ADCTRGSNS )
+#define ADCTRGSNSINV         HOST_INV( ADCTRGSNS )
+#define CFGEBIA              HOST_REG( CFGEBIA )
+#define CFGEBIACLR           HOST_CLR( CFGEBIA )
+#define CFGEBIASET           HOST_SET( CFGEBIA )
+#define CFGEBIAINV           HOST_INV( CFGEBIA )
+#define CFGEBIC              HOST_REG( CFGEBIC )
+#define CFGEBICCLR           HOST_CLR( CFGEBIC )
+#define CFGEBICSET           HOST_SET( CFGEBIC )
+#define CFGEBICINV           HOST_INV( CFGEBIC )
+#define DCH0CON              HOST_REG( DCH0CON )
+#define DCH0CONCLR           HOST_CLR( DCH0CON )
+#define DCH0CONSET           HOST_SET( DCH0CON )
+#define DCH0CONINV           HOST_INV( DCH0CON )
+#define DCH0CSIZ             HOST_REG( DCH0CSIZ )
+#define DCH0CSIZCLR          HOST_CLR( DCH0CSIZ )
+#define DCH0CSIZSET          HOST_SET( DCH0CSIZ )
+#define DCH0CSIZINV          HOST_INV( DCH0CSIZ )
+#define DCH0DSA              HOST_REG( DCH0DSA )
+#define DCH0DSACLR           HOST_CLR( DCH0DSA )
+#define DCH0DSASET           HOST_SET( DCH0DSA )
+#define DCH0DSAINV           HOST_INV( DCH0DSA )
+#define DCH0DSIZ             HOST_REG( DCH0DSIZ )
+#define DCH0DSIZCLR          HOST_CLR( DCH0DSIZ )
+#define DCH0DSIZSET          HOST_SET( DCH0DSIZ )
+#define DCH0DSIZINV          HOST_INV( DCH0DSIZ )
+#define DCH0ECON             HOST_REG( DCH0ECON )
+#define DCH0ECONCLR          HOST_CLR( DCH0ECON )
+#define DCH0ECONSET          HOST_SET( DCH0ECON )
+#define DCH0ECONINV          HOST_INV( DCH0ECON )
+#define DCH0INT              HOST_REG( DCH0INT )
+#define DCH0INTCLR           HOST_CLR( DCH0INT )
+#define DCH0INTSET           HOST_SET( DCH0INT )
+#define DCH0INTINV           HOST_INV( DCH0INT )
+#define DCH0SSA              HOST_REG( DCH0SSA )
+#define DCH0SSACLR           HOST_CLR( DCH0SSA )
+#define DCH0SSASET           HOST_SET( DCH0SSA )
+#define DCH0SSAINV           HOST_INV( DCH0SSA )
+#define DCH0SSIZ             HOST_REG( DCH0SSIZ )
+#define DCH0SSIZCLR          HOST_CLR( DCH0SSIZ )
+#define DCH0SSIZSET          HOST_SET( DCH0SSIZ )
+#define DCH0SSIZINV          HOST_INV( DCH0SSIZ )
+#define DCH1CON              HOST_REG( DCH1CON )
+#define DCH1CONCLR           HOST_CLR( DCH1CON )
+#define DCH1CONSET           HOST_SET( DCH1CON )
+#define DCH1CONINV           HOST_INV( DCH1CON )
+#define DCH1CSIZ             HOST_REG( DCH1CSIZ )
+#define DCH1CSIZCLR          HOST_CLR( DCH1CSIZ )
+#define DCH1CSIZSET          HOST_SET( DCH1CSIZ )
+#define DCH1CSIZINV          HOST_INV( DCH1CSIZ )
+#define DCH1DSA              HOST_REG( DCH1DSA )
+#define DCH1DSACLR           HOST_CLR( DCH1DSA )
+#define DCH1DSASET           HOST_SET( DCH1DSA )
+#define DCH1DSAINV           HOST_INV( DCH1DSA )
+#define DCH1DSIZ             HOST_REG( DCH1DSIZ )
+#define DCH1DSIZCLR          HOST_CLR( DCH1DSIZ )
+#define DCH1DSIZSET          HOST_SET( DCH1DSIZ )
+#define DCH1DSIZINV          HOST_INV( DCH1DSIZ )
+#define DCH1ECON             HOST_REG( DCH1ECON )
+#define DCH1ECONCLR          HOST_CLR( DCH1ECON )
+#define DCH1ECONSET          HOST_SET( DCH1ECON )
+#define DCH1ECONINV          HOST_INV( DCH1ECON )
+#define DCH1INT              HOST_REG( DCH1INT )
+#define DCH1INTCLR           HOST_CLR( DCH1INT )
+#define DCH1INTSET           HOST_SET( DCH1INT )
+#define DCH1INTINV           HOST_INV( DCH1INT )
+#define DCH1SSA              HOST_REG( DCH1SSA )
+#define DCH1SSACLR           HOST_CLR( DCH1SSA )
+#define DCH1SSASET           HOST_SET( DCH1SSA )
+#define DCH1SSAINV           HOST_INV( DCH1SSA )
+#define DCH1SSIZ             HOST_REG( DCH1SSIZ )
+#define DCH1SSIZCLR          HOST_CLR( DCH1SSIZ )
+#define DCH1SSIZSET          HOST_SET( DCH1SSIZ )
+#define DCH1SSIZINV          HOST_INV( DCH1SSIZ )
+#define DCH2CON              HOST_REG( DCH2CON )
+#define DCH2CONCLR           HOST_CLR( DCH2CON )
+#define DCH2CONSET           HOST_SET( DCH2CON )
+#define DCH2CONINV           HOST_INV( DCH2CON )
+#define DCH2CSIZ             HOST_REG( DCH2CSIZ )
+#define DCH2CSIZCLR          HOST_CLR( DCH2CSIZ )
+#define DCH2CSIZSET          HOST_SET( DCH2CSIZ )
+#define DCH2CSIZINV          HOST_INV( DCH2CSIZ )
+#define DCH2DSA              HOST_REG( DCH2DSA )
+#define DCH2DSACLR           HOST_CLR( DCH2DSA )
+#define DCH2DSASET           HOST_SET( DCH2DSA )
+#define DCH2DSAINV           HOST_INV( DCH2DSA )
+#define DCH2DSIZ             HOST_REG( DCH2DSIZ )
+#define DCH2DSIZCLR          HOST_CLR( DCH2DSIZ )
+#define DCH2DSIZSET          HOST_SET( DCH2DSIZ )
+#define DCH2DSIZINV          HOST_INV( DCH2DSIZ )
+#define DCH2ECON             HOST_REG( DCH2ECON )
+#define DCH2ECONCLR          HOST_CLR( DCH2ECON )
+#define DCH2ECONSET          HOST_SET( DCH2ECON )
+#define DCH2ECONINV          HOST_INV( DCH2ECON )
+#define DCH2INT              HOST_REG( DCH2INT )
+#define DCH2INTCLR           HOST_CLR( DCH2INT )
+#define DCH2INTSET           HOST_SET( DCH2INT )
+#define DCH2INTINV           HOST_INV( DCH2INT )
+#define DCH2SSA              HOST_REG( DCH2SSA )
+#define DCH2SSACLR           HOST_CLR( DCH2SSA )
+#define DCH2SSASET           HOST_SET( DCH2SSA )
+#define DCH2SSAINV           HOST_INV( DCH2SSA )
+#define DCH2SSIZ             HOST_REG( DCH2SSIZ )
+#define DCH2SSIZCLR          HOST_CLR( DCH2SSIZ )
+#define DCH2SSIZSET          HOST_SET( DCH2SSIZ )
+#define DCH2SSIZINV          HOST_INV( DCH2SSIZ )
+#define DCH3CON              HOST_REG( DCH3CON )
+#define DCH3CONCLR           HOST_CLR( DCH3CON )
+#define DCH3CONSET           HOST_SET( DCH3CON )
+#define DCH3CONINV           HOST_INV( DCH3CON )
+#define DCH3CSIZ             HOST_REG( DCH3CSIZ )
+#define DCH3CSIZCLR          HOST_CLR( DCH3CSIZ )
+#define DCH3CSIZSET          HOST_SET( DCH3CSIZ )
+#define DCH3CSIZINV          HOST_INV( DCH3CSIZ )
+#define DCH3DSA              HOST_REG( DCH3DSA )
+#define DCH3DSACLR           HOST_CLR( DCH3DSA )
+#define DCH3DSASET           HOST_SET( DCH3DSA )
+#define DCH3DSAINV           HOST_INV( DCH3DSA )
+#define DCH3DSIZ             HOST_REG( DCH3DSIZ )
+#define DCH3DSIZCLR          HOST_CLR( DCH3DSIZ )
+#define DCH3DSIZSET          HOST_SET( DCH3DSIZ )
+#define DCH3DSIZINV          HOST_INV( DCH3DSIZ )
+#define DCH3ECON             HOST_REG( DCH3ECON )
+#define DCH3ECONCLR          HOST_CLR( DCH3ECON )
+#define DCH3ECONSET          HOST_SET( DCH3ECON )
+#define DCH3ECONINV          HOST_INV( DCH3ECON )
+#define DCH3INT              HOST_REG( DCH3INT )
+#define DCH3INTCLR           HOST_CLR( DCH3INT )
+#define DCH3INTSET           HOST_SET( DCH3INT )
+#define DCH3INTINV           HOST_INV( DCH3INT )
+#define DCH3SSA              HOST_REG( DCH3SSA )
+#define DCH3SSACLR           HOST_CLR( DCH3SSA )
+#define DCH3SSASET           HOST_SET( DCH3SSA )
+#define DCH3SSAINV           HOST_INV( DCH3SSA )
+#define DCH3SSIZ             HOST_REG( DCH3SSIZ )
+#define DCH3SSIZCLR          HOST_CLR( DCH3SSIZ )
+#define DCH3SSIZSET          HOST_SET( DCH3SSIZ )
+#define DCH3SSIZINV          HOST_INV( DCH3SSIZ )
+#define DCH4CON              HOST_REG( DCH4CON )
+#define DCH4CONCLR           HOST_CLR( DCH4CON )
+#define DCH4CONSET           HOST_SET( DCH4CON )
+#define DCH4CONINV           HOST_INV( DCH4CON )
+#define DCH4CSIZ             HOST_REG( DCH4CSIZ )
+#define DCH4CSIZCLR          HOST_CLR( DCH4CSIZ )
+#define DCH4CSIZSET          HOST_SET( DCH4CSIZ )
+#define DCH4CSIZINV          HOST_INV( DCH4CSIZ )
+#define DCH4DSA              HOST_REG( DCH4DSA )
+#define DCH4DSACLR           HOST_CLR( DCH4DSA )
+#define DCH4DSASET           HOST_SET( DCH4DSA )
+#define DCH4DSAINV           HOST_INV( DCH4DSA )
+#define DCH4DSIZ             HOST_REG( DCH4DSIZ )
+#define DCH4DSIZCLR          HOST_CLR( DCH4DSIZ )
+#define DCH4DSIZSET          HOST_SET( DCH4DSIZ )
+#define DCH4DSIZINV          HOST_INV( DCH4DSIZ )
+#define DCH4ECON             HOST_REG( DCH4ECON )
+#define DCH4ECONCLR          HOST_CLR( DCH4ECON )
+#define DCH4ECONSET          HOST_SET( DCH4ECON )
+#define DCH4ECONINV          HOST_INV( DCH4ECON )
+#define DCH4INT              HOST_REG( DCH4INT )
+#define DCH4INTCLR           HOST_CLR( DCH4INT )
+#define DCH4INTSET           HOST_SET( DCH4INT )
+#define DCH4INTINV           HOST_INV( DCH4INT )
+#define DCH4SSA              HOST_REG( DCH4SSA )
+#define DCH4SSACLR           HOST_CLR( DCH4SSA )
+#define DCH4SSASET           HOST_SET( DCH4SSA )
+#define DCH4SSAINV           HOST_INV( DCH4SSA )
+#define DCH4SSIZ             HOST_REG( DCH4SSIZ )
+#define DCH4SSIZCLR          HOST_CLR( DCH4SSIZ )
+#define DCH4SSIZSET          HOST_SET( DCH4SSIZ )
+#define DCH4SSIZINV          HOST_INV( DCH4SSIZ )
+#define DCH5CON              HOST_REG( DCH5CON )
+#define DCH5CONCLR           HOST_CLR( DCH5CON )
+#define DCH5CONSET           HOST_SET( DCH5CON )
+#define DCH5CONINV           HOST_INV( DCH5CON )
+#define DCH5CSIZ             HOST_REG( DCH5CSIZ )
+#define DCH5CSIZCLR          HOST_CLR( DCH5CSIZ )
+#define DCH5CSIZSET          HOST_SET( DCH5CSIZ )
+#define DCH5CSIZINV          HOST_INV( DCH5CSIZ )
+#define DCH5DSA              HOST_REG( DCH5DSA )
+#define DCH5DSACLR           HOST_CLR( DCH5DSA )
+#define DCH5DSASET           HOST_SET( DCH5DSA )
+#define DCH5DSAINV           HOST_INV( DCH5DSA )
+#define DCH5DSIZ             HOST_REG( DCH5DSIZ )
+#define DCH5DSIZCLR          HOST_CLR( DCH5DSIZ )
+#define DCH5DSIZSET          HOST_SET( DCH5DSIZ )
+#define DCH5DSIZINV          HOST_INV( DCH5DSIZ )
+#define DCH5ECON             HOST_REG( DCH5ECON )
+#define DCH5ECONCLR          HOST_CLR( DCH5ECON )
+#define DCH5ECONSET          HOST_SET( DCH5ECON )
+#define DCH5ECONINV          HOST_INV( DCH5ECON )
+#define DCH5INT              HOST_REG( DCH5INT )
+#define DCH5INTCLR           HOST_CLR( DCH5INT )
+#define DCH5INTSET           HOST_SET( DCH5INT )
+#define DCH5INTINV           HOST_INV( DCH5INT )
+#define DCH5SSA              HOST_REG( DCH5SSA )
+#define DCH5SSACLR           HOST_CLR( DCH5SSA )
+#define DCH5SSASET           HOST_SET( DCH5SSA )
+#define DCH5SSAINV           HOST_INV( DCH5SSA )
+#define DCH5SSIZ             HOST_REG( DCH5SSIZ )
+#define DCH5SSIZCLR          HOST_CLR( DCH5SSIZ )
+#define DCH5SSIZSET          HOST_SET( DCH5SSIZ )
+#define DCH5SSIZINV          HOST_INV( DCH5SSIZ )
+#define DCH6CON              HOST_REG( DCH6CON )
+#define DCH6CONCLR           HOST_CLR( DCH6CON )
+#define DCH6CONSET           HOST_SET( DCH6CON )
+#define DCH6CONINV           HOST_INV( DCH6CON )
+#define DCH6CSIZ             HOST_REG( DCH6CSIZ )
+#define DCH6CSIZCLR          HOST_CLR( DCH6CSIZ )
+#define DCH6CSIZSET          HOST_SET( DCH6CSIZ )
+#define DCH6CSIZINV          HOST_INV( DCH6CSIZ )
+#define DCH6DSA              HOST_REG( DCH6DSA )
+#define DCH6DSACLR           HOST_CLR( DCH6DSA )
+#define DCH6DSASET           HOST_SET( DCH6DSA )
+#define DCH6DSAINV           HOST_INV( DCH6DSA )
+#define DCH6DSIZ             HOST_REG( DCH6DSIZ )
+#define DCH6DSIZCLR          HOST_CLR( DCH6DSIZ )
+#define DCH6DSIZSET          HOST_SET( DCH6DSIZ )
+#define DCH6DSIZINV          HOST_INV( DCH6DSIZ )
+#define DCH6ECON             HOST_REG( DCH6ECON )
+#define DCH6ECONCLR          HOST_CLR( DCH6ECON )
+#define DCH6ECONSET          HOST_SET( DCH6ECON )
+#define DCH6ECONINV          HOST_INV( DCH6ECON )
+#define DCH6INT              HOST_REG( DCH6INT )
+#define DCH6INTCLR           HOST_CLR( DCH6INT )
+#define DCH6INTSET           HOST_SET( DCH6INT )
+#define DCH6INTINV           HOST_INV( DCH6INT )
+#define DCH6SSA              HOST_REG( DCH6SSA )
+#define DCH6SSACLR           HOST_CLR( DCH6SSA )
+#define DCH6SSASET           HOST_SET( DCH6SSA )
+#define DCH6SSAINV           HOST_INV( DCH6SSA )
+#define DCH6SSIZ             HOST_REG( DCH6SSIZ )
+#define DCH6SSIZCLR          HOST_CLR( DCH6SSIZ )
+#define DCH6SSIZSET          HOST_SET( DCH6SSIZ )
+#define DCH6SSIZINV          HOST_INV( DCH6SSIZ )
+#define DCH7CON              HOST_REG( DCH7CON )
+#define DCH7CONCLR           HOST_CLR( DCH7CON )
+#define DCH7CONSET           HOST_SET( DCH7CON )
+#define DCH7CONINV           HOST_INV( DCH7CON )
+#define DCH7CSIZ             HOST_REG( DCH7CSIZ )
+#define DCH7CSIZCLR          HOST_CLR( DCH7CSIZ )
+#define DCH7CSIZSET          HOST_SET( DCH7CSIZ )
+#define DCH7CSIZINV          HOST_INV( DCH7CSIZ )
+#define DCH7DSA              HOST_REG( DCH7DSA )
+#define DCH7DSACLR           HOST_CLR( DCH7DSA )
+#define DCH7DSASET           HOST_SET( DCH7DSA )
+#define DCH7DSAINV           HOST_INV( DCH7DSA )
+#define DCH7DSIZ             HOST_REG( DCH7DSIZ )
+#define DCH7DSIZCLR          HOST_CLR( DCH7DSIZ )
+#define DCH7DSIZSET          HOST_SET( DCH7DSIZ )
+#define DCH7DSIZINV          HOST_INV( DCH7DSIZ )
+#define DCH7ECON             HOST_REG( DCH7ECON )
+#define DCH7ECONCLR          HOST_CLR( DCH7ECON )
+#define DCH7ECONSET          HOST_SET( DCH7ECON )
+#define DCH7ECONINV          HOST_INV( DCH7ECON )
+#define DCH7INT              HOST_REG( DCH7INT )
+#define DCH7INTCLR           HOST_CLR( DCH7INT )
+#define DCH7INTSET           HOST_SET( DCH7INT )
+#define DCH7INTINV           HOST_INV( DCH7INT )
+#define DCH7SSA              HOST_REG( DCH7SSA )
+#define DCH7SSACLR           HOST_CLR( DCH7SSA )
+#define DCH7SSASET           HOST_SET( DCH7SSA )
+#define DCH7SSAINV           HOST_INV( DCH7SSA )
+#define DCH7SSIZ             HOST_REG( DCH7SSIZ )
+#define DCH7SSIZCLR          HOST_CLR( DCH7SSIZ )
+#define DCH7SSIZSET          HOST_SET( DCH7SSIZ )
+#define DCH7SSIZINV          HOST_INV( DCH7SSIZ )
+#define DMACON               HOST_REG( DMACON )
+#define DMACONCLR            HOST_CLR( DMACON )
+#define DMACONSET            HOST_SET( DMACON )
+#define DMACONINV            HOST_INV( DMACON )
+#define EBICS0               HOST_REG( EBICS0 )
+#define EBICS0CLR            HOST_CLR( EBICS0 )
+#define EBICS0SET            HOST_SET( EBICS0 )
+#define EBICS0INV            HOST_INV( EBICS0 )
+#define EBIMSK0              HOST_REG( EBIMSK0 )
+#define EBIMSK0CLR           HOST_CLR( EBIMSK0 )
+#define EBIMSK0SET           HOST_SET( EBIMSK0 )
+#define EBIMSK0INV           HOST_INV( EBIMSK0 )
+#define EBISMCON             HOST_REG( EBISMCON )
+#define EBISMCONCLR          HOST_CLR( EBISMCON )
+#define EBISMCONSET          HOST_SET( EBISMCON )
+#define EBISMCONINV          HOST_INV( EBISMCON )
+#define EBISMT0              HOST_REG( EBISMT0 )
+#define EBISMT0CLR           HOST_CLR( EBISMT0 )
+#define EBISMT0SET           HOST_SET( EBISMT0 )
+#define EBISMT0INV           HOST_INV( EBISMT0 )
+#define I2C2BRG              HOST_REG( I2C2BRG )
+#define I2C2BRGCLR           HOST_CLR( I2C2BRG )
+#define I2C2BRGSET           HOST_SET( I2C2BRG )
+#define I2C2BRGINV           HOST_INV( I2C2BRG )
+#define I2C2CON              HOST_REG( I2C2CON )
+#define I2C2CONCLR           HOST_CLR( I2C2CON )
+#define I2C2CONSET           HOST_SET( I2C2CON )
+#define I2C2CONINV           HOST_INV( I2C2CON )
+#define I2C2STAT             HOST_REG( I2C2STAT )
+#define I2C2STATCLR          HOST_CLR( I2C2STAT )
+#define I2C2STATSET          HOST_SET( I2C2STAT )
+#define I2C2STATINV          HOST_INV( I2C2STAT )
+#define I2C4BRG              HOST_REG( I2C4BRG )
+#define I2C4BRGCLR           HOST_CLR( I2C4BRG )
+#define I2C4BRGSET           HOST_SET( I2C4BRG )
+#define I2C4BRGINV           HOST_INV( I2C4BRG )
+#define I2C4CON              HOST_REG( I2C4CON )
+#define I2C4CONCLR           HOST_CLR( I2C4CON )
+#define I2C4CONSET           HOST_SET( I2C4CON )
+#define I2C4CONINV           HOST_INV( I2C4CON )
+#define I2C4RCV              HOST_REG( I2C4RCV )
+#define I2C4RCVCLR           HOST_CLR( I2C4RCV )
+#define I2C4RCVSET           HOST_SET( I2C4RCV )
+#define I2C4RCVINV           HOST_INV( I2C4RCV )
+#define I2C4STAT             HOST_REG( I2C4STAT )
+#define I2C4STATCLR          HOST_CLR( I2C4STAT )
+#define I2C4STATSET          HOST_SET( I2C4STAT )
+#define I2C4STATINV          HOST_INV( I2C4STAT )
+#define I2C4TRN              HOST_REG( I2C4TRN )
+#define I2C4TRNCLR           HOST_CLR( I2C4TRN )
+#define I2C4TRNSET           HOST_SET( I2C4TRN )
+#define I2C4TRNINV           HOST_INV( I2C4TRN )
+#define IEC0                 HOST_REG( IEC0 )
+#define IEC0CLR              HOST_CLR( IEC0 )
+#define IEC0SET              HOST_SET( IEC0 )
+#define IEC0INV              HOST_INV( IEC0 )
+#define IEC1                 HOST_REG( IEC1 )
+#define IEC1CLR              HOST_CLR( IEC1 )
+#define IEC1SET              HOST_SET( IEC1 )
+#define IEC1INV              HOST_INV( IEC1 )
+#define IEC2                 HOST_REG( IEC2 )
+#define IEC2CLR              HOST_CLR( IEC2 )
+#define IEC2SET              HOST_SET( IEC2 )
+#define IEC2INV              HOST_INV( IEC2 )
+#define IEC3                 HOST_REG( IEC3 )
+#define IEC3CLR              HOST_CLR( IEC3 )
+#define IEC3SET              HOST_SET( IEC3 )
+#define IEC3INV              HOST_INV( IEC3 )
+#define IEC4                 HOST_REG( IEC4 )
+#define IEC4CLR              HOST_CLR( IEC4 )
+#define IEC4SET              HOST_SET( IEC4 )
+#define IEC4INV              HOST_INV( IEC4 )
+#define IEC5                 HOST_REG( IEC5 )
+#define IEC5CLR              HOST_CLR( IEC5 )
+#define IEC5SET              HOST_SET( IEC5 )
+#define IEC5INV              HOST_INV( IEC5 )
+#define IEC6                 HOST_REG( IEC6 )
+#define IEC6CLR              HOST_CLR( IEC6 )
+#define IEC6SET              HOST_SET( IEC6 )
+#define IEC6INV              HOST_INV( IEC6 )
+#define IFS0                 HOST_REG( IFS0 )
+#define IFS0CLR              HOST_CLR( IFS0 )
+#define IFS0SET              HOST_SET( IFS0 )
+#define IFS0INV              HOST_INV( IFS0 )
+#define IFS1                 HOST_REG( IFS1 )
+#define IFS1CLR              HOST_CLR( IFS1 )
+#define IFS1SET              HOST_SET( IFS1 )
+#define IFS1INV              HOST_INV( IFS1 )
+#define IFS2                 HOST_REG( IFS2 )
+#define IFS2CLR              HOST_CLR( IFS2 )
+#define IFS2SET              HOST_SET( IFS2 )
+#define IFS2INV              HOST_INV( IFS2 )
+#define IFS3                 HOST_REG( IFS3 )
+#define IFS3CLR              HOST_CLR( IFS3 )
+#define IFS3SET              HOST_SET( IFS3 )
+#define IFS3INV              HOST_INV( IFS3 )
+#define IFS4                 HOST_REG( IFS4 )
+#define IFS4CLR              HOST_CLR( IFS4 )
+#define IFS4SET              HOST_SET( IFS4 )
+#define IFS4INV              HOST_INV( IFS4 )
+#define IFS5                 HOST_REG( IFS5 )
+#define IFS5CLR              HOST_CLR( IFS5 )
+#define IFS5SET              HOST_SET( IFS5 )
+#define IFS5INV              HOST_INV( IFS5 )
+#define IFS6                 HOST_REG( IFS6 )
+#define IFS6CLR              HOST_CLR( IFS6 )
+#define IFS6SET              HOST_SET( IFS6 )
+#define IFS6INV              HOST_INV( IFS6 )
+#define LATB                 HOST_REG( LATB )
+#define LATBCLR              HOST_CLR( LATB )
+#define LATBSET              HOST_SET( LATB )
+#define LATBINV              HOST_INV( LATB )
+#define NVMADDR              HOST_REG( NVMADDR )
+#define NVMADDRCLR           HOST_CLR( NVMADDR )
+#define NVMADDRSET           HOST_SET( NVMADDR )
+#define NVMADDRINV           HOST_INV( NVMADDR )
+#define NVMCON               HOST_REG( NVMCON )
+#define NVMCONCLR            HOST_CLR( NVMCON )
+#define NVMCONSET            HOST_SET( NVMCON )
+#define NVMCONINV            HOST_INV( NVMCON )
+#define NVMDATA0             HOST_REG( NVMDATA0 )
+#define NVMDATA0CLR          HOST_CLR( NVMDATA0 )
+#define NVMDATA0SET          HOST_SET( NVMDATA0 )
+#define NVMDATA0INV          HOST_INV( NVMDATA0 )
+#define NVMKEY               HOST_REG( NVMKEY )
+#define NVMKEYCLR            HOST_CLR( NVMKEY )
+#define NVMKEYSET            HOST_SET( NVMKEY )
+#define NVMKEYINV            HOST_INV( NVMKEY )
+#define NVMSRCADDR           HOST_REG( NVMSRCADDR )
+#define NVMSRCADDRCLR        HOST_CLR( NVMSRCADDR )
+#define NVMSRCADDRSET        HOST_SET( NVMSRCADDR )
+#define NVMSRCADDRINV        HOST_INV( NVMSRCADDR )
+#define OC8CON               HOST_REG( OC8CON )
+#define OC8CONCLR            HOST_CLR( OC8CON )
+#define OC8CONSET            HOST_SET( OC8CON )
+#define OC8CONINV            HOST_INV( OC8CON )
+#define OC8R                 HOST_REG( OC8R )
+#define OC8RCLR              HOST_CLR( OC8R )
+#define OC8RSET              HOST_SET( OC8R )
+#define OC8RINV              HOST_INV( OC8R )
+#define OC8RS                HOST_REG( OC8RS )
+#define OC8RSCLR             HOST_CLR( OC8RS )
+#define OC8RSSET             HOST_SET( OC8RS )
+#define OC8RSINV             HOST_INV( OC8RS )
+#define OC9CON               HOST_REG( OC9CON )
+#define OC9CONCLR            HOST_CLR( OC9CON )
+#define OC9CONSET            HOST_SET( OC9CON )
+#define OC9CONINV            HOST_INV( OC9CON )
+#define OC9R                 HOST_REG( OC9R )
+#define OC9RCLR              HOST_CLR( OC9R )
+#define OC9RSET              HOST_SET( OC9R )
+#define OC9RINV              HOST_INV( OC9R )
+#define OC9RS                HOST_REG( OC9RS )
+#define OC9RSCLR             HOST_CLR( OC9RS )
+#define OC9RSSET             HOST_SET( OC9RS )
+#define OC9RSINV             HOST_INV( OC9RS )
+#define PORTA                HOST_REG( PORTA )
+#define PORTACLR             HOST_CLR( PORTA )
+#define PORTASET             HOST_SET( PORTA )
+#define PORTAINV             HOST_INV( PORTA )
+#define PORTB                HOST_REG( PORTB )
+#define PORTBCLR             HOST_CLR( PORTB )
+#define PORTBSET             HOST_SET( PORTB )
+#define PORTBINV             HOST_INV( PORTB )
+#define PORTC                HOST_REG( PORTC )
+#define PORTCCLR             HOST_CLR( PORTC )
+#define PORTCSET             HOST_SET( PORTC )
+#define PORTCINV             HOST_INV( PORTC )
+#define PORTD                HOST_REG( PORTD )
+#define PORTDCLR             HOST_CLR( PORTD )
+#define PORTDSET             HOST_SET( PORTD )
+#define PORTDINV             HOST_INV( PORTD )
+#define PORTE                HOST_REG( PORTE )
+#define PORTECLR             HOST_CLR( PORTE )
+#define PORTESET             HOST_SET( PORTE )
+#define PORTEINV             HOST_INV( PORTE )
+#define PORTF                HOST_REG( PORTF )
+#define PORTFCLR             HOST_CLR( PORTF )
+#define PORTFSET             HOST_SET( PORTF )
+#define PORTFINV             HOST_INV( PORTF )
+#define PORTG                HOST_REG( PORTG )
+#define PORTGCLR             HOST_CLR( PORTG )
+#define PORTGSET             HOST_SET( PORTG )
+#define PORTGINV             HOST_INV( PORTG )
+#define PORTH                HOST_REG( PORTH )
+#define PORTHCLR             HOST_CLR( PORTH )
+#define PORTHSET             HOST_SET( PORTH )
+#define PORTHINV             HOST_INV( PORTH )
+#define PORTJ                HOST_REG( PORTJ )
+#define PORTJCLR             HOST_CLR( PORTJ )
+#define PORTJSET             HOST_SET( PORTJ )
+#define PORTJINV             HOST_INV( PORTJ )
+#define SPI1BUF              HOST_REG( SPI1BUF )
+#define SPI1BUFCLR           HOST_CLR( SPI1BUF )
+#define SPI1BUFSET           HOST_SET( SPI1BUF )
+#define SPI1BUFINV           HOST_INV( SPI1BUF )
+#define SPI1CON              HOST_REG( SPI1CON )
+#define SPI1CONCLR           HOST_CLR( SPI1CON )
+#define SPI1CONSET           HOST_SET( SPI1CON )
+#define SPI1CONINV           HOST_INV( SPI1CON )
+#define SPI1STAT             HOST_REG( SPI1STAT )
+#define SPI1STATCLR          HOST_CLR( SPI1STAT )
+#define SPI1STATSET          HOST_SET( SPI1STAT )
+#define SPI1STATINV          HOST_INV( SPI1STAT )
+#define SPI3BUF              HOST_REG( SPI3BUF )
+#define SPI3BUFCLR           HOST_CLR( SPI3BUF )
+#define SPI3BUFSET           HOST_SET( SPI3BUF )
+#define SPI3BUFINV           HOST_INV( SPI3BUF )
+#define SPI3CON              HOST_REG( SPI3CON )
+#define SPI3CONCLR           HOST_CLR( SPI3CON )
+#define SPI3CONSET           HOST_SET( SPI3CON )
+#define SPI3CONINV           HOST_INV( SPI3CON )
+#define SPI3CON2             HOST_REG( SPI3CON2 )
+#define SPI3CON2CLR          HOST_CLR( SPI3CON2 )
+#define SPI3CON2SET          HOST_SET( SPI3CON2 )
+#define SPI3CON2INV          HOST_INV( SPI3CON2 )
+#define SPI4BUF              HOST_REG( SPI4BUF )
+#define SPI4BUFCLR           HOST_CLR( SPI4BUF )
+#define SPI4BUFSET           HOST_SET( SPI4BUF )
+#define SPI4BUFINV           HOST_INV( SPI4BUF )
+#define SPI4CON              HOST_REG( SPI4CON )
+#define SPI4CONCLR           HOST_CLR( SPI4CON )
+#define SPI4CONSET           HOST_SET( SPI4CON )
+#define SPI4CONINV           HOST_INV( SPI4CON )
+#define SPI4CON2             HOST_REG( SPI4CON2 )
+#define SPI4CON2CLR          HOST_CLR( SPI4CON2 )
+#define SPI4CON2SET          HOST_SET( SPI4CON2 )
+#define SPI4CON2INV          HOST_INV( SPI4CON2 )
+#define SPI5BUF              HOST_REG( SPI5BUF )
+#define SPI5BUFCLR           HOST_CLR( SPI5BUF )
+#define SPI5BUFSET           HOST_SET( SPI5BUF )
+#define SPI5BUFINV           HOST_INV( SPI5BUF )
+#define SPI5CON              HOST_REG( SPI5CON )
+#define SPI5CONCLR           HOST_CLR( SPI5CON )
+#define SPI5CONSET           HOST_SET( SPI5CON )
+#define SPI5CONINV           HOST_INV( SPI5CON )
+#define SPI5STAT             HOST_REG( SPI5STAT )
+#define SPI5STATCLR          HOST_CLR( SPI5STAT )
+#define SPI5STATSET          HOST_SET( SPI5STAT )
+#define SPI5STATINV          HOST_INV( SPI5STAT )
+#define SPI6BUF              HOST_REG( SPI6BUF )
+#define SPI6BUFCLR           HOST_CLR( SPI6BUF )
+#define SPI6BUFSET           HOST_SET( SPI6BUF )
+#define SPI6BUFINV           HOST_INV( SPI6BUF )
+#define SPI6CON              HOST_REG( SPI6CON )
+#define SPI6CONCLR           HOST_CLR( SPI6CON )
+#define SPI6CONSET           HOST_SET( SPI6CON )
+#define SPI6CONINV           HOST_INV( SPI6CON )
+#define SPI6CON2             HOST_REG( SPI6CON2 )
+#define SPI6CON2CLR          HOST_CLR( SPI6CON2 )
+#define SPI6CON2SET          HOST_SET( SPI6CON2 )
+#define SPI6CON2INV          HOST_INV( SPI6CON2 )
+#define T3CON                HOST_REG( T3CON )
+#define T3CONCLR             HOST_CLR( T3CON )
+#define T3CONSET             HOST_SET( T3CON )
+#define T3CONINV             HOST_INV( T3CON )
+#define TMR3                 HOST_REG( TMR3 )
+#define TMR3CLR              HOST_CLR( TMR3 )
+#define TMR3SET              HOST_SET( TMR3 )
+#define TMR3INV              HOST_INV( TMR3 )
+#define TRISB                HOST_REG( TRISB )
+#define TRISBCLR             HOST_CLR( TRISB )
+#define TRISBSET             HOST_SET( TRISB )
+#define TRISBINV             HOST_INV( TRISB )
+#define U2RXREG              HOST_REG( U2RXREG )
+#define U2RXREGCLR           HOST_CLR( U2RXREG )
+#define U2RXREGSET           HOST_SET( U2RXREG )
+#define U2RXREGINV           HOST_INV( U2RXREG )
+#define U2STA                HOST_REG( U2STA )
+#define U2STACLR             HOST_CLR( U2STA )
+#define U2STASET             HOST_SET( U2STA )
+#define U2STAINV             HOST_INV( U2STA )
+#define U2TXREG              HOST_REG( U2TXREG )
+#define U2TXREGCLR           HOST_CLR( U2TXREG )
+#define U2TXREGSET           HOST_SET( U2TXREG )
+#define U2TXREGINV           HOST_INV( U2TXREG )
+#define U4RXREG              HOST_REG( U4RXREG )
+#define U4RXREGCLR           HOST_CLR( U4RXREG )
+#define U4RXREGSET           HOST_SET( U4RXREG )
+#define U4RXREGINV           HOST_INV( U4RXREG )
+#define U4STA                HOST_REG( U4STA )
+#define U4STACLR             HOST_CLR( U4STA )
+#define U4STASET             HOST_SET( U4STA )
+#define U4STAINV             HOST_INV( U4STA )
+#define U4TXREG              HOST_REG( U4TXREG )
+#define U4TXREGCLR           HOST_CLR( U4TXREG )
+#define U4TXREGSET           HOST_SET( U4TXREG )
+#define U4TXREGINV           HOST_INV( U4TXREG )
+
+// bit fields, for the bits that the firmware uses
+
+typedef struct {
+    unsigned CHPRI:2;
+    unsigned CHEDET:1;
+    unsigned :1;
+    unsigned CHAEN:1;
+    unsigned CHCHN:1;
+    unsigned CHAED:1;
+    unsigned CHEN:1;
+    unsigned CHCHNS:1;
+    unsigned :6;
+    unsigned CHBUSY:1;
+    unsigned :16;
+} __DCHxCONbits_t;
+
+typedef struct {
+    unsigned SPIRBF:1;
+    unsigned SPITBF:1;
+    unsigned :1;
+    unsigned SPITBE:1;
+    unsigned :1;
+    unsigned SPIRBE:1;
+    unsigned SPIROV:1;
+    unsigned SRMT:1;
+    unsigned SPITUR:1;
+    unsigned :2;
+    unsigned SPIBUSY:1;
+    unsigned FRMERR:1;
+    unsigned :19;
+} __SPIxSTATbits_t;
+
+typedef struct {
+    unsigned URXDA:1;
+    unsigned OERR:1;
+    unsigned FERR:1;
+    unsigned PERR:1;
+    unsigned RIDLE:1;
+    unsigned ADDEN:1;
+    unsigned URXISEL:2;
+    unsigned TRMT:1;
+    unsigned UTXBF:1;
+    unsigned UTXEN:1;
+    unsigned UTXBRK:1;
+    unsigned URXEN:1;
+    unsigned :19;
+} __UxSTAbits_t;
+
+typedef struct {
+    unsigned SEN:1;
+    unsigned RSEN:1;
+    unsigned PEN:1;
+    unsigned RCEN:1;
+    unsigned ACKEN:1;
+    unsigned ACKDT:1;
+    unsigned STREN:1;
+    unsigned GCEN:1;
+    unsigned SMEN:1;
+    unsigned DISSLW:1;
+    unsigned A10M:1;
+    unsigned STRICT:1;
+    unsigned SCLREL:1;
+    unsigned SIDL:1;
+    unsigned :1;
+    unsigned ON:1;
+    unsigned :16;
+} __I2CxCONbits_t;
+
+typedef struct {
+    unsigned TBF:1;
+    unsigned RBF:1;
+    unsigned R_W:1;
+    unsigned S:1;
+    unsigned P:1;
+    unsigned D_A:1;
+    unsigned I2COV:1;
+    unsigned IWCOL:1;
+    unsigned ADD10:1;
+    unsigned GCSTAT:1;
+    unsigned BCL:1;
+    unsigned :3;
+    unsigned TRSTAT:1;
+    unsigned ACKSTAT:1;
+    unsigned :16;
+} __I2CxSTATbits_t;
+
+typedef struct {
+    unsigned :15;
+    unsigned ON:1;
+    unsigned STRGSRC:5;
+    unsigned SELRES:2;
+    unsigned :9;
+} __ADCCON1bits_t;
+
+typedef struct {
+    unsigned ADCDIV:7;
+    unsigned :23;
+    unsigned REFFLT:1;
+    unsigned BGVRRDY:1;
+} __ADCCON2bits_t;
+
+typedef struct {
+    unsigned :6;
+    unsigned GSWTRG:1;
+    unsigned :16;
+    unsigned DIGEN7:1;
+    unsigned :8;
+} __ADCCON3bits_t;
+
+typedef struct {
+    unsigned :7;
+    unsigned ANEN7:1;
+    unsigned :7;
+    unsigned WKRDY7:1;
+    unsigned :16;
+} __ADCANCONbits_t;
+
+typedef struct {
+    unsigned :7;
+    unsigned ARDY39:1;
+    unsigned :24;
+} __ADCDSTAT2bits_t;
+
+typedef struct {
+    unsigned :14;
+    unsigned T3IF:1;
+    unsigned :17;
+} __IFS0bits_t;
+
+typedef struct {
+    unsigned :23;
+    unsigned PAGEMODE:1;
+    unsigned :8;
+} __EBISMT0bits_t;
+
+typedef struct {
+    unsigned :11;
+    unsigned DMABUSY:1;
+    unsigned SUSPEND:1;
+    unsigned :2;
+    unsigned ON:1;
+    unsigned :16;
+} __DMACONbits_t;
+
+typedef struct {
+    unsigned :11;
+    unsigned LATB11:1;
+    unsigned :20;
+} __LATBbits_t;
+
+typedef struct {
+    unsigned :11;
+    unsigned TRISB11:1;
+    unsigned :20;
+} __TRISBbits_t;
+
+#define DCH0CONbits         HOST_BITS( DCH0CON, __DCHxCONbits_t )
+#define DCH1CONbits         HOST_BITS( DCH1CON, __DCHxCONbits_t )
+#define DCH2CONbits         HOST_BITS( DCH2CON, __DCHxCONbits_t )
+#define DCH3CONbits         HOST_BITS( DCH3CON, __DCHxCONbits_t )
+#define DCH4CONbits         HOST_BITS( DCH4CON, __DCHxCONbits_t )
+#define DCH5CONbits         HOST_BITS( DCH5CON, __DCHxCONbits_t )
+#define DCH6CONbits         HOST_BITS( DCH6CON, __DCHxCONbits_t )
+#define DCH7CONbits         HOST_BITS( DCH7CON, __DCHxCONbits_t )
+#define SPI1STATbits        HOST_BITS( SPI1STAT, __SPIxSTATbits_t )
+#define SPI5STATbits        HOST_BITS( SPI5STAT, __SPIxSTATbits_t )
+#define U2STAbits           HOST_BITS( U2STA, __UxSTAbits_t )
+#define U4STAbits           HOST_BITS( U4STA, __UxSTAbits_t )
+#define I2C2CONbits         HOST_BITS( I2C2CON, __I2CxCONbits_t )
+#define I2C4CONbits         HOST_BITS( I2C4CON, __I2CxCONbits_t )
+#define I2C2STATbits        HOST_BITS( I2C2STAT, __I2CxSTATbits_t )
+#define I2C4STATbits        HOST_BITS( I2C4STAT, __I2CxSTATbits_t )
+#define ADCCON1bits         HOST_BITS( ADCCON1, __ADCCON1bits_t )
+#define ADCCON2bits         HOST_BITS( ADCCON2, __ADCCON2bits_t )
+#define ADCCON3bits         HOST_BITS( ADCCON3, __ADCCON3bits_t )
+#define ADCANCONbits        HOST_BITS( ADCANCON, __ADCANCONbits_t )
+#define ADCDSTAT2bits       HOST_BITS( ADCDSTAT2, __ADCDSTAT2bits_t )
+#define IFS0bits            HOST_BITS( IFS0, __IFS0bits_t )
+#define EBISMT0bits         HOST_BITS( EBISMT0, __EBISMT0bits_t )
+#define DMACONbits          HOST_BITS( DMACON, __DMACONbits_t )
+#define LATBbits            HOST_BITS( LATB, __LATBbits_t )
+#define TRISBbits           HOST_BITS( TRISB, __TRISBbits_t )
+
+// masks and positions
+
+#define TxCON_ON_MASK                   0x00008000
+#define _IFS0_T3IF_MASK                 0x00004000
+#define _IEC5_SPI5EIE_MASK              0x00010000
+#define _IEC5_SPI5RXIE_MASK             0x00020000
+#define _IEC5_SPI5TXIE_MASK             0x00040000
+#define _IFS5_SPI5EIF_MASK              0x00010000
+#define _IFS5_SPI5RXIF_MASK             0x00020000
+#define _IFS5_SPI5TXIF_MASK             0x00040000
+#define _DMACON_SUSPEND_MASK            0x00001000
+#define _ADCCON1_STRGSRC_POSITION       16
+#define _ADCCON1_SELRES_POSITION        21
+#define _ADCCON2_ADCDIV_POSITION        0
+#define _ADCCON2_EOSIEN_POSITION        13
+#define _ADCCON2_SAMC_POSITION          16
+#define _ADCANCON_WKUPCLKCNT_POSITION   24
+#define _ADCCON3_CONCLKDIV_POSITION     24
+#define _ADCCON3_ADCSEL_POSITION        30
+#define _ADCCSS1_CSS27_MASK             0x08000000
+#define _ADCCSS1_CSS28_MASK             0x10000000
+#define _ADCCSS2_CSS38_MASK             0x00000040
+#define _ADCCSS2_CSS39_MASK             0x00000080
+
+// factory calibration word, copied into ADC7CFG
+#define DEVADC7                         0
+
+#define _CP0_COUNT              9
+#define _CP0_COUNT_SELECT       0
+#define _CP0_EPC                14
+#define _CP0_EPC_SELECT         0
+
+// the core timer runs at half the system clock
+unsigned int hostCoreTimer(void);
+// in an interrupt, where it will return to
+unsigned int hostExceptionPC(void);
+#define __builtin_mfc0( reg, sel )      ( ( (reg) == _CP0_EPC ) ? hostExceptionPC() : hostCoreTimer() )
+
+unsigned int hostDisableInterrupts(void);
+unsigned int hostEnableInterrupts(void);
+#define __builtin_disable_interrupts()  hostDisableInterrupts()
+#define __builtin_enable_interrupts()   hostEnableInterrupts()
+
+#define __ISR( vector, ipl )
+
+// stand in for the Peaks and calibration settings pages of flash
+extern int hostPeaksNVM[0x4000/4];
+extern int hostSettingsNVM[0x4000/4];
+
+// stands in for the external SRAM
+extern char hostSRAM[];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HOST_XC_H */
@@ -0,0 +1,196 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * The cost of the looper (algorithm_looper.cc), per block, by the number of
+ * taps and the block size.
+ *
+ * The host's time per block is shown alongside the SRAM traffic, counted by
+ * sramBurstRead() and sramBurstWrite(), and what that would take on the
+ * EBI with its default timing (see sramtest.c): a read is TRC for the first
+ * halfword in a page and TPRC for the rest, and a write TAS+TWP+TWR for
+ * every halfword. First, a loop is recorded and played back, which must
+ * come back exactly as it went in (to 16 bits).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "algorithm_base.h"
+#include "host.h"
+
+enum { kTRC = 6, kTAS = 1, kTWR = 1, kTWP = 3, kTPRC = 2 };
+
+enum { kBenchBlocks = 1 << 12 };
+enum { kLoopBlocks = 100 };
+
+static int inputs[6][k_maxFramesPerBlock];
+static int outputs[4][k_maxFramesPerBlock];
+static const int* const in[6] = { inputs[0], inputs[1], inputs[2], inputs[3], inputs[4], inputs[5] };
+static int* const out[4] = { outputs[0], outputs[1], outputs[2], outputs[3] };
+
+static void randomInputs( int frames )
+{
+    int i;
+    for ( i=0; i<frames; ++i )
+    {
+        inputs[0][i] = ( rand() % ( 20 * kQ24One ) ) - 10 * kQ24One;
+        inputs[1][i] = ( rand() % ( 20 * kQ24One ) ) - 10 * kQ24One;
+    }
+}
+
+static void setGate( int frames, bool high )
+{
+    int i;
+    for ( i=0; i<frames; ++i )
+        inputs[2][i] = high ? 5 * kQ24One : 0;
+}
+
+static Algorithm* start( int frames )
+{
+    Algorithm* a = looperAlgorithm( 0 );
+    framesPerBlock = frames;
+    sramInit();
+    a->sram = sramClaimRegions( a->name(), kSramRegions );
+    a->init();
+    memset( inputs, 0, sizeof inputs );
+    return a;
+}
+
+static void setTaps( Algorithm* a, int taps )
+// turning the encoder while it's held
+{
+    int enc[2] = { 0, 0 };
+    halfState[0].encSW = 0;
+    a->UI( enc );
+    enc[0] = -8;
+    a->UI( enc );
+    enc[0] = taps - 1;
+    a->UI( enc );
+    halfState[0].encSW = 1;
+    enc[0] = 0;
+    a->UI( enc );
+}
+
+static int checkLoop(void)
+// the number of frames that don't come back as they went in
+{
+    const int n = 16;
+    static int recorded[kLoopBlocks][2][k_maxFramesPerBlock];
+    Algorithm* a = start( n );
+    int b, i, c, errors = 0;
+    for ( b=0; b<kLoopBlocks; ++b )
+    {
+        // the first gate starts the recording
+        setGate( n, b == 0 );
+        randomInputs( n );
+        a->stepRouted( in, out );
+        for ( c=0; c<2; ++c )
+            for ( i=0; i<n; ++i )
+            {
+                int v = inputs[c][i] >> 13;
+                APPLY_RANGE( v, -0x8000, 0x7fff );
+                recorded[b][c][i] = v << 13;
+            }
+    }
+    // and the second plays it back
+    memset( inputs, 0, sizeof inputs );
+    for ( b=0; b<2*kLoopBlocks; ++b )
+    {
+        setGate( n, b == 0 );
+        a->stepRouted( in, out );
+        for ( c=0; c<2; ++c )
+            for ( i=0; i<n; ++i )
+                if ( outputs[c][i] != recorded[ b % kLoopBlocks ][c][i] )
+                    errors += 1;
+    }
+    if ( a->looperState() != 2 )
+        errors += 1;
+    sramReleaseRegion( a->sram );
+    a->sram = NULL;
+    return errors;
+}
+
+int main( int argc, char** argv )
+{
+    int repeats = ( argc > 1 ) ? atoi( argv[1] ) : 5;
+    if ( repeats < 1 )
+    {
+        fprintf( stderr, "usage: looper_bench [repeats]\n" );
+        return 2;
+    }
+    srand( 1 );
+    hostInitialise();
+
+    int errors = checkLoop();
+    printf( "# loop of %d blocks, %d frames wrong\n", kLoopBlocks, errors );
+
+    // half feedback, full level
+    adcs.Z[0].value = 1 << 14;
+    adcs.Z[1].value = ( 1 << 15 ) - 1;
+
+    printf( "# per block          host ns   words read  pages  written   EBI clocks\n" );
+    int taps, n;
+    for ( n=k_minFramesPerBlock; n<=k_maxFramesPerBlock; n *= 2 )
+    {
+        for ( taps=1; taps<=8; ++taps )
+        {
+            Algorithm* a = start( n );
+            setTaps( a, taps );
+            // until the taps have something to read
+            int b;
+            for ( b=0; b<SAMPLE_RATE/n; ++b )
+            {
+                randomInputs( n );
+                a->stepRouted( in, out );
+            }
+
+            double best = 0.0;
+            int r;
+            for ( r=0; r<repeats; ++r )
+            {
+                sramBurstWordsRead = sramBurstWordsWritten = sramBurstPagesRead = 0;
+                uint64_t t0 = hostNanoseconds();
+                for ( b=0; b<kBenchBlocks; ++b )
+                    a->stepRouted( in, out );
+                uint64_t t1 = hostNanoseconds();
+                double ns = (double)( t1 - t0 ) / kBenchBlocks;
+                if ( r == 0 || ns < best )
+                    best = ns;
+            }
+            double words = (double)sramBurstWordsRead / kBenchBlocks;
+            double pages = (double)sramBurstPagesRead / kBenchBlocks;
+            double written = (double)sramBurstWordsWritten / kBenchBlocks;
+            double clocks = pages * kTRC + ( 2 * words - pages ) * kTPRC + 2 * written * ( kTAS + kTWP + kTWR );
+            printf( "taps %d frames %2d  %9.1f  %9.1f  %5.1f  %7.1f  %9.1f\n",
+                    taps, n, best, words, pages, written, clocks );
+
+            sramReleaseRegion( a->sram );
+            a->sram = NULL;
+        }
+    }
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,94 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pgm.h"
+
+enum { kWidth = 128, kHeight = 32 };
+
+int pgmWriteScreen( const char* path, const unsigned int* screen )
+{
+    FILE* f = fopen( path, "wb" );
+    if ( !f )
+        return -1;
+    fprintf( f, "P5\n%d %d\n255\n", kWidth, kHeight );
+    int x, y;
+    for ( y=0; y<kHeight; ++y )
+        for ( x=0; x<kWidth; ++x )
+            fputc( ( screen[x] >> y ) & 1 ? 255 : 0, f );
+    return fclose( f ) ? -1 : 0;
+}
+
+int pgmReadScreen( const char* path, unsigned int* screen )
+{
+    FILE* f = fopen( path, "rb" );
+    if ( !f )
+        return -1;
+    int width, height, maxval;
+    if ( fscanf( f, "P5 %d %d %d", &width, &height, &maxval ) != 3
+            || width != kWidth || height != kHeight || fgetc( f ) == EOF )
+    {
+        fclose( f );
+        return -1;
+    }
+    memset( screen, 0, kWidth * sizeof screen[0] );
+    int x, y;
+    for ( y=0; y<kHeight; ++y )
+    {
+        for ( x=0; x<kWidth; ++x )
+        {
+            int p = fgetc( f );
+            if ( p == EOF )
+            {
+                fclose( f );
+                return -1;
+            }
+            if ( p >= 128 )
+                screen[x] |= 1u << y;
+        }
+    }
+    fclose( f );
+    return 0;
+}
+
+void pgmPrintDifferences( const unsigned int* screen, const unsigned int* expected )
+{
+    int x, y;
+    for ( y=0; y<kHeight; ++y )
+    {
+        char line[ kWidth + 1 ];
+        for ( x=0; x<kWidth; ++x )
+        {
+            unsigned int bit = 1u << y;
+            if ( ( screen[x] ^ expected[x] ) & bit )
+                line[x] = 'x';
+            else
+                line[x] = ( expected[x] & bit ) ? '#' : '.';
+        }
+        line[ kWidth ] = 0;
+        fprintf( stderr, "%s\n", line );
+    }
+}
@@ -0,0 +1,48 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * The screen (128 columns of 32 rows, the top row in bit 0) as a binary
+ * PGM image, for looking at and for the golden image tests.
+ */
+
+#ifndef _PGM_H
+#define _PGM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int     pgmWriteScreen( const char* path, const unsigned int* screen );
+int     pgmReadScreen( const char* path, unsigned int* screen );
+
+// the rows and columns that differ, as 'x' over the expected image in
+// '#' and '.', to stderr
+void    pgmPrintDifferences( const unsigned int* screen, const unsigned int* expected );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PGM_H */
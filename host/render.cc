@@ -0,0 +1,528 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Offline renderer and benchmark for algorithm_step().
+ *
+ * Feeds _algorithm_blocks from a WAV or CSV file (or a built-in gate pattern),
+ * runs every Peaks function (or just one) over it, writes the outputs to WAV,
+ * and reports the time taken per block and per sample.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "algorithm.h"
+#include "scheduler.h"
+#include "sram.h"
+#include "host.h"
+#include "wav.h"
+
+#define PEAKS_DRIVERS_GATE_INPUT_H_
+#define PEAKS_DRIVERS_SWITCHES_H_
+enum { kNumSwitches = 2 };
+struct Switches {};
+#include "peaks/ui.h"
+
+void SetFunction(uint8_t index, peaks::Function f);
+
+static _algorithm_blocks blocks __attribute__((aligned(16)));
+
+// where each logical input/output lives in the DMA buffers
+// (see algorithm_step())
+static const struct { int stereo, side; } kInputSlots[6] = {
+    { 0, 0 }, { 0, 1 }, { 1, 0 }, { 1, 1 }, { 2, 1 }, { 2, 0 },
+};
+static const struct { int stereo, side; } kOutputSlots[6] = {
+    { 0, 1 }, { 0, 0 }, { 1, 1 }, { 1, 0 }, { 2, 0 }, { 2, 1 },
+};
+
+static const char* const functionNames[peaks::FUNCTION_LAST] = {
+    "ENVELOPE",
+    "LFO",
+    "TAP_LFO",
+    "DRUMS",
+    "MINISEQ",
+    "SHAPER",
+    "RANDOMIZ",
+    "FM_DRUM",
+};
+
+typedef struct {
+    double  nsPerBlock;
+    double  nsPerSample;
+    double  maxNsPerBlock;
+    double  dispatchesPerBlock;
+} _result;
+
+static void usage(void)
+{
+    fprintf( stderr,
+        "usage: distingEX_render [options]\n"
+        "  -i <file>    input .wav or .csv (default: built-in gate pattern)\n"
+        "  -o <file>    output .wav (function name is appended when rendering all)\n"
+        "  -f <n>       render only Peaks function n (0-%d)\n"
+        "  -s <secs>    length of the built-in input (default 4)\n"
+        "  -v <volts>   volts at WAV full scale, inputs and outputs (default 10)\n"
+        "  -k <a,b>     pot positions, 0-65535\n"
+        "  -r <n>       repeat the render n times, keeping the fastest (default 3)\n"
+        "  -w <file>    write the timing report to a file\n"
+        "  -c <file>    compare against a saved report, exit 1 on regression\n"
+        "  -t <pct>     regression tolerance in percent (default 10)\n"
+        "  -b <frames>  audio block size, %d-%d (default %d)\n"
+        "\n"
+        "CSV input is one line per 96kHz frame, up to six columns of volts.\n"
+        "Outputs 1-4 are written in volts, 5-6 as raw codes.\n",
+        peaks::FUNCTION_LAST-1, k_minFramesPerBlock, k_maxFramesPerBlock, k_minFramesPerBlock );
+    exit( 2 );
+}
+
+static void makeDefaultInput( _wav* in, float seconds, float fullScale )
+{
+    in->numChannels = 6;
+    in->sampleRate = SAMPLE_RATE;
+    in->numFrames = seconds * SAMPLE_RATE;
+    in->data = (float*)calloc( in->numFrames * in->numChannels, sizeof(float) );
+    int i;
+    for ( i=0; i<in->numFrames; ++i )
+    {
+        // 5V gates at 4Hz and 3Hz on the trigger inputs
+        in->data[ 6*i + 0 ] = ( ( i / ( SAMPLE_RATE/8 ) ) & 1 ) ? 5.0f / fullScale : 0.0f;
+        in->data[ 6*i + 1 ] = ( ( i / ( SAMPLE_RATE/6 ) ) & 1 ) ? 5.0f / fullScale : 0.0f;
+        // a slow triangle on the CV inputs
+        float tri = fabsf( fmodf( i * ( 2.0f / SAMPLE_RATE ), 2.0f ) - 1.0f );
+        in->data[ 6*i + 2 ] = tri * 2.0f / fullScale;
+        in->data[ 6*i + 3 ] = -tri * 2.0f / fullScale;
+    }
+}
+
+static _taskResult frontPanelTask(void)
+// as the firmware's, with the encoders still
+{
+    const int enc[2] = { 0, 0 };
+    algorithm_UI( enc );
+    return kTaskDone;
+}
+
+static void render( const _wav* in, float inScale, float fullScale, _wav* out, _result* result )
+{
+    const int numBlocks = in->numFrames / framesPerBlock;
+    uint64_t total = 0, maxBlock = 0;
+    int b, i, c;
+
+    algorithmDispatches = 0;
+
+    schedulerInit();
+    schedulerAddTask( "front panel", frontPanelTask, kRateHz, SLOW_RATE, 100, 2 );
+
+    for ( b=0; b<numBlocks; ++b )
+    {
+        const int ping = ( b & 1 ) ? (framesPerBlock*2) : 0;
+        const float* src = in->data + b * framesPerBlock * in->numChannels;
+
+        for ( i=0; i<framesPerBlock; ++i )
+        {
+            for ( c=0; c<6; ++c )
+            {
+                float v = ( c < in->numChannels ) ? src[ i * in->numChannels + c ] * inScale : 0.0f;
+                int code = lrintf( hostInputCode( c, v ) );
+                CLAMP( code );
+                blocks.in[ kInputSlots[c].stereo ][ ping + 2*i + kInputSlots[c].side ] = code;
+            }
+        }
+
+        time += framesPerBlock;
+
+        uint64_t t0 = hostNanoseconds();
+        algorithm_step( &blocks, ping );
+        uint64_t t1 = hostNanoseconds() - t0;
+
+        total += t1;
+        if ( t1 > maxBlock )
+            maxBlock = t1;
+
+        if ( out )
+        {
+            float* dst = out->data + b * framesPerBlock * 6;
+            for ( i=0; i<framesPerBlock; ++i )
+            {
+                for ( c=0; c<6; ++c )
+                {
+                    int code = blocks.out[ kOutputSlots[c].stereo ][ ping + 2*i + kOutputSlots[c].side ];
+                    dst[ 6*i + c ] = ( c < 4 ) ? hostOutputVolts( c, code ) / fullScale : code * ( 1.0f / 0x800000 );
+                }
+            }
+        }
+
+        // as the audio and the foreground, with nothing else to do
+        schedulerTick( framesPerBlock );
+        while ( schedulerService() )
+            ;
+    }
+
+    result->nsPerBlock = numBlocks ? (double)total / numBlocks : 0.0;
+    result->nsPerSample = result->nsPerBlock / framesPerBlock;
+    result->maxNsPerBlock = maxBlock;
+    result->dispatchesPerBlock = numBlocks ? (double)algorithmDispatches / numBlocks : 0.0;
+}
+
+static int findAlgorithm( const char* name )
+{
+    int i;
+    for ( i=0; i<algorithm_count(); ++i )
+        if ( !strcmp( algorithm_name( i ), name ) )
+            return i;
+    fprintf( stderr, "no algorithm called %s\n", name );
+    exit( 2 );
+}
+
+static unsigned int dispatchesOver( int numBlocks )
+// the calls into the algorithms, with silence in
+{
+    memset( &blocks, 0, sizeof blocks );
+    algorithmDispatches = 0;
+    int b;
+    for ( b=0; b<numBlocks; ++b )
+        algorithm_step( &blocks, ( b & 1 ) ? (framesPerBlock*2) : 0 );
+    return algorithmDispatches;
+}
+
+static void switchInBackground(void)
+// initialises the requested algorithms, up to the crossfade
+{
+    int i;
+    for ( i=0; i<10000 && algorithmSwitching(); ++i )
+        algorithmSwitchService();
+}
+
+static int checkDispatch( const char* what, unsigned int got, unsigned int expected )
+{
+    if ( got == expected )
+        return 0;
+    printf( "DISPATCH %s: %u algorithm calls, expected %u\n", what, got, expected );
+    return 1;
+}
+
+static int checkDispatches(void)
+// one call into each running algorithm per block, in the dual mode and
+// through a crossfade too
+{
+    enum { kBlocks = 64, kCrossfade = 16 };
+    const int thru = findAlgorithm( "Thru" );
+    const int looper = findAlgorithm( "Looper" );
+    int failures = 0;
+
+    hostInitialise();
+    algorithm_setCrossfadeBlocks( kCrossfade );
+
+    algorithm_select( thru );
+    failures += checkDispatch( "single", dispatchesOver( kBlocks ), kBlocks );
+
+    algorithm_selectDual( thru, looper );
+    failures += checkDispatch( "dual", dispatchesOver( kBlocks ), 2 * kBlocks );
+
+    // slot 0 carries on, so only runs once - then the new config alone
+    requestDualAlgorithm( 1, thru );
+    switchInBackground();
+    failures += checkDispatch( "dual crossfade", dispatchesOver( kCrossfade + 1 ), 3 * kCrossfade + 2 );
+
+    // both of the old, and the new
+    requestAlgorithm( looper );
+    switchInBackground();
+    failures += checkDispatch( "dual to single crossfade", dispatchesOver( kCrossfade + 1 ), 3 * kCrossfade + 1 );
+    failures += checkDispatch( "after the crossfade", dispatchesOver( kBlocks ), kBlocks );
+    if ( algorithmSwitching() )
+    {
+        printf( "DISPATCH the switch didn't finish\n" );
+        failures += 1;
+    }
+
+    algorithm_setCrossfadeBlocks( kDefaultCrossfadeBlocks );
+    return failures;
+}
+
+static int regionsOwnedBy( const char* name )
+{
+    int i, n = 0;
+    for ( i=0; i<kSramRegions; ++i )
+        if ( sramArenas[i].owner && !strcmp( sramArenas[i].owner, name ) )
+            n += 1;
+    return n;
+}
+
+static int checkSram( const char* what, const char* name, int expected )
+{
+    int got = regionsOwnedBy( name );
+    if ( got == expected )
+        return 0;
+    printf( "SRAM %s: %s has %d regions, expected %d\n", what, name, got, expected );
+    return 1;
+}
+
+static int checkSramClaims(void)
+// only the algorithms that ask for SRAM hold any, so a looper started in
+// the background gets all of it - and one that would find none waits for
+// the audio to stop
+{
+    enum { kCrossfade = 16 };
+    const int thru = findAlgorithm( "Thru" );
+    const int looper = findAlgorithm( "Looper" );
+    int failures = 0;
+
+    hostInitialise();
+    algorithm_setCrossfadeBlocks( kCrossfade );
+
+    algorithm_select( thru );
+    failures += checkSram( "single", "Thru", 0 );
+
+    requestAlgorithm( looper );
+    switchInBackground();
+    dispatchesOver( kCrossfade + 1 );
+    failures += checkSram( "background switch", "Looper", kSramRegions );
+
+    // another looper can't start while this one has all of it, so the
+    // audio stops while the regions change hands
+    requestDualAlgorithms( thru, looper );
+    if ( !algorithmSwitchNeedsStop() )
+    {
+        printf( "SRAM single looper to dual: switched in the background\n" );
+        failures += 1;
+    }
+    else
+        algorithmApplyRequest();
+    switchInBackground();
+    dispatchesOver( kCrossfade + 1 );
+    failures += checkSram( "single looper to dual", "Looper", kSramRegions / 2 );
+
+    // and a looper in the other slot has the other half
+    requestDualAlgorithms( looper, thru );
+    if ( algorithmSwitchNeedsStop() )
+    {
+        printf( "SRAM looper to the other slot: stopped the audio\n" );
+        failures += 1;
+    }
+    switchInBackground();
+    dispatchesOver( kCrossfade + 1 );
+    failures += checkSram( "looper to the other slot", "Looper", kSramRegions );
+
+    algorithm_setCrossfadeBlocks( kDefaultCrossfadeBlocks );
+    return failures;
+}
+
+static int loadBaseline( const char* path, _result* baseline, int* present )
+{
+    FILE* f = fopen( path, "r" );
+    if ( !f )
+        return 0;
+    char line[256];
+    while ( fgets( line, sizeof line, f ) )
+    {
+        char name[64];
+        double perBlock, perSample, maxBlock;
+        if ( line[0] == '#' || sscanf( line, "%63s %lf %lf %lf", name, &perBlock, &perSample, &maxBlock ) != 4 )
+            continue;
+        int i;
+        for ( i=0; i<peaks::FUNCTION_LAST; ++i )
+        {
+            if ( !strcmp( name, functionNames[i] ) )
+            {
+                baseline[i].nsPerBlock = perBlock;
+                baseline[i].nsPerSample = perSample;
+                baseline[i].maxNsPerBlock = maxBlock;
+                present[i] = 1;
+            }
+        }
+    }
+    fclose( f );
+    return 1;
+}
+
+int main( int argc, char* argv[] )
+{
+    const char* inPath = NULL;
+    const char* outPath = NULL;
+    const char* reportPath = NULL;
+    const char* comparePath = NULL;
+    int onlyFunction = -1;
+    float seconds = 4.0f;
+    float fullScale = 10.0f;
+    float tolerance = 10.0f;
+    int repeats = 3;
+    int pots[2] = { 0, 0 };
+    int blockSize = k_minFramesPerBlock;
+
+    int a;
+    for ( a=1; a<argc; ++a )
+    {
+        const char* arg = argv[a];
+        if ( arg[0] != '-' || !arg[1] || arg[2] || a+1 >= argc )
+            usage();
+        const char* val = argv[++a];
+        switch ( arg[1] )
+        {
+            case 'i': inPath = val; break;
+            case 'o': outPath = val; break;
+            case 'f': onlyFunction = atoi( val ); break;
+            case 's': seconds = atof( val ); break;
+            case 'v': fullScale = atof( val ); break;
+            case 'k': sscanf( val, "%d,%d", &pots[0], &pots[1] ); break;
+            case 'r': repeats = atoi( val ); break;
+            case 'w': reportPath = val; break;
+            case 'c': comparePath = val; break;
+            case 't': tolerance = atof( val ); break;
+            case 'b': blockSize = atoi( val ); break;
+            default: usage();
+        }
+    }
+    if ( onlyFunction >= peaks::FUNCTION_LAST || repeats < 1 || fullScale <= 0.0f )
+        usage();
+    if ( blockSize < k_minFramesPerBlock || blockSize > k_maxFramesPerBlock || ( blockSize & ( blockSize - 1 ) ) )
+        usage();
+    framesPerBlock = blockSize;
+
+    hostInitialise();
+    sramInit();
+
+    _wav in;
+    float inScale = fullScale;
+    if ( !inPath )
+    {
+        makeDefaultInput( &in, seconds, fullScale );
+    }
+    else
+    {
+        size_t len = strlen( inPath );
+        int isCSV = len > 4 && !strcmp( inPath + len - 4, ".csv" );
+        int ok = isCSV ? csvRead( inPath, &in, SAMPLE_RATE ) : wavRead( inPath, &in );
+        if ( !ok )
+        {
+            fprintf( stderr, "could not read %s\n", inPath );
+            return 2;
+        }
+        if ( isCSV )
+            inScale = 1.0f;
+        if ( in.sampleRate != SAMPLE_RATE )
+            fprintf( stderr, "warning: %s is %d Hz, rendering as %d Hz\n", inPath, in.sampleRate, SAMPLE_RATE );
+    }
+
+    _wav out;
+    out.numChannels = 6;
+    out.sampleRate = SAMPLE_RATE;
+    out.numFrames = ( in.numFrames / framesPerBlock ) * framesPerBlock;
+    out.data = (float*)calloc( out.numFrames * 6, sizeof(float) );
+
+    _result results[peaks::FUNCTION_LAST];
+    int f;
+    for ( f=0; f<peaks::FUNCTION_LAST; ++f )
+    {
+        if ( onlyFunction >= 0 && f != onlyFunction )
+            continue;
+
+        int r;
+        for ( r=0; r<repeats; ++r )
+        {
+            hostInitialise();
+            adcs.Z[0].value = pots[0] >> 1;
+            adcs.Z[1].value = pots[1] >> 1;
+            algorithm_select( 0 );
+            SetFunction( 0, (peaks::Function)f );
+
+            _result result;
+            render( &in, inScale, fullScale, r == 0 && outPath ? &out : NULL, &result );
+            if ( r == 0 || result.nsPerBlock < results[f].nsPerBlock )
+                results[f] = result;
+        }
+
+        if ( outPath )
+        {
+            char path[1024];
+            if ( onlyFunction >= 0 )
+                snprintf( path, sizeof path, "%s", outPath );
+            else
+            {
+                const char* dot = strrchr( outPath, '.' );
+                int stem = dot ? (int)( dot - outPath ) : (int)strlen( outPath );
+                snprintf( path, sizeof path, "%.*s_%s%s", stem, outPath, functionNames[f], dot ? dot : ".wav" );
+            }
+            if ( !wavWrite( path, &out ) )
+                fprintf( stderr, "could not write %s\n", path );
+        }
+    }
+
+    FILE* report = reportPath ? fopen( reportPath, "w" ) : NULL;
+    const double blockPeriod = 1e9 * framesPerBlock / SAMPLE_RATE;
+    printf( "# function ns/block ns/sample max-ns/block (block period %.0f ns)\n", blockPeriod );
+    for ( f=0; f<peaks::FUNCTION_LAST; ++f )
+    {
+        if ( onlyFunction >= 0 && f != onlyFunction )
+            continue;
+        printf( "%-10s %10.1f %10.2f %10.1f\n", functionNames[f], results[f].nsPerBlock, results[f].nsPerSample, results[f].maxNsPerBlock );
+        if ( report )
+            fprintf( report, "%s %.1f %.2f %.1f\n", functionNames[f], results[f].nsPerBlock, results[f].nsPerSample, results[f].maxNsPerBlock );
+    }
+    if ( report )
+        fclose( report );
+
+    // the algorithm interface allows one call into the algorithm per block
+    int regressions = checkDispatches();
+    regressions += checkSramClaims();
+    for ( f=0; f<peaks::FUNCTION_LAST; ++f )
+    {
+        if ( onlyFunction >= 0 && f != onlyFunction )
+            continue;
+        if ( results[f].dispatchesPerBlock != 1.0 )
+        {
+            printf( "DISPATCH %s: %.2f algorithm calls per block\n", functionNames[f], results[f].dispatchesPerBlock );
+            regressions += 1;
+        }
+    }
+
+    if ( comparePath )
+    {
+        _result baseline[peaks::FUNCTION_LAST];
+        int present[peaks::FUNCTION_LAST] = { 0 };
+        if ( !loadBaseline( comparePath, baseline, present ) )
+        {
+            fprintf( stderr, "could not read %s\n", comparePath );
+            return 2;
+        }
+        for ( f=0; f<peaks::FUNCTION_LAST; ++f )
+        {
+            if ( !present[f] || ( onlyFunction >= 0 && f != onlyFunction ) )
+                continue;
+            double limit = baseline[f].nsPerBlock * ( 1.0 + tolerance / 100.0 );
+            if ( results[f].nsPerBlock > limit )
+            {
+                printf( "REGRESSION %s: %.1f ns/block, baseline %.1f\n", functionNames[f], results[f].nsPerBlock, baseline[f].nsPerBlock );
+                regressions += 1;
+            }
+        }
+    }
+
+    wavFree( &in );
+    wavFree( &out );
+    return regressions ? 1 : 0;
+}
@@ -0,0 +1,176 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Host build of the screen: draws screens with the firmware's own
+ * updateDisplay() (display.c, text.c and each algorithm's display()) and
+ * checks them against golden images in golden/, pixel for pixel. A change
+ * to the drawing code that isn't meant to change what's drawn should pass
+ * unchanged.
+ *
+ *   -o dir     also write each screen to dir/<name>.pgm, to look at
+ *   -w         rewrite the golden images, after a deliberate change (look
+ *              at them before committing them)
+ *   -g dir     the golden images (golden/)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app.h"
+#include "algorithm.h"
+#include "display.h"
+#include "sram.h"
+#include "trace.h"
+#include "host.h"
+#include "pgm.h"
+
+// the rest of the firmware, which the drawing doesn't get to
+void serviceForeground(void)
+{
+}
+
+void delayMs( unsigned int ms )
+{
+}
+
+volatile BYTE traceRunning = 0;
+
+void traceEvent( _traceEventType type, unsigned int arg )
+{
+}
+
+typedef struct {
+    const char* name;
+    char        mode;
+    const char* algorithms[ kNumAlgorithmSlots ];   // the second for the dual mode
+    BYTE        pressed;                            // encoder and pot switches held down
+} _screenCase;
+
+static const _screenCase cases[] = {
+    { "normal_peaks",           kDisplayModeNormal,         { "Peaks" } },
+    { "normal_peaks_pressed",   kDisplayModeNormal,         { "Peaks" }, 1 },
+    { "normal_thru",            kDisplayModeNormal,         { "Thru" } },
+    { "normal_looper",          kDisplayModeNormal,         { "Looper" } },
+    { "normal_dual",            kDisplayModeNormal,         { "Thru", "Looper" } },
+    { "message4x16",            kDisplayModeMessage4x16,    { "Thru" } },
+};
+
+static int findAlgorithm( const char* name )
+{
+    int i;
+    for ( i=0; i<algorithm_count(); ++i )
+        if ( !strcmp( algorithm_name( i ), name ) )
+            return i;
+    fprintf( stderr, "no algorithm called %s\n", name );
+    exit( 2 );
+}
+
+static void drawCase( const _screenCase* c )
+{
+    hostInitialise();
+
+    halfState[0].encSW = halfState[1].encSW = !c->pressed;
+    halfState[0].potSW = halfState[1].potSW = !c->pressed;
+
+    if ( c->algorithms[1] )
+        algorithm_selectDual( findAlgorithm( c->algorithms[0] ), findAlgorithm( c->algorithms[1] ) );
+    else
+        algorithm_select( findAlgorithm( c->algorithms[0] ) );
+
+    displayMode = kDisplayModeNormal;
+    if ( c->mode == kDisplayModeMessage4x16 )
+        displayMessage4x16( "disting EX", "  v1.0.0", "", "Hello, world!" );
+
+    updateDisplay();
+}
+
+int main( int argc, char** argv )
+{
+    const char* goldenDir = "golden";
+    const char* outDir = NULL;
+    int write = 0;
+    int i;
+    for ( i=1; i<argc; ++i )
+    {
+        if ( !strcmp( argv[i], "-w" ) )
+            write = 1;
+        else if ( !strcmp( argv[i], "-g" ) && i+1 < argc )
+            goldenDir = argv[++i];
+        else if ( !strcmp( argv[i], "-o" ) && i+1 < argc )
+            outDir = argv[++i];
+        else
+        {
+            fprintf( stderr, "usage: %s [-w] [-g golden dir] [-o output dir]\n", argv[0] );
+            return 1;
+        }
+    }
+
+    hostInitialise();
+    sramInit();
+
+    int failures = 0;
+    for ( i=0; i<ARRAY_SIZE(cases); ++i )
+    {
+        const _screenCase* c = &cases[i];
+        drawCase( c );
+
+        char path[1024];
+        if ( outDir )
+        {
+            snprintf( path, sizeof path, "%s/%s.pgm", outDir, c->name );
+            if ( pgmWriteScreen( path, screen ) )
+                perror( path );
+        }
+
+        snprintf( path, sizeof path, "%s/%s.pgm", goldenDir, c->name );
+        if ( write )
+        {
+            if ( pgmWriteScreen( path, screen ) )
+            {
+                perror( path );
+                failures += 1;
+            }
+            else
+                printf( "%-22s wrote %s\n", c->name, path );
+            continue;
+        }
+        unsigned int expected[128];
+        if ( pgmReadScreen( path, expected ) )
+        {
+            printf( "%-22s can't read %s\n", c->name, path );
+            failures += 1;
+        }
+        else if ( memcmp( expected, screen, sizeof expected ) )
+        {
+            printf( "%-22s FAILED, against %s:\n", c->name, path );
+            pgmPrintDifferences( screen, expected );
+            failures += 1;
+        }
+        else
+            printf( "%-22s identical\n", c->name );
+    }
+    return failures ? 1 : 0;
+}
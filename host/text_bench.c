@@ -0,0 +1,209 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Checks and times the text drawing (text.c).
+ *
+ * The 8x8 font is checked against the column by column loop that
+ * drawString88() used to be, for every glyph at every row and at every
+ * column in and around the display window. A screen of all three fonts is
+ * checked against a golden image, golden/text.pgm ('-w' rewrites it after
+ * a deliberate change, to be looked at before it's committed). Then each
+ * way of drawing is timed, in glyphs per millisecond.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "display.h"
+#include "text.h"
+#include "host.h"
+#include "pgm.h"
+
+unsigned int screenBuffer[128];
+unsigned int* screen = screenBuffer;
+
+static const BYTE font_8x8[96][8] = {
+#include "fonts/codeman38_deluxefont/dlxfont.ttf.h"
+};
+
+static void referenceDrawString88( int x, int y, const char* str )
+// drawString88() as it was
+{
+    for ( ;; )
+    {
+        char c = *str++;
+        if ( !c )
+            break;
+        int index = c - 32;
+        if ( index < 0 || index >= 96 )
+            continue;
+        int i;
+        for ( i=0; i<8; ++i )
+        {
+            unsigned int xx = x + i;
+            if ( xx < displayWindowWidth )
+            {
+                unsigned int f = font_8x8[index][i];
+                screen[displayWindowX + xx] |= ( f << y );
+            }
+        }
+        x += 8;
+    }
+}
+
+static int checkReference(void)
+{
+    static const int windows[][2] = { { 0, 128 }, { 0, 64 }, { 64, 64 } };
+    char all[ kFontGlyphs + 1 ];
+    int i, w, x, y;
+    for ( i=0; i<kFontGlyphs; ++i )
+        all[i] = kFontFirstChar + i;
+    all[ kFontGlyphs ] = 0;
+
+    unsigned int expected[128];
+    int failures = 0;
+    for ( w=0; w<ARRAY_SIZE(windows); ++w )
+    {
+        setDisplayWindow( windows[w][0], windows[w][1] );
+        for ( y=0; y<=24; ++y )
+        {
+            for ( x=-9; x<=129; ++x )
+            {
+                memset( screenBuffer, 0, sizeof screenBuffer );
+                referenceDrawString88( x, y, all );
+                memcpy( expected, screenBuffer, sizeof expected );
+                memset( screenBuffer, 0, sizeof screenBuffer );
+                drawString88( x, y, all );
+                if ( memcmp( expected, screenBuffer, sizeof expected ) )
+                {
+                    if ( !failures )
+                    {
+                        fprintf( stderr, "drawString88( %d, %d ) in window %d+%d differs:\n",
+                                x, y, windows[w][0], windows[w][1] );
+                        pgmPrintDifferences( screenBuffer, expected );
+                    }
+                    failures += 1;
+                }
+            }
+        }
+    }
+    setDisplayWindow( 0, 128 );
+    printf( "8x8 font against the reference: %s\n", failures ? "FAILED" : "identical" );
+    return failures;
+}
+
+static void drawGolden(void)
+{
+    memset( screenBuffer, 0, sizeof screenBuffer );
+    drawString88( 0, 0, "disting EX 1.23" );
+    drawStringFont( &fontProportional, 0, 8, "The quick brown fox, 42%" );
+    int x = drawStringFont( &fontLarge, 0, 16, "Aj-5.0V" );
+    drawStringFont( &fontProportional, x + 2, 23, "[~]" );
+    // right aligned, and clipped at the edge
+    drawStringFont( &fontProportional, 120 - stringWidthFont( &fontProportional, "END" ), 16, "END" );
+    drawStringFont( &fontLarge, 122, 16, "W" );
+}
+
+static int checkGolden( const char* path, int write )
+{
+    drawGolden();
+    if ( write )
+    {
+        if ( pgmWriteScreen( path, screenBuffer ) )
+        {
+            perror( path );
+            return 1;
+        }
+        printf( "wrote %s\n", path );
+        return 0;
+    }
+    unsigned int expected[128];
+    if ( pgmReadScreen( path, expected ) )
+    {
+        fprintf( stderr, "can't read %s\n", path );
+        return 1;
+    }
+    if ( memcmp( expected, screenBuffer, sizeof expected ) )
+    {
+        printf( "golden image %s: FAILED\n", path );
+        pgmPrintDifferences( screenBuffer, expected );
+        return 1;
+    }
+    printf( "golden image %s: identical\n", path );
+    return 0;
+}
+
+enum { kBenchStrings = 200000 };
+
+static const char benchString[] = "FREQ 440.0Hz  -3";
+
+static void bench( const char* name, const _font* font, int y )
+{
+    int glyphs = kBenchStrings * ( sizeof benchString - 1 );
+    uint64_t t0 = hostNanoseconds();
+    int i;
+    for ( i=0; i<kBenchStrings; ++i )
+    {
+        if ( font )
+            drawStringFont( font, 0, y, benchString );
+        else
+            referenceDrawString88( 0, y, benchString );
+        // keeps the compiler from dropping the drawing
+        __asm__ volatile( "" : : "r"( screenBuffer ) : "memory" );
+    }
+    uint64_t t1 = hostNanoseconds();
+    printf( "%-22s row %2d  %8.0f glyphs/ms\n", name, y, glyphs / ( ( t1 - t0 ) / 1e6 ) );
+}
+
+int main( int argc, char** argv )
+{
+    const char* golden = "golden/text.pgm";
+    int write = 0;
+    int i;
+    for ( i=1; i<argc; ++i )
+    {
+        if ( !strcmp( argv[i], "-w" ) )
+            write = 1;
+        else if ( !strcmp( argv[i], "-g" ) && i+1 < argc )
+            golden = argv[++i];
+        else
+        {
+            fprintf( stderr, "usage: %s [-w] [-g golden.pgm]\n", argv[0] );
+            return 1;
+        }
+    }
+
+    int failures = checkReference();
+    failures += checkGolden( golden, write );
+
+    bench( "reference 8x8", NULL, 8 );
+    bench( "reference 8x8", NULL, 3 );
+    bench( "font8x8", &font8x8, 8 );
+    bench( "font8x8", &font8x8, 3 );
+    bench( "fontProportional", &fontProportional, 8 );
+    bench( "fontLarge", &fontLarge, 16 );
+    return failures ? 1 : 0;
+}
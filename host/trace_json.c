@@ -0,0 +1,278 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Turns a dump of the event trace (trace.c, SysEx message 0x62) into
+ * Chrome trace JSON, which chrome://tracing and ui.perfetto.dev open.
+ *
+ * The input is the raw MIDI from the module, such as a .syx file saved by
+ * a SysEx librarian, or from distingEX_emu -m. The last reply in it, and
+ * the messages of events that follow it, are put back together as one
+ * dump. Audio blocks, display frames and flash operations become slices,
+ * each on its own track; MIDI, I2C and overflows are instants. The core timer wraps every 42 seconds or
+ * so, which is undone on the assumption that no two events are further
+ * apart than that.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "trace.h"
+
+enum {
+    kTrackAudio = 1,
+    kTrackDisplay,
+    kTrackNVM,
+    kTrackMIDIIn,
+    kTrackMIDIOut,
+    kTrackI2C,
+};
+
+static const char* const trackNames[] = {
+    NULL, "audio", "display", "flash", "MIDI in", "MIDI out", "I2C",
+};
+
+static const char* const queueNames[] = {
+    "MIDI in", "select bus in", "I2C in",
+};
+
+static FILE* out;
+static int first = 1;
+
+static void event( const char* fmt, ... )
+{
+    va_list args;
+    va_start( args, fmt );
+    fprintf( out, first ? "\n  " : ",\n  " );
+    vfprintf( out, fmt, args );
+    va_end( args );
+    first = 0;
+}
+
+static unsigned int get28( const unsigned char* p )
+{
+    return ( p[0] << 21 ) | ( p[1] << 14 ) | ( p[2] << 7 ) | p[3];
+}
+
+static int decode( const unsigned char* msg, int length )
+// one dump - whether it's running, the ticks per microsecond, the events
+// written and the number here, then the events - returns the number
+{
+    if ( length < 10 )
+        return -1;
+    int ticksPerUs = msg[1];
+    unsigned int written = get28( msg + 2 );
+    unsigned int n = get28( msg + 6 );
+    if ( !ticksPerUs || length < 10 + 10 * n )
+        return -1;
+    fprintf( stderr, "%u events of %u written, %s\n", n, written, ( msg[0] & 1 ) ? "running" : "stopped" );
+
+    const unsigned char* p = msg + 10;
+    uint64_t time = 0;
+    unsigned int last = 0;
+    int open[kTrackI2C+1] = { 0 };
+    unsigned int i;
+    for ( i=0; i<n; ++i, p += 10 )
+    {
+        unsigned int t = ( p[0] << 28 ) | get28( p + 1 );
+        int type = p[5];
+        unsigned int arg = get28( p + 6 );
+        time += i ? (unsigned int)( t - last ) : 0;
+        last = t;
+        double us = time / (double)ticksPerUs;
+
+        switch ( type )
+        {
+            case kTraceAudioBlock:
+                event( "{\"name\":\"block\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                        kTrackAudio, us - arg / (double)ticksPerUs, arg / (double)ticksPerUs );
+                break;
+            case kTraceDisplayStart:
+                event( "{\"name\":\"frame\",\"ph\":\"B\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}", kTrackDisplay, us );
+                open[kTrackDisplay] = 1;
+                break;
+            case kTraceDisplayEnd:
+                if ( open[kTrackDisplay] )
+                    event( "{\"ph\":\"E\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}", kTrackDisplay, us );
+                open[kTrackDisplay] = 0;
+                break;
+            case kTraceNVMStart:
+                event( "{\"name\":\"NVM %04x\",\"ph\":\"B\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}", arg, kTrackNVM, us );
+                open[kTrackNVM] = 1;
+                break;
+            case kTraceNVMEnd:
+                if ( open[kTrackNVM] )
+                    event( "{\"ph\":\"E\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}", kTrackNVM, us );
+                open[kTrackNVM] = 0;
+                break;
+            case kTraceMIDIIn:
+            case kTraceMIDIOut:
+                event( "{\"name\":\"%02x\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}",
+                        arg, type == kTraceMIDIIn ? kTrackMIDIIn : kTrackMIDIOut, us );
+                break;
+            case kTraceI2CAddress:
+                event( "{\"name\":\"%s %02x\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}",
+                        ( arg & 1 ) ? "read" : "write", arg >> 1, kTrackI2C, us );
+                break;
+            case kTraceI2CIn:
+                event( "{\"name\":\"in %02x\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}", arg, kTrackI2C, us );
+                break;
+            case kTraceI2COut:
+                if ( arg > 0xff )
+                    event( "{\"name\":\"out none\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}", kTrackI2C, us );
+                else
+                    event( "{\"name\":\"out %02x\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}", arg, kTrackI2C, us );
+                break;
+            case kTraceOverflow:
+                event( "{\"name\":\"overflow %s\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}",
+                        arg < sizeof queueNames/sizeof queueNames[0] ? queueNames[arg] : "?", kTrackAudio, us );
+                break;
+            default:
+                fprintf( stderr, "unknown event %d\n", type );
+                break;
+        }
+    }
+    // slices still going at the end
+    int k;
+    for ( k=0; k<=kTrackI2C; ++k )
+        if ( open[k] )
+            event( "{\"ph\":\"E\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}", k, time / (double)ticksPerUs );
+    return n;
+}
+
+static void usage( const char* name )
+{
+    fprintf( stderr,
+            "usage: %s [-o trace.json] dump.syx\n"
+            "  -o file      where to write the JSON (default stdout)\n",
+            name );
+}
+
+int main( int argc, char* argv[] )
+{
+    const char* outPath = NULL;
+    int c;
+    while ( ( c = getopt( argc, argv, "o:h" ) ) != -1 )
+    {
+        switch ( c )
+        {
+            case 'o':
+                outPath = optarg;
+                break;
+            default:
+                usage( argv[0] );
+                return 1;
+        }
+    }
+    if ( optind != argc - 1 )
+    {
+        usage( argv[0] );
+        return 1;
+    }
+
+    FILE* f = fopen( argv[optind], "rb" );
+    if ( !f )
+    {
+        fprintf( stderr, "could not read %s\n", argv[optind] );
+        return 1;
+    }
+    fseek( f, 0, SEEK_END );
+    long size = ftell( f );
+    fseek( f, 0, SEEK_SET );
+    unsigned char* data = (unsigned char*)malloc( size + 1 );
+    if ( fread( data, 1, size, f ) != size )
+        size = 0;
+    fclose( f );
+
+    out = outPath ? fopen( outPath, "w" ) : stdout;
+    if ( !out )
+    {
+        fprintf( stderr, "could not write %s\n", outPath );
+        return 1;
+    }
+    fprintf( out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" );
+    int t;
+    for ( t=kTrackAudio; t<=kTrackI2C; ++t )
+        event( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", t, trackNames[t] );
+
+    // the last reply in the file, and the events after it
+    static const unsigned char header[] = { 0xF0, 0x00, 0x21, 0x27, 0x5D };
+    enum { kHeader = 14 };
+    unsigned char* dump = NULL;
+    unsigned int count = 0, received = 0;
+    long i;
+    for ( i=0; i+7<=size; ++i )
+    {
+        if ( memcmp( data + i, header, sizeof header ) || data[i+6] != 0x62 )
+            continue;
+        const unsigned char* msg = data + i + 7;
+        long j = i + 7;
+        while ( j < size && data[j] != 0xF7 )
+            ++j;
+        long length = j - ( i + 7 );
+        if ( j >= size || length < kHeader )
+            continue;
+        unsigned int first = get28( msg + 10 );
+        int n = ( length - kHeader ) / 10;
+        if ( !n )
+        {
+            // a new dump, of count events
+            count = get28( msg + 6 );
+            received = 0;
+            free( dump );
+            dump = (unsigned char*)malloc( 10 + 10 * count );
+            memcpy( dump, msg, 6 );
+        }
+        else if ( dump && first == received && first + n <= count && !memcmp( dump + 2, msg + 2, 4 ) )
+        {
+            memcpy( dump + 10 + 10 * received, msg + kHeader, 10 * n );
+            received += n;
+        }
+    }
+    if ( dump && received < count )
+        fprintf( stderr, "only %u of the dump's %u events\n", received, count );
+    if ( dump )
+    {
+        dump[6] = ( received >> 21 ) & 0x7f;
+        dump[7] = ( received >> 14 ) & 0x7f;
+        dump[8] = ( received >> 7 ) & 0x7f;
+        dump[9] = received & 0x7f;
+    }
+    int n = dump ? decode( dump, 10 + 10 * received ) : -1;
+    fprintf( out, "\n]}\n" );
+    if ( out != stdout )
+        fclose( out );
+    free( data );
+    free( dump );
+    if ( n < 0 )
+    {
+        fprintf( stderr, "no trace dump in %s\n", argv[optind] );
+        return 1;
+    }
+    return 0;
+}
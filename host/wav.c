@@ -0,0 +1,214 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "wav.h"
+
+enum {
+    kWavFormatPCM   = 1,
+    kWavFormatFloat = 3,
+    kWavFormatExtensible = 0xFFFE,
+};
+
+static unsigned int readLE( const unsigned char* p, int bytes )
+{
+    unsigned int v = 0;
+    int i;
+    for ( i=bytes-1; i>=0; --i )
+        v = ( v << 8 ) | p[i];
+    return v;
+}
+
+static void writeLE( FILE* f, unsigned int v, int bytes )
+{
+    int i;
+    for ( i=0; i<bytes; ++i )
+    {
+        fputc( v & 0xff, f );
+        v >>= 8;
+    }
+}
+
+int wavRead( const char* path, _wav* wav )
+{
+    memset( wav, 0, sizeof *wav );
+
+    FILE* f = fopen( path, "rb" );
+    if ( !f )
+        return 0;
+
+    unsigned char hdr[12];
+    if ( fread( hdr, 1, 12, f ) != 12 || memcmp( hdr, "RIFF", 4 ) || memcmp( hdr+8, "WAVE", 4 ) )
+    {
+        fclose( f );
+        return 0;
+    }
+
+    int format = 0, bits = 0;
+    for ( ;; )
+    {
+        unsigned char chunk[8];
+        if ( fread( chunk, 1, 8, f ) != 8 )
+            break;
+        unsigned int size = readLE( chunk+4, 4 );
+        if ( !memcmp( chunk, "fmt ", 4 ) )
+        {
+            unsigned char fmt[40] = { 0 };
+            if ( size > sizeof fmt || fread( fmt, 1, size, f ) != size )
+                break;
+            format = readLE( fmt, 2 );
+            wav->numChannels = readLE( fmt+2, 2 );
+            wav->sampleRate = readLE( fmt+4, 4 );
+            bits = readLE( fmt+14, 2 );
+            if ( format == kWavFormatExtensible && size >= 26 )
+                format = readLE( fmt+24, 2 );
+            if ( size & 1 )
+                fgetc( f );
+        }
+        else if ( !memcmp( chunk, "data", 4 ) )
+        {
+            int bytesPerSample = bits / 8;
+            if ( !wav->numChannels || !bytesPerSample )
+                break;
+            wav->numFrames = size / ( bytesPerSample * wav->numChannels );
+            unsigned char* raw = malloc( size );
+            wav->data = malloc( sizeof(float) * wav->numFrames * wav->numChannels );
+            if ( !raw || !wav->data || fread( raw, 1, size, f ) != size )
+            {
+                free( raw );
+                break;
+            }
+            int i, n = wav->numFrames * wav->numChannels;
+            for ( i=0; i<n; ++i )
+            {
+                const unsigned char* p = raw + i * bytesPerSample;
+                float v = 0.0f;
+                if ( format == kWavFormatFloat && bits == 32 )
+                    memcpy( &v, p, 4 );
+                else if ( format == kWavFormatPCM && bits == 16 )
+                    v = (int16_t)readLE( p, 2 ) * ( 1.0f / 0x8000 );
+                else if ( format == kWavFormatPCM && bits == 24 )
+                    v = ( (int32_t)( readLE( p, 3 ) << 8 ) >> 8 ) * ( 1.0f / 0x800000 );
+                else if ( format == kWavFormatPCM && bits == 32 )
+                    v = (int32_t)readLE( p, 4 ) * ( 1.0f / 0x80000000u );
+                wav->data[i] = v;
+            }
+            free( raw );
+            fclose( f );
+            return 1;
+        }
+        else
+        {
+            fseek( f, size + ( size & 1 ), SEEK_CUR );
+        }
+    }
+
+    fclose( f );
+    wavFree( wav );
+    return 0;
+}
+
+int wavWrite( const char* path, const _wav* wav )
+{
+    FILE* f = fopen( path, "wb" );
+    if ( !f )
+        return 0;
+
+    unsigned int dataSize = wav->numFrames * wav->numChannels * 4;
+    fwrite( "RIFF", 1, 4, f );
+    writeLE( f, 36 + dataSize, 4 );
+    fwrite( "WAVEfmt ", 1, 8, f );
+    writeLE( f, 16, 4 );
+    writeLE( f, kWavFormatFloat, 2 );
+    writeLE( f, wav->numChannels, 2 );
+    writeLE( f, wav->sampleRate, 4 );
+    writeLE( f, wav->sampleRate * wav->numChannels * 4, 4 );
+    writeLE( f, wav->numChannels * 4, 2 );
+    writeLE( f, 32, 2 );
+    fwrite( "data", 1, 4, f );
+    writeLE( f, dataSize, 4 );
+    fwrite( wav->data, 4, wav->numFrames * wav->numChannels, f );
+
+    int ok = !ferror( f );
+    fclose( f );
+    return ok;
+}
+
+int csvRead( const char* path, _wav* wav, int sampleRate )
+{
+    memset( wav, 0, sizeof *wav );
+
+    FILE* f = fopen( path, "r" );
+    if ( !f )
+        return 0;
+
+    enum { kMaxColumns = 8 };
+    int capacity = 0;
+    char line[1024];
+    while ( fgets( line, sizeof line, f ) )
+    {
+        if ( line[0] == '#' || line[0] == '\n' || line[0] == '\r' )
+            continue;
+        float v[kMaxColumns] = { 0 };
+        int n = 0;
+        char* p = line;
+        while ( n < kMaxColumns )
+        {
+            char* end;
+            v[n] = strtof( p, &end );
+            if ( end == p )
+                break;
+            n += 1;
+            p = end;
+            while ( *p == ',' || *p == ' ' || *p == '\t' )
+                p += 1;
+        }
+        if ( !n )
+            continue;
+        if ( !wav->numChannels )
+            wav->numChannels = n;
+        if ( wav->numFrames == capacity )
+        {
+            capacity = capacity ? 2 * capacity : 4096;
+            wav->data = realloc( wav->data, sizeof(float) * capacity * wav->numChannels );
+        }
+        memcpy( wav->data + wav->numFrames * wav->numChannels, v, sizeof(float) * wav->numChannels );
+        wav->numFrames += 1;
+    }
+    fclose( f );
+
+    wav->sampleRate = sampleRate;
+    return wav->numFrames > 0;
+}
+
+void wavFree( _wav* wav )
+{
+    free( wav->data );
+    wav->data = NULL;
+    wav->numFrames = 0;
+}
@@ -0,0 +1,53 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Minimal WAV file reading and writing for the host tools.
+ * Samples are held interleaved, as floats normalised to +/-1.
+ */
+
+#ifndef _WAV_H
+#define _WAV_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    int     numChannels;
+    int     sampleRate;
+    int     numFrames;
+    float*  data;
+} _wav;
+
+int     wavRead( const char* path, _wav* wav );
+int     wavWrite( const char* path, const _wav* wav );
+int     csvRead( const char* path, _wav* wav, int sampleRate );
+void    wavFree( _wav* wav );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _WAV_H */
@@ -22,403 +22,603 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-#include "algorithm.h"
+#include "algorithm_base.h"
 #include "display.h"
-#include "nvm.h"
+#include "cpuload.h"
+#include "sramtest.h"
+
+// the order is the algorithm numbering, as used by kI2C_load_algorithm
+static Algorithm* (* const algorithmTable[])( int slot ) = {
+    peaksAlgorithm,
+    thruAlgorithm,
+    looperAlgorithm,
+};
 
-#include "peaks/processors.h"
-#include "peaks/io_buffer.h"
+typedef struct {
+    Algorithm*  algorithm;
+    int         index;
+} _slot;
+
+// what the audio runs - slot 0 is the only one used outside the dual mode
+typedef struct {
+    bool        dual;
+    _slot       slots[kNumAlgorithmSlots];
+} _config;
+
+// the audio runs *current, and the other is where the next one is set up
+// while it does (see algorithmSwitchService())
+static _config configs[2] = {
+    { false, { { NULL, 0 }, { NULL, 1 } } },
+    { false, { { NULL, 0 }, { NULL, 1 } } },
+};
+static _config* volatile current = &configs[0];
 
-#define PEAKS_DRIVERS_GATE_INPUT_H_
-#define PEAKS_DRIVERS_SWITCHES_H_
-enum { kNumSwitches = 2 };
-struct Switches {};
-#include "peaks/ui.h"
+// each half of the module's inputs and outputs (see ReadCalibrationFromSettings())
+_algorithmRouting algorithmRouting[kNumAlgorithmSlots] = {
+    { { 0, 1, 4, kRouteNone, kRouteNone, kRouteNone }, { 0, 1, kRouteNone, kRouteNone } },
+    { { 2, 3, 5, kRouteNone, kRouteNone, kRouteNone }, { 2, 3, kRouteNone, kRouteNone } },
+};
 
-void SetFunction(uint8_t index, peaks::Function f);
+static struct {
+    volatile bool   pending;
+    bool            dual;
+    int             index[kNumAlgorithmSlots];
+} request = { false };
 
-#define PEAKS_NVM_BASE 0xBD100000
+enum {
+    kSwitchIdle,
+    kSwitchInitialising,        // the foreground is initialising the next config
+    kSwitchCrossfading,         // the audio is running both, fading to the next
+};
 
-enum { kPeaksMagic = 0xbeefbeac };
+// shared between the foreground and the audio, which only looks at it
+// once the foreground has moved it on to kSwitchCrossfading
+static volatile struct {
+    int         state;
+    _config*    next;
+    bool        keep[kNumAlgorithmSlots];   // running already, in the same slot
+    int         slot;                       // being initialised
+    int         step;                       // its next initStep()
+    int         block;
+    int         blocks;                     // of the crossfade, or 0 to cut over
+} algorithmSwitch = { kSwitchIdle };
+
+static int crossfadeBlocks = kDefaultCrossfadeBlocks;
+
+// calibrated Q8.24 volts, for the dual mode and the crossfades
+// (which only the audio uses)
+static int inputPlanes[6][k_maxFramesPerBlock];
+static int outputPlanes[2][4][k_maxFramesPerBlock];
+
+#ifdef DISTING_HOST
+unsigned int algorithmDispatches = 0;
+#endif
+
+static bool validIndex( int index )
+{
+    return index >= 0 && index < algorithm_count();
+}
 
-struct {
-    peaks::GateFlags    gate_flags[2];
-    bool                schmittTrigger[2];
-    peaks::Settings     settings;
-    bool                lastEncSw[2];
-    int                 holdCounter[2];
-    int                 encoderValue[2];
-    int                 potValue[2];
-    uint16_t            processorParams[2][4];
-    bool                writeToFlash;
-} algorithmData;
+static bool validDual( int index0, int index1 )
+{
+    if ( !validIndex( index0 ) || !validIndex( index1 ) )
+        return false;
+    Algorithm* a0 = algorithmTable[ index0 ]( 0 );
+    Algorithm* a1 = algorithmTable[ index1 ]( 1 );
+    return a0 != a1 && a0->canRunInSlot() && a1->canRunInSlot();
+}
 
-void    algorithm_init(void)
+static int numSlots( const _config* c )
 {
-    memset( &algorithmData, 0, sizeof algorithmData );
-    
-    algorithmData.lastEncSw[0] = true;
-    algorithmData.lastEncSw[1] = true;
-    
-    // peaks.cc Init()
-    peaks::processors[0].Init(0);
-    peaks::processors[1].Init(1);
-
-    // attempt to load state from flash
-    const int* ptr = (const int*)PEAKS_NVM_BASE;
-    if ( ptr[0] == kPeaksMagic )
-    {
-        algorithmData.settings.edit_mode = ptr[1];
-        SetFunction( 0, (peaks::Function)ptr[2] );
-        SetFunction( 1, (peaks::Function)ptr[3] );
-    }
-    else
-    {
-        algorithmData.settings.edit_mode = peaks::EDIT_MODE_TWIN;
-        algorithmData.settings.function[0] = algorithmData.settings.function[1] = peaks::FUNCTION_ENVELOPE;
-    }
+    return c->dual ? kNumAlgorithmSlots : 1;
 }
 
-void    algorithm_step( _algorithm_blocks* blocks, int ping )
+static bool isRunning( const _config* c, const Algorithm* a )
 {
-    int i, j;
+    int s;
+    for ( s=0; s<numSlots( c ); ++s )
+        if ( c->slots[s].algorithm == a )
+            return true;
+    return false;
+}
 
-    unsigned int t0 = __builtin_mfc0( _CP0_COUNT, _CP0_COUNT_SELECT );
-    
-    float inputVoltages[6][k_framesPerBlock];
-    float outputVoltages[4][k_framesPerBlock];
-    
-    // calculate input voltages
-    for ( i=0; i<k_framesPerBlock; ++i )
-    {
-        inputVoltages[0][i] = blocks->in[0][ ping + 2*i + 0 ] * inputCalibrations[0].Brf + inputCalibrations[0].mABrf;
-        inputVoltages[1][i] = blocks->in[0][ ping + 2*i + 1 ] * inputCalibrations[1].Brf + inputCalibrations[1].mABrf;
-        inputVoltages[2][i] = blocks->in[1][ ping + 2*i + 0 ] * inputCalibrations[2].Brf + inputCalibrations[2].mABrf;
-        inputVoltages[3][i] = blocks->in[1][ ping + 2*i + 1 ] * inputCalibrations[3].Brf + inputCalibrations[3].mABrf;
-        inputVoltages[4][i] = blocks->in[2][ ping + 2*i + 1 ] * inputCalibrations[4].Brf + inputCalibrations[4].mABrf;
-        inputVoltages[5][i] = blocks->in[2][ ping + 2*i + 0 ] * inputCalibrations[5].Brf + inputCalibrations[5].mABrf;
-    }
-    
-    // disting EX runs at 96kHz, peaks at 48kHz
-    STATIC_ASSERT( k_framesPerBlock == 2 * peaks::kBlockSize, block_size_error );
-
-    peaks::GateFlags input[2][peaks::kBlockSize];
-    
-    // peaks.cc TIM1_UP_IRQHandler()
-    for ( j=0; j<peaks::kBlockSize; ++j )
+static void releaseSram(void)
+// from the algorithms that aren't running any more
+{
+    int i, s;
+    for ( i=0; i<algorithm_count(); ++i )
     {
-        for ( i=0; i<2; ++i )
+        for ( s=0; s<kNumAlgorithmSlots; ++s )
         {
-            if ( algorithmData.schmittTrigger[i] )
+            Algorithm* a = algorithmTable[i]( s );
+            if ( a->sram && !isRunning( current, a ) )
             {
-                if ( inputVoltages[i][2*j+0] < 0.5f )
-                    algorithmData.schmittTrigger[i] = false;
+                sramReleaseRegion( a->sram );
+                a->sram = NULL;
             }
-            else
-            {
-                if ( inputVoltages[i][2*j+0] > 1.0f )
-                    algorithmData.schmittTrigger[i] = true;
-            }
-        }
-        
-        uint32_t external_gate_inputs = 0;
-        if ( algorithmData.schmittTrigger[0] )
-            external_gate_inputs |= 1;
-        if ( algorithmData.schmittTrigger[1] )
-            external_gate_inputs |= 2;
-        uint32_t buttons = 0;
-        if ( !halfState[0].potSW )
-            buttons |= 1;
-        if ( !halfState[1].potSW )
-            buttons |= 2;
-        uint32_t gate_inputs = external_gate_inputs | buttons;
-
-        for (size_t i = 0; i < 2; ++i) {
-          algorithmData.gate_flags[i] = peaks::ExtractGateFlags(
-              algorithmData.gate_flags[i],
-              gate_inputs & (1 << i));
         }
+    }
+}
 
-        // A hack to make channel 1 aware of what's going on in channel 2. Used to
-        // reset the sequencer.
-        input[0][j] = algorithmData.gate_flags[0] \
-            | (algorithmData.gate_flags[1] << 4) \
-            | (buttons & 1 ? peaks::GATE_FLAG_FROM_BUTTON : 0);
+static int sramRegionsIn( const _config* c, const Algorithm* a )
+// what it asks for, up to its share
+{
+    int n = a->sramRegions();
+    if ( n > kSramRegions / numSlots( c ) )
+        n = kSramRegions / numSlots( c );
+    return n;
+}
 
-        input[1][j] = algorithmData.gate_flags[1] \
-            | (buttons & 2 ? peaks::GATE_FLAG_FROM_BUTTON : 0);
-    }
-    
-    // peaks.cc Process()
-    for ( j=0; j<2; ++j )
+static void claimSram( const _config* c, Algorithm* a )
+// an empty region (or a few), for its init()
+{
+    if ( a->sram )
     {
-        int16_t output_buffer[peaks::kBlockSize];
-        peaks::processors[j].Process( input[j], output_buffer, peaks::kBlockSize );
-        
-        // convert to output voltage with naive sample rate conversion
-        for ( i=0; i<peaks::kBlockSize; ++i )
-        {
-            float v = output_buffer[i] * (8.0f/0x7fff);
-            outputVoltages[j][2*i+0] = v;
-            outputVoltages[j][2*i+1] = v;
-        }
+        sramReset( a->sram );
+        return;
     }
+    int n = sramRegionsIn( c, a );
+    if ( n <= 0 )
+        return;
+    a->sram = sramClaimRegions( a->name(), n );
+}
 
-    // peaks only has two outputs, so do something simple with the others
-    for ( i=0; i<k_framesPerBlock; ++i )
+static bool sramFreeFor( const _config* next, const bool* keep )
+// whether the regions the next config's new algorithms claim are free
+// while the current ones run on, as sramClaimRegions() would find them
+{
+    unsigned int held = 0;
+    int s, i;
+    for ( s=0; s<numSlots( current ); ++s )
     {
-        outputVoltages[2][i] = inputVoltages[2][i] + inputVoltages[4][i];
-        outputVoltages[3][i] = inputVoltages[3][i] + inputVoltages[5][i];
+        const _sramArena* a = current->slots[s].algorithm->sram;
+        if ( a )
+            held |= ( ( 1u << a->regions ) - 1 ) << ( a - sramArenas );
     }
-
-    // calculate output frames
-    for ( i=0; i<k_framesPerBlock; ++i )
+    for ( s=0; s<numSlots( next ); ++s )
     {
-        int c1 = ( (int)( outputVoltages[0][i] * halfState[0].Erf[0] ) ) - halfState[0].Dd[0];
-        int c2 = ( (int)( outputVoltages[1][i] * halfState[0].Erf[1] ) ) - halfState[0].Dd[1];
-        int c3 = ( (int)( outputVoltages[2][i] * halfState[1].Erf[0] ) ) - halfState[1].Dd[0];
-        int c4 = ( (int)( outputVoltages[3][i] * halfState[1].Erf[1] ) ) - halfState[1].Dd[1];
-        CLAMP( c1 );
-        CLAMP( c2 );
-        CLAMP( c3 );
-        CLAMP( c4 );
-        blocks->out[0][ping+2*i+1] = c1;
-        blocks->out[0][ping+2*i+0] = c2;
-        blocks->out[1][ping+2*i+1] = c3;
-        blocks->out[1][ping+2*i+0] = c4;
+        int n = keep[s] ? 0 : sramRegionsIn( next, next->slots[s].algorithm );
+        if ( n <= 0 )
+            continue;
+        unsigned int run = ( 1u << n ) - 1;
+        for ( i=0; i+n<=kSramRegions && ( held & ( run << i ) ); ++i )
+            ;
+        if ( i+n > kSramRegions )
+            return false;
+        held |= run << i;
     }
+    return true;
+}
 
-    // sometimes it's useful to have a measure of CPU load,
-    // and to guarantee a minimum CPU load to avoid issues with the half-DMA interrupt
-    for ( ;; )
-    {
-        unsigned int t1 = __builtin_mfc0( _CP0_COUNT, _CP0_COUNT_SELECT );
-        unsigned int t = t1 - t0;
-        int cpuLoad = ( t * 100 ) / ( ( k_framesPerBlock * (uint64_t)SYS_CLK_FREQ/2 ) / SAMPLE_RATE );
-        if ( cpuLoad > 50 )
-            break;
+static bool canCrossfade( const _config* c )
+// which needs everything in Q8.24
+{
+    int s;
+    for ( s=0; s<numSlots( c ); ++s )
+        if ( !c->slots[s].algorithm->canRunInSlot() )
+            return false;
+    return true;
+}
 
-        int x = time;
-        for ( i=0; i<2; ++i )
-        {
-            int j;
-            for ( j=0; j<200; ++j )
-                x += time;
-        }
-        pageBuffer[0] = x;
-    }
+int     algorithm_count(void)
+{
+    return ARRAY_SIZE( algorithmTable );
 }
 
-// from ui.cc
-const peaks::ProcessorFunction function_table_[peaks::FUNCTION_LAST][2] = {
-  { peaks::PROCESSOR_FUNCTION_ENVELOPE, peaks::PROCESSOR_FUNCTION_ENVELOPE },
-  { peaks::PROCESSOR_FUNCTION_LFO, peaks::PROCESSOR_FUNCTION_LFO },
-  { peaks::PROCESSOR_FUNCTION_TAP_LFO, peaks::PROCESSOR_FUNCTION_TAP_LFO },
-  { peaks::PROCESSOR_FUNCTION_BASS_DRUM, peaks::PROCESSOR_FUNCTION_SNARE_DRUM },
+const char* algorithm_name( int index )
+{
+    if ( !validIndex( index ) )
+        return "";
+    return algorithmTable[ index ]( 0 )->name();
+}
 
-  { peaks::PROCESSOR_FUNCTION_MINI_SEQUENCER, peaks::PROCESSOR_FUNCTION_MINI_SEQUENCER },
-  { peaks::PROCESSOR_FUNCTION_PULSE_SHAPER, peaks::PROCESSOR_FUNCTION_PULSE_SHAPER },
-  { peaks::PROCESSOR_FUNCTION_PULSE_RANDOMIZER, peaks::PROCESSOR_FUNCTION_PULSE_RANDOMIZER },
-  { peaks::PROCESSOR_FUNCTION_FM_DRUM, peaks::PROCESSOR_FUNCTION_FM_DRUM },
-};
+int     algorithm_isDual(void)
+{
+    return current->dual;
+}
 
-// from ui.cc
-void SetFunction(uint8_t index, peaks::Function f) {
-  if (algorithmData.settings.edit_mode == peaks::EDIT_MODE_SPLIT || algorithmData.settings.edit_mode == peaks::EDIT_MODE_TWIN) {
-    algorithmData.settings.function[0] = algorithmData.settings.function[1] = f;
-    peaks::processors[0].set_function(function_table_[f][0]);
-    peaks::processors[1].set_function(function_table_[f][1]);
-  } else {
-    algorithmData.settings.function[index] = f;
-    peaks::processors[index].set_function(function_table_[f][index]);
-  }
+int     algorithm_current(void)
+{
+    return current->slots[0].index;
 }
 
-void    algorithm_UI( const int* enc )
+int     algorithm_currentInSlot( int slot )
 {
-    // left encoder button
-    if ( halfState[0].encSW && !algorithmData.lastEncSw[0] )
-    {
-        if ( algorithmData.holdCounter[0] < SLOW_RATE )
-        {
-            algorithmData.settings.edit_mode ^= 1;
-            algorithmData.writeToFlash = true;
-        }
-    }
-    else if ( !halfState[0].encSW && algorithmData.lastEncSw[0] )
+    if ( slot < 0 || slot >= numSlots( current ) )
+        return kAlgorithmNone;
+    return current->slots[ slot ].index;
+}
+
+int     algorithmSlot( const Algorithm* a )
+{
+    const _config* c = current;
+    return ( c->dual && c->slots[1].algorithm == a ) ? 1 : 0;
+}
+
+void    algorithm_select( int index )
+{
+    if ( !validIndex( index ) )
+        return;
+    _config* c = current;
+    c->dual = false;
+    c->slots[0].index = index;
+    c->slots[0].algorithm = algorithmTable[ index ]( 0 );
+    releaseSram();
+    claimSram( c, c->slots[0].algorithm );
+    c->slots[0].algorithm->init();
+}
+
+int     algorithm_selectDual( int index0, int index1 )
+{
+    if ( !validDual( index0, index1 ) )
+        return -1;
+    _config* c = current;
+    c->dual = true;
+    const int index[kNumAlgorithmSlots] = { index0, index1 };
+    int s;
+    for ( s=0; s<kNumAlgorithmSlots; ++s )
     {
-        algorithmData.holdCounter[0] = 0;
+        c->slots[s].index = index[s];
+        c->slots[s].algorithm = algorithmTable[ index[s] ]( s );
     }
-    if ( !halfState[0].encSW )
+    releaseSram();
+    for ( s=0; s<kNumAlgorithmSlots; ++s )
     {
-        algorithmData.holdCounter[0] += 1;
-        if ( algorithmData.holdCounter[0] == SLOW_RATE )
-        {
-            algorithmData.settings.edit_mode = ( algorithmData.settings.edit_mode & 2 ) ? peaks::EDIT_MODE_TWIN : peaks::EDIT_MODE_FIRST;
-            algorithmData.writeToFlash = true;
-        }
+        claimSram( c, c->slots[s].algorithm );
+        c->slots[s].algorithm->init();
     }
-    algorithmData.lastEncSw[0] = halfState[0].encSW;
+    return 0;
+}
+
+int     requestAlgorithm( int index )
+{
+    if ( !validIndex( index ) )
+        return -1;
+    request.dual = false;
+    request.index[0] = index;
+    request.pending = true;
+    return 0;
+}
+
+int     requestDualAlgorithms( int index0, int index1 )
+{
+    if ( !validDual( index0, index1 ) )
+        return -1;
+    request.dual = true;
+    request.index[0] = index0;
+    request.index[1] = index1;
+    request.pending = true;
+    return 0;
+}
+
+int     requestDualAlgorithm( int slot, int index )
+// the other slot keeps its algorithm
+{
+    if ( slot < 0 || slot >= kNumAlgorithmSlots )
+        return -1;
+    int index0 = slot ? current->slots[0].index : index;
+    int index1 = slot ? index : current->slots[1].index;
+    return requestDualAlgorithms( index0, index1 );
+}
 
-    // right encoder button
-    uint8_t f = algorithmData.settings.edit_mode == peaks::EDIT_MODE_SECOND ? algorithmData.settings.function[1] : algorithmData.settings.function[0];
-    if ( halfState[1].encSW && !algorithmData.lastEncSw[1] )
+void    algorithm_setCrossfadeBlocks( int blocks )
+{
+    APPLY_RANGE( blocks, 0, kMaxCrossfadeBlocks );
+    crossfadeBlocks = blocks;
+}
+
+int     algorithm_crossfadeBlocks(void)
+{
+    return crossfadeBlocks;
+}
+
+static _config* requestedConfig(void)
+// in whichever config the audio isn't running
+{
+    _config* c = ( current == &configs[0] ) ? &configs[1] : &configs[0];
+    c->dual = request.dual;
+    c->slots[1] = current->slots[1];
+    int s;
+    for ( s=0; s<numSlots( c ); ++s )
     {
-        if ( algorithmData.holdCounter[1] < SLOW_RATE )
-        {
-            f = ( f & 4 ) | ( ( ( f & 3 ) + 1 ) & 3 );
-            SetFunction( algorithmData.settings.edit_mode - peaks::EDIT_MODE_FIRST, (peaks::Function)f );
-            algorithmData.writeToFlash = true;
-        }
+        c->slots[s].index = request.index[s];
+        c->slots[s].algorithm = algorithmTable[ request.index[s] ]( s );
     }
-    else if ( !halfState[1].encSW && algorithmData.lastEncSw[1] )
+    return c;
+}
+
+static bool canSwitchInBackground( const _config* next, bool* keep )
+// an algorithm can only be initialised while the old ones run if it's not
+// one of them - unless it's staying put in the dual mode, when it carries on -
+// and if the old ones aren't holding the SRAM it needs (such as a looper
+// with all of it, going to the dual mode with another looper)
+{
+    const _config* c = current;
+    int s;
+    for ( s=0; s<numSlots( next ); ++s )
     {
-        algorithmData.holdCounter[1] = 0;
+        Algorithm* a = next->slots[s].algorithm;
+        keep[s] = next->dual && c->dual && c->slots[s].algorithm == a;
+        if ( !keep[s] && isRunning( c, a ) )
+            return false;
     }
-    if ( !halfState[1].encSW )
+    return sramFreeFor( next, keep );
+}
+
+int     algorithmSwitchNeedsStop(void)
+{
+    if ( !request.pending || algorithmSwitch.state != kSwitchIdle )
+        return 0;
+    bool keep[kNumAlgorithmSlots];
+    return !canSwitchInBackground( requestedConfig(), keep );
+}
+
+void    algorithmApplyRequest(void)
+// with the audio stopped
+{
+    request.pending = false;
+    // before anything's claimed, so it has its regions back
+    sramTestStop();
+    if ( request.dual )
+        algorithm_selectDual( request.index[0], request.index[1] );
+    else
+        algorithm_select( request.index[0] );
+}
+
+void    algorithmSwitchService(void)
+{
+    switch ( algorithmSwitch.state )
     {
-        algorithmData.holdCounter[1] += 1;
-        if ( algorithmData.holdCounter[1] == SLOW_RATE )
+        case kSwitchIdle:
         {
-            SetFunction( algorithmData.settings.edit_mode - peaks::EDIT_MODE_FIRST, (peaks::Function)( f ^ 4 ) );
-            algorithmData.writeToFlash = true;
+            if ( !request.pending )
+                break;
+            _config* next = requestedConfig();
+            bool keep[kNumAlgorithmSlots] = { false, false };
+            if ( !canSwitchInBackground( next, keep ) )
+                break;
+            request.pending = false;
+            sramTestStop();
+            // the regions of those replaced last time round
+            releaseSram();
+            algorithmSwitch.next = next;
+            algorithmSwitch.keep[0] = keep[0];
+            algorithmSwitch.keep[1] = keep[1];
+            algorithmSwitch.slot = 0;
+            algorithmSwitch.step = 0;
+            algorithmSwitch.state = kSwitchInitialising;
+            break;
         }
-    }
-    algorithmData.lastEncSw[1] = halfState[1].encSW;
-    
-    // encoders (peaks itself has pots)
-    int i;
-    for ( i=0; i<2; ++i )
-    {
-        if ( enc[i] )
+        case kSwitchInitialising:
         {
-            static const int kEncoderScale = 1000;
-            algorithmData.encoderValue[i] += kEncoderScale * enc[i];
-            APPLY_RANGE( algorithmData.encoderValue[i], 0, 65535 );
-            switch ( algorithmData.settings.edit_mode )
+            // one step each time round
+            _config* next = algorithmSwitch.next;
+            int s = algorithmSwitch.slot;
+            while ( s < numSlots( next ) && algorithmSwitch.keep[s] )
+                s += 1;
+            if ( s < numSlots( next ) )
             {
-                case peaks::EDIT_MODE_TWIN:
-                    peaks::processors[0].set_parameter(i, algorithmData.encoderValue[i]);
-                    peaks::processors[1].set_parameter(i, algorithmData.encoderValue[i]);
-                    algorithmData.processorParams[0][i] = algorithmData.encoderValue[i];
-                    algorithmData.processorParams[1][i] = algorithmData.encoderValue[i];
-                    break;
-                case peaks::EDIT_MODE_SPLIT:
-                    peaks::processors[0].set_parameter(i, algorithmData.encoderValue[i]);
-                    algorithmData.processorParams[0][i] = algorithmData.encoderValue[i];
-                    break;
-                case peaks::EDIT_MODE_FIRST:
-                case peaks::EDIT_MODE_SECOND:
+                if ( !algorithmSwitch.step )
+                    claimSram( next, next->slots[s].algorithm );
+                if ( next->slots[s].algorithm->initStep( algorithmSwitch.step ) )
                 {
-                    int which = algorithmData.settings.edit_mode - peaks::EDIT_MODE_FIRST;
-                    int v = algorithmData.processorParams[which][i] + kEncoderScale * enc[i];
-                    APPLY_RANGE( v, 0, 65535 );
-                    peaks::processors[ which ].set_parameter( i, v );
-                    algorithmData.processorParams[which][i] = v;
+                    algorithmSwitch.slot = s + 1;
+                    algorithmSwitch.step = 0;
                 }
-                    break;
+                else
+                {
+                    algorithmSwitch.slot = s;
+                    algorithmSwitch.step += 1;
+                }
+                break;
             }
+            // over to the audio
+            algorithmSwitch.block = 0;
+            algorithmSwitch.blocks = ( canCrossfade( current ) && canCrossfade( next ) ) ? crossfadeBlocks : 0;
+            algorithmSwitch.state = kSwitchCrossfading;
+            break;
         }
+        case kSwitchCrossfading:
+            // which the audio finishes
+            break;
     }
-    
-    // pots
-    int pot[2] = { adcs.Z[0].value << 1, adcs.Z[1].value << 1 };
-    for ( i=0; i<2; ++i )
+}
+
+int     algorithmSwitching(void)
+{
+    return request.pending || algorithmSwitch.state != kSwitchIdle;
+}
+
+void    algorithm_init(void)
+{
+    if ( current->dual )
+        algorithm_selectDual( current->slots[0].index, current->slots[1].index );
+    else
+        algorithm_select( current->slots[0].index );
+}
+
+static void stepConfig( const _config* c, const bool* skip, int outputs[4][k_maxFramesPerBlock], bool measure )
+// the config's algorithms on the input planes, except any skipped
+{
+    static const int silence[k_maxFramesPerBlock] = { 0 };
+    static int discard[k_maxFramesPerBlock];
+
+    int s, i;
+    if ( !c->dual )
+    {
+        const int* const in[6] = { inputPlanes[0], inputPlanes[1], inputPlanes[2], inputPlanes[3], inputPlanes[4], inputPlanes[5] };
+        int* const out[4] = { outputs[0], outputs[1], outputs[2], outputs[3] };
+#ifdef DISTING_HOST
+        algorithmDispatches += 1;
+#endif
+        c->slots[0].algorithm->stepRouted( in, out );
+        return;
+    }
+    for ( s=0; s<kNumAlgorithmSlots; ++s )
     {
-        // this is pretty basic pot handling
-        // ideally there would be smoothing, 
-        // and the threshold for movement would be adaptive
-        // like in the actual peaks code
-        int delta = pot[i] - algorithmData.potValue[i];
-        if ( delta < 0 )
-            delta = -delta;
-        if ( delta < 1024 )
+        if ( skip && skip[s] )
             continue;
-        algorithmData.potValue[i] = pot[i];
-        switch ( algorithmData.settings.edit_mode )
+        const _algorithmRouting* r = &algorithmRouting[s];
+        const int* in[6];
+        int* out[4];
+        for ( i=0; i<6; ++i )
+            in[i] = r->input[i] < 6 ? inputPlanes[ r->input[i] ] : silence;
+        for ( i=0; i<4; ++i )
+            out[i] = r->output[i] < 4 ? outputs[ r->output[i] ] : discard;
+
+        unsigned int t0 = cpuLoadTicks();
+#ifdef DISTING_HOST
+        algorithmDispatches += 1;
+#endif
+        c->slots[s].algorithm->stepRouted( in, out );
+        if ( measure )
+            cpuLoadMeasureSlot( s, cpuLoadTicks() - t0 );
+    }
+}
+
+static void stepDual( const _config* c, _algorithm_blocks* blocks, int ping )
+{
+    convertInputs( blocks, ping, framesPerBlock, inputPlanes );
+    memset( outputPlanes[0], 0, sizeof outputPlanes[0] );
+    stepConfig( c, NULL, outputPlanes[0], true );
+    convertOutputs( outputPlanes[0], blocks, ping, framesPerBlock );
+}
+
+static void stepCrossfade( _algorithm_blocks* blocks, int ping )
+{
+    const _config* from = current;
+    const _config* to = algorithmSwitch.next;
+    const bool keep[kNumAlgorithmSlots] = { algorithmSwitch.keep[0], algorithmSwitch.keep[1] };
+    int (*fromOutputs)[k_maxFramesPerBlock] = outputPlanes[0];
+    int (*toOutputs)[k_maxFramesPerBlock] = outputPlanes[1];
+    int frames = framesPerBlock;
+    int i, j, s;
+
+    convertInputs( blocks, ping, frames, inputPlanes );
+    memset( outputPlanes, 0, sizeof outputPlanes );
+
+    // the algorithms in both only run once, so their outputs are
+    // copied across to fade into themselves
+    stepConfig( from, keep, fromOutputs, false );
+    stepConfig( to, NULL, toOutputs, true );
+    for ( s=0; s<kNumAlgorithmSlots; ++s )
+    {
+        if ( !keep[s] )
+            continue;
+        for ( j=0; j<4; ++j )
         {
-            case peaks::EDIT_MODE_TWIN:
-                peaks::processors[0].set_parameter(2+i, pot[i]);
-                peaks::processors[1].set_parameter(2+i, pot[i]);
-                algorithmData.processorParams[0][2+i] = pot[i];
-                algorithmData.processorParams[1][2+i] = pot[i];
-                break;
-            case peaks::EDIT_MODE_SPLIT:
-                peaks::processors[1].set_parameter(i, pot[i]);
-                algorithmData.processorParams[1][i] = pot[i];
-                break;
-            case peaks::EDIT_MODE_FIRST:
-            case peaks::EDIT_MODE_SECOND:
-            {
-                int which = algorithmData.settings.edit_mode - peaks::EDIT_MODE_FIRST;
-                peaks::processors[ which ].set_parameter( 2+i, pot[i] );
-                algorithmData.processorParams[which][2+i] = pot[i];
-            }
-                break;
+            int ch = algorithmRouting[s].output[j];
+            if ( ch < 4 )
+                memcpy( fromOutputs[ch], toOutputs[ch], frames * sizeof(int) );
+        }
+    }
+
+    // linear, across all the blocks
+    int gainStep = kQ24One / ( algorithmSwitch.blocks * frames );
+    int gain = algorithmSwitch.block * frames * gainStep;
+    for ( i=0; i<frames; ++i )
+    {
+        for ( j=0; j<4; ++j )
+            fromOutputs[j][i] += ( (int64_t)( toOutputs[j][i] - fromOutputs[j][i] ) * gain ) >> 24;
+        gain += gainStep;
+    }
+
+    convertOutputs( fromOutputs, blocks, ping, frames );
+}
+
+void    algorithm_step( _algorithm_blocks* blocks, int ping )
+{
+    if ( algorithmSwitch.state == kSwitchCrossfading )
+    {
+        if ( algorithmSwitch.block < algorithmSwitch.blocks )
+        {
+            stepCrossfade( blocks, ping );
+            algorithmSwitch.block += 1;
+            return;
         }
+        // done, and the next block is the new config's alone
+        current = algorithmSwitch.next;
+        algorithmSwitch.state = kSwitchIdle;
+    }
+
+    const _config* c = current;
+    if ( c->dual )
+        stepDual( c, blocks, ping );
+    else
+    {
+#ifdef DISTING_HOST
+        algorithmDispatches += 1;
+#endif
+        c->slots[0].algorithm->step( blocks, ping );
     }
 }
 
 void    algorithm_idle(void)
 {
-    if ( algorithmData.writeToFlash )
+    const _config* c = current;
+    int s;
+    for ( s=0; s<numSlots( c ); ++s )
+        c->slots[s].algorithm->idle();
+}
+
+void    algorithm_UI( const int* enc )
+{
+    const _config* c = current;
+    if ( !c->dual )
     {
-        algorithmData.writeToFlash = false;
-        
-        // erase page
-        NVMADDR = PEAKS_NVM_BASE & 0x1FFFFFFF;
-        NVMOpWithAudioService( 0x4004 );
-        
-        // prepare data
-        int* ptr = (int*)pageBuffer;
-        ptr[0] = kPeaksMagic;
-        ptr[1] = algorithmData.settings.edit_mode;
-        ptr[2] = algorithmData.settings.function[0];
-        ptr[3] = algorithmData.settings.function[1];
-    
-        // write row
-        NVMSRCADDR = (unsigned int)pageBuffer & 0x1FFFFFFF;
-        NVMADDR = ( PEAKS_NVM_BASE & 0x1FFFFFFF );
-        NVMOpWithAudioService( 0x4003 );
+        c->slots[0].algorithm->UI( enc );
+        return;
+    }
+    // each slot only sees its own half's encoder
+    int s;
+    for ( s=0; s<kNumAlgorithmSlots; ++s )
+    {
+        int e[2] = { 0, 0 };
+        e[s] = enc[s];
+        c->slots[s].algorithm->UI( e );
     }
 }
 
+void    algorithm_looperClear(void)
+{
+    const _config* c = current;
+    int s;
+    for ( s=0; s<numSlots( c ); ++s )
+        c->slots[s].algorithm->looperClear();
+}
+
+int     algorithm_looperState( int loop )
+{
+    const _config* c = current;
+    if ( loop < 0 || loop >= numSlots( c ) )
+        return -1;
+    return c->slots[loop].algorithm->looperState();
+}
+
 void    algorithm_display(void)
 {
-    static char const * const editModeStrings[] = {
-        "TWIN",
-        "SPLIT",
-        "EXPERT 1",
-        "EXPERT 2",
-    };
-    drawString88( 0, 0, editModeStrings[ algorithmData.settings.edit_mode ] );
-
-    static char const * const functionStrings[] = {
-        "ENVELOPE",
-        "LFO",
-        "TAP_LFO",
-        "BASSDRUM",
-        "SNARE",
-        "HIGHHAT",
-        "FM DRUM",
-        "SHAPER",
-        "RANDOMIZ",
-        "BOUNCING",
-        "MINISEQ",
-        "NUMBERS",
-    };
-
-    char buff[8];
-    int i;
-    for ( i=0; i<2; ++i )
+    const _config* c = current;
+    if ( !c->dual )
     {
-        drawString88( 64, i*8, functionStrings[ peaks::processors[i].function() ] );
-        
-        int j;
-        for ( j=0; j<4; ++j )
-        {
-            sprintf( buff, "%04X", algorithmData.processorParams[i][j] );
-            drawString88( j*32, 16+i*8, buff );
-        }
+        c->slots[0].algorithm->display();
+        return;
+    }
+    int s;
+    for ( s=0; s<kNumAlgorithmSlots; ++s )
+    {
+        // with the two columns at the right kept for the budget
+        int x = s * 64;
+        setDisplayWindow( x, 62 );
+        c->slots[s].algorithm->display();
+
+        // the slot's load along the bottom, against its budget at the right
+        unsigned int load = slotLoads[s].current;
+        if ( load > 1000 )
+            load = 1000;
+        int w = ( load * 62 ) / 1000;
+        if ( w )
+            orScreen( x, x + w - 1, 0x80000000 );
+        orScreen( x + 62, x + 62, 0xe0000000 );
     }
+    setDisplayWindow( 0, 128 );
 }
@@ -32,16 +32,24 @@ extern "C" {
 #endif
 
 // disting EX runs at 96kHz, peaks at 48kHz
-enum { k_framesPerBlock = 2 * 4 };
+// the block size is chosen at runtime, from powers of two in this range
+enum { k_minFramesPerBlock = 2 * 4 };
+enum { k_maxFramesPerBlock = 64 };
+
+extern int framesPerBlock;
 
 typedef union {
     int     f[1];
     struct {
-        int     in[3][2*k_framesPerBlock*2];         // double buffered & stereo
-        int     out[3][2*k_framesPerBlock*2];
+        int     in[3][2*k_maxFramesPerBlock*2];         // double buffered & stereo
+        int     out[3][2*k_maxFramesPerBlock*2];
     };
 } _algorithm_blocks;
 
+int     requestFramesPerBlock( int frames );
+
+// these act on the current algorithm, or both in the dual mode
+// (see algorithm_base.h)
 void    algorithm_init(void);
 void    algorithm_step( _algorithm_blocks* blocks, int ping );
 void    algorithm_idle(void);
@@ -49,6 +57,77 @@ void    algorithm_idle(void);
 void    algorithm_UI( const int* enc );
 void    algorithm_display(void);
 
+// for an algorithm with a looper (see algorithm_looper.cc), of which there's
+// one in each slot it's running in - its state, or -1 if there isn't one
+void    algorithm_looperClear(void);
+int     algorithm_looperState( int loop );
+
+// the table of algorithms
+int     algorithm_count(void);
+const char* algorithm_name( int index );
+
+// in the dual mode, an algorithm runs in each half of the module (slot),
+// on that half's inputs and outputs, and with its own CPU budget
+enum { kNumAlgorithmSlots = 2 };
+
+// where a slot's algorithm inputs and outputs go, as module channels
+// (0-5 for the inputs, 0-3 for the outputs), or kRouteNone
+enum { kRouteNone = 0xff };
+
+typedef struct {
+    BYTE    input[6];
+    BYTE    output[4];
+} _algorithmRouting;
+
+extern _algorithmRouting algorithmRouting[kNumAlgorithmSlots];
+
+int     algorithm_isDual(void);
+int     algorithm_current(void);
+// the algorithm in a slot, or kAlgorithmNone for slot 1 outside the
+// dual mode (or a slot that doesn't exist)
+enum { kAlgorithmNone = 0xff };
+int     algorithm_currentInSlot( int slot );
+
+// make the algorithm(s) current, and initialise them
+void    algorithm_select( int index );
+int     algorithm_selectDual( int index0, int index1 );
+
+// these take effect the next time the foreground gets round to it
+// and return 0, or -1 if there's no such algorithm (or it can't run
+// in that slot)
+int     requestAlgorithm( int index );
+int     requestDualAlgorithms( int index0, int index1 );
+int     requestDualAlgorithm( int slot, int index );
+
+// A requested change is made without stopping the audio. The foreground
+// calls algorithmSwitchService() as often as it can, and each call
+// initialises the new algorithm(s) a step at a time (see initStep() in
+// algorithm_base.h) while the old ones keep running. The audio then
+// crossfades from the old to the new over the given number of blocks,
+// or cuts straight over if it's 0 or an algorithm isn't in Q8.24.
+//
+// Reloading the current algorithm, or moving one that has a single
+// instance (such as Peaks) in or out of the dual mode, can't be done
+// while it's running, nor can starting one whose SRAM the old ones are
+// holding (see sram.h). Then algorithmSwitchNeedsStop() returns 1, and
+// the foreground stops the audio and calls algorithmApplyRequest() instead.
+enum { kDefaultCrossfadeBlocks = 128 };
+enum { kMaxCrossfadeBlocks = 0x3fff };
+
+void    algorithm_setCrossfadeBlocks( int blocks );
+int     algorithm_crossfadeBlocks(void);
+
+void    algorithmSwitchService(void);
+int     algorithmSwitching(void);
+int     algorithmSwitchNeedsStop(void);
+void    algorithmApplyRequest(void);
+
+#ifdef DISTING_HOST
+// calls into the algorithms' step() and stepRouted(), which the renderer
+// checks against the algorithms running in each block
+extern unsigned int algorithmDispatches;
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,121 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef _ALGORITHM_BASE_H    /* Guard against multiple inclusion */
+#define _ALGORITHM_BASE_H
+
+#include "algorithm.h"
+#include "convert.h"
+#include "sram.h"
+
+// The interface that each algorithm implements, in C++.
+// algorithm.cc keeps the table of algorithms, and implements the C
+// algorithm_*() functions on whichever is current.
+//
+// step() (or stepRouted(), in the dual mode) is the only call the audio
+// makes, once per block. Anything finer grained (per sample or per
+// channel) must be resolved statically, which AlgorithmQ24 does with CRTP.
+
+class Algorithm
+{
+public:
+    virtual const char* name() const = 0;
+
+    virtual void    init() = 0;
+
+    // init() in pieces, so that it can run in the foreground while
+    // another algorithm is running (see algorithmSwitchService()).
+    // Called with step 0, 1, 2... until it returns true.
+    virtual bool    initStep( int step ) { init(); return true; }
+
+    virtual void    step( _algorithm_blocks* blocks, int ping ) = 0;
+
+    // for the dual mode, calibrated Q8.24 volts in and out, routed
+    // for the slot (see algorithmRouting), framesPerBlock of each
+    virtual bool    canRunInSlot() const { return false; }
+    virtual void    stepRouted( const int* const* inputs, int* const* outputs ) {}
+
+    virtual void    idle() {}
+    virtual void    UI( const int* enc ) {}
+
+    // draws in the display window (see display.h),
+    // which is half the screen in the dual mode
+    virtual void    display() {}
+
+    // its region of the external SRAM (see sram.h), reset before init()
+    // or initStep( 0 ), for buffers too big for the internal RAM.
+    // It's given up to sramRegions() adjacent regions, if they're free,
+    // and at most its share of them in the dual mode - or none, and sram
+    // stays NULL, if it doesn't ask for any.
+    virtual int     sramRegions() const { return 0; }
+    _sramArena*     sram;
+
+    // for kI2C_Looper_clear and kI2C_Looper_get_state, if it has a looper
+    virtual void    looperClear() {}
+    virtual int     looperState() const { return -1; }
+};
+
+// For algorithms working in fixed point. T implements
+//
+//  void stepQ24( const int* const* inputs, int* const* outputs );
+//
+// which is given six input and four output planes of calibrated Q8.24
+// volts, framesPerBlock of each (see convert.h), and which is called
+// directly, not through the vtable. Such algorithms can run in either
+// slot of the dual mode.
+
+template < class T >
+class AlgorithmQ24 : public Algorithm
+{
+public:
+    virtual void    step( _algorithm_blocks* blocks, int ping )
+    {
+        int inputs[6][k_maxFramesPerBlock];
+        int outputs[4][k_maxFramesPerBlock];
+        const int* const in[6] = { inputs[0], inputs[1], inputs[2], inputs[3], inputs[4], inputs[5] };
+        int* const out[4] = { outputs[0], outputs[1], outputs[2], outputs[3] };
+        convertInputs( blocks, ping, framesPerBlock, inputs );
+        static_cast< T* >( this )->stepQ24( in, out );
+        convertOutputs( outputs, blocks, ping, framesPerBlock );
+    }
+
+    virtual bool    canRunInSlot() const { return true; }
+    virtual void    stepRouted( const int* const* inputs, int* const* outputs )
+    {
+        static_cast< T* >( this )->stepQ24( inputs, outputs );
+    }
+};
+
+// The algorithms, for the table in algorithm.cc, by slot (0 outside the
+// dual mode). An algorithm that can only have one instance returns the
+// same one for both slots, and so can't be in both at once.
+Algorithm*  peaksAlgorithm( int slot );
+Algorithm*  thruAlgorithm( int slot );
+Algorithm*  looperAlgorithm( int slot );
+
+// the slot the algorithm is running in, or 0 outside the dual mode - for
+// one with a single instance, which can be in either
+int         algorithmSlot( const Algorithm* a );
+
+#endif /* _ALGORITHM_BASE_H */
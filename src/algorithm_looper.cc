@@ -0,0 +1,462 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+
+#include "algorithm_base.h"
+#include "display.h"
+
+// A stereo delay of up to 8 taps, which can also record a loop and play
+// it back, in the external SRAM - up to 21s at 96kHz with all of it, or
+// half that each in the dual mode.
+//
+// Algorithm inputs 1 and 2 in, outputs 1 and 2 out. The encoder sets the
+// delay (or turned while held, the number of taps), and the pots the
+// feedback and the level of the taps. A press of the encoder button or a
+// gate on input 3 moves the looper on - record, play, overdub, play...
+// and holding the button (or kI2C_Looper_clear) clears it, back to the delay.
+//
+// The audio is kept as a word per frame, of two 16 bit samples (the Q8.24
+// volts >> 13, so 0.5mV steps). Each block, the write head and each tap
+// move on by a whole block, so each is a run of consecutive words (or two,
+// where it wraps), which is copied to or from the internal RAM in EBI
+// pages (see sramBurstRead()) through the uncached view.
+
+enum { kLooperMaxTaps = 8 };
+
+enum {
+    kLooperDelay,               // no loop - the buffer is a delay line
+    kLooperRecording,
+    kLooperPlaying,
+    kLooperOverdubbing,
+};
+
+enum { kSampleShift = 13 };
+
+class LooperAlgorithm : public AlgorithmQ24< LooperAlgorithm >
+{
+public:
+    LooperAlgorithm( int s ) : slot( s ) {}
+
+    virtual const char* name() const { return "Looper"; }
+    virtual int     sramRegions() const { return kSramRegions; }
+
+    virtual void    init();
+    void            stepQ24( const int* const* inputs, int* const* outputs );
+
+    virtual void    UI( const int* enc );
+    virtual void    display();
+
+    virtual void    looperClear() { clears += 1; }
+    virtual int     looperState() const { return state; }
+
+private:
+    void            readRun( int from, unsigned int* dst, int n ) const;
+    void            writeRun( int from, const unsigned int* src, int n );
+    void            trigger();
+
+    const int       slot;           // whose half's controls it reads in dual mode
+    unsigned int*   buffer;         // uncached, or NULL without the SRAM
+    int             capacity;       // frames
+    int             length;         // of the loop, or the capacity
+    int             write;          // the frame the next block goes to
+    int             written;        // frames, since the delay line was empty
+    volatile BYTE   state;
+
+    // from the foreground
+    volatile int    delay;          // frames, of the last tap
+    volatile BYTE   taps;
+    volatile BYTE   triggers, clears;
+    BYTE            triggersTaken, clearsTaken;
+
+    // where each tap is reading, and its level (Q15)
+    int             tapDelay[kLooperMaxTaps];
+    int             tapLevel[kLooperMaxTaps];
+
+    bool            gate;
+    BYTE            lastEncSw;
+    bool            turned;
+    int             holdCounter;
+};
+
+// one for each slot
+static LooperAlgorithm theLooperAlgorithms[kNumAlgorithmSlots] = { 0, 1 };
+
+Algorithm*  looperAlgorithm( int slot )
+{
+    return &theLooperAlgorithms[ slot ];
+}
+
+static inline unsigned int pack( int l, int r )
+{
+    l >>= kSampleShift;
+    r >>= kSampleShift;
+    APPLY_RANGE( l, -0x8000, 0x7fff );
+    APPLY_RANGE( r, -0x8000, 0x7fff );
+    return ( l & 0xffff ) | ( r << 16 );
+}
+
+static inline int left( unsigned int w )
+{
+    return (short)w;
+}
+
+static inline int right( unsigned int w )
+{
+    return (int)w >> 16;
+}
+
+void    LooperAlgorithm::init()
+{
+    buffer = NULL;
+    capacity = 0;
+    if ( sram )
+    {
+        capacity = ( ( sram->size - sram->used - kSramPageBytes ) / 4 ) & ~( k_maxFramesPerBlock - 1 );
+        void* p = sramAlloc( sram, capacity * 4, kSramPageBytes );
+        if ( p && capacity > 2 * k_maxFramesPerBlock )
+            buffer = (unsigned int*)sramUncached( p );
+    }
+    length = capacity;
+    write = 0;
+    written = 0;
+    state = kLooperDelay;
+    delay = SAMPLE_RATE / 2;
+    if ( delay > capacity - k_maxFramesPerBlock )
+        delay = capacity - k_maxFramesPerBlock;
+    taps = 1;
+    triggersTaken = triggers;
+    clearsTaken = clears;
+    memset( tapDelay, 0, sizeof tapDelay );
+    memset( tapLevel, 0, sizeof tapLevel );
+    gate = false;
+    lastEncSw = 1;
+    turned = false;
+    holdCounter = 0;
+}
+
+void    LooperAlgorithm::readRun( int from, unsigned int* dst, int n ) const
+{
+    while ( n > 0 )
+    {
+        int run = length - from;
+        if ( run > n )
+            run = n;
+        sramBurstRead( dst, buffer + from, run );
+        dst += run;
+        n -= run;
+        from = 0;
+    }
+}
+
+void    LooperAlgorithm::writeRun( int from, const unsigned int* src, int n )
+{
+    while ( n > 0 )
+    {
+        int run = length - from;
+        if ( run > n )
+            run = n;
+        sramBurstWrite( buffer + from, src, run );
+        src += run;
+        n -= run;
+        from = 0;
+    }
+}
+
+void    LooperAlgorithm::trigger()
+{
+    switch ( state )
+    {
+        case kLooperDelay:
+            state = kLooperRecording;
+            length = capacity;
+            write = 0;
+            break;
+        case kLooperRecording:
+            // too short to play back a block at a time
+            if ( write < k_maxFramesPerBlock )
+                break;
+            state = kLooperPlaying;
+            length = write;
+            write = 0;
+            break;
+        case kLooperPlaying:
+            state = kLooperOverdubbing;
+            break;
+        case kLooperOverdubbing:
+            state = kLooperPlaying;
+            break;
+    }
+}
+
+void    LooperAlgorithm::stepQ24( const int* const* inputs, int* const* outputs )
+{
+    const int n = framesPerBlock;
+    int i, t;
+
+    if ( !buffer )
+    {
+        for ( i=0; i<n; ++i )
+        {
+            outputs[0][i] = inputs[0][i];
+            outputs[1][i] = inputs[1][i];
+        }
+        return;
+    }
+
+    // the gate on input 3
+    for ( i=0; i<n; ++i )
+    {
+        bool g = inputs[2][i] > ( gate ? kQ24One/2 : kQ24One );
+        if ( g && !gate )
+            triggers += 1;
+        gate = g;
+    }
+    if ( clears != clearsTaken )
+    {
+        clearsTaken = clears;
+        triggersTaken = triggers;
+        state = kLooperDelay;
+        length = capacity;
+        write = 0;
+        written = 0;
+        memset( tapLevel, 0, sizeof tapLevel );
+    }
+    else if ( triggers != triggersTaken )
+    {
+        triggersTaken = triggers;
+        trigger();
+    }
+
+    unsigned int run[2][k_maxFramesPerBlock];
+    unsigned int out[k_maxFramesPerBlock];
+    int wet[2][k_maxFramesPerBlock];
+    int feedback[2][k_maxFramesPerBlock];
+    memset( wet, 0, sizeof wet );
+    memset( feedback, 0, sizeof feedback );
+
+    int fb = 0;
+    if ( state == kLooperDelay )
+    {
+        // the pots (Q15)
+        int level;
+        if ( algorithm_isDual() )
+        {
+            fb = adcs.Z[slot].value;
+            level = 0x8000;
+        }
+        else
+        {
+            fb = adcs.Z[0].value;
+            level = adcs.Z[1].value;
+        }
+        int d = delay;
+        int nt = taps;
+        for ( t=0; t<kLooperMaxTaps; ++t )
+        {
+            // each tap spaced evenly up to the delay, and quieter than the
+            // last, on a page boundary (as the write head is)
+            int target = ( t < nt ) ? ( level * ( nt - t ) ) / nt : 0;
+            int td = ( ( d * ( t + 1 ) ) / nt ) & ~( kSramPageBytes/4 - 1 );
+            if ( td < n )
+                td = n;
+            // a tap with nothing to fade from goes straight there, and one
+            // into what hasn't been written yet is silent
+            bool feeds = ( t == nt - 1 );
+            if ( !tapLevel[t] )
+                tapDelay[t] = td;
+            bool moving = false;
+            if ( td > written )
+                target = 0;
+            else
+                moving = ( td != tapDelay[t] );
+            if ( tapDelay[t] > written || ( !tapLevel[t] && !target && !feeds ) )
+            {
+                tapDelay[t] = td;
+                tapLevel[t] = 0;
+                continue;
+            }
+
+            int pos = write - tapDelay[t];
+            if ( pos < 0 )
+                pos += length;
+            readRun( pos, run[0], n );
+            if ( moving )
+            {
+                pos = write - td;
+                if ( pos < 0 )
+                    pos += length;
+                readRun( pos, run[1], n );
+            }
+
+            // the level ramps, and a moving tap crossfades, over the block
+            int l0 = tapLevel[t];
+            int dl = ( target - l0 ) / n;
+            for ( i=0; i<n; ++i )
+            {
+                int l = left( run[0][i] );
+                int r = right( run[0][i] );
+                if ( moving )
+                {
+                    l = ( l * ( n - i ) + left( run[1][i] ) * i ) / n;
+                    r = ( r * ( n - i ) + right( run[1][i] ) * i ) / n;
+                }
+                int level = l0 + dl * i;
+                wet[0][i] += ( l * level ) >> ( 15 - kSampleShift );
+                wet[1][i] += ( r * level ) >> ( 15 - kSampleShift );
+                if ( feeds )
+                {
+                    feedback[0][i] = l << kSampleShift;
+                    feedback[1][i] = r << kSampleShift;
+                }
+            }
+            tapDelay[t] = td;
+            tapLevel[t] = target;
+        }
+    }
+    else if ( state != kLooperRecording )
+    {
+        // the loop, at unity
+        readRun( write, run[0], n );
+        for ( i=0; i<n; ++i )
+        {
+            wet[0][i] = left( run[0][i] ) << kSampleShift;
+            wet[1][i] = right( run[0][i] ) << kSampleShift;
+        }
+        memset( tapLevel, 0, sizeof tapLevel );
+    }
+
+    for ( i=0; i<n; ++i )
+    {
+        outputs[0][i] = inputs[0][i] + wet[0][i];
+        outputs[1][i] = inputs[1][i] + wet[1][i];
+    }
+
+    switch ( state )
+    {
+        case kLooperDelay:
+            for ( i=0; i<n; ++i )
+                out[i] = pack( inputs[0][i] + ( ( (int64_t)feedback[0][i] * fb ) >> 15 ),
+                                inputs[1][i] + ( ( (int64_t)feedback[1][i] * fb ) >> 15 ) );
+            writeRun( write, out, n );
+            written += n;
+            if ( written > capacity )
+                written = capacity;
+            break;
+        case kLooperRecording:
+        {
+            int m = n;
+            if ( m > length - write )
+                m = length - write;
+            for ( i=0; i<m; ++i )
+                out[i] = pack( inputs[0][i], inputs[1][i] );
+            writeRun( write, out, m );
+            if ( write + m == length )
+            {
+                // out of room
+                state = kLooperPlaying;
+                write = 0;
+                return;
+            }
+            break;
+        }
+        case kLooperPlaying:
+            break;
+        case kLooperOverdubbing:
+            for ( i=0; i<n; ++i )
+                out[i] = pack( inputs[0][i] + wet[0][i], inputs[1][i] + wet[1][i] );
+            writeRun( write, out, n );
+            break;
+    }
+    write += n;
+    while ( write >= length )
+        write -= length;
+}
+
+void    LooperAlgorithm::UI( const int* enc )
+{
+    BYTE encSw = halfState[slot].encSW;
+    if ( encSw && !lastEncSw )
+    {
+        if ( !turned && holdCounter < SLOW_RATE )
+            triggers += 1;
+    }
+    else if ( !encSw && lastEncSw )
+    {
+        holdCounter = 0;
+        turned = false;
+    }
+    if ( !encSw )
+    {
+        holdCounter += 1;
+        if ( holdCounter == SLOW_RATE && !turned )
+            clears += 1;
+    }
+    lastEncSw = encSw;
+
+    int e = enc[slot];
+    if ( !e )
+        return;
+    if ( !encSw )
+    {
+        // held, for the taps
+        turned = true;
+        int t = taps + e;
+        APPLY_RANGE( t, 1, kLooperMaxTaps );
+        taps = t;
+    }
+    else
+    {
+        // in steps of about 3%, or 1ms
+        int step = delay >> 5;
+        if ( step < SAMPLE_RATE/1000 )
+            step = SAMPLE_RATE/1000;
+        int d = delay + e * step;
+        APPLY_RANGE( d, k_maxFramesPerBlock, capacity - k_maxFramesPerBlock );
+        delay = d;
+    }
+}
+
+void    LooperAlgorithm::display()
+{
+    static const char* const names[] = { "DELAY", "REC", "PLAY", "DUB" };
+    char buff[17];
+    if ( !buffer )
+    {
+        drawString88( 0, 0, "LOOPER" );
+        drawString88( 0, 8, "NO SRAM" );
+        return;
+    }
+    drawString88( 0, 0, names[ state ] );
+    // the delay, or the loop as it stands
+    int frames = ( state == kLooperDelay ) ? delay : ( state == kLooperRecording ) ? write : length;
+    int ms = ( (int64_t)frames * 1000 ) / SAMPLE_RATE;
+    sprintf( buff, "%d.%03ds", ms / 1000, ms % 1000 );
+    drawString88( 0, 8, buff );
+    if ( state == kLooperDelay )
+    {
+        sprintf( buff, "TAPS %d", taps );
+        drawString88( 0, 16, buff );
+    }
+}
@@ -0,0 +1,500 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "algorithm_base.h"
+#include "display.h"
+#include "nvm.h"
+#include "halfband.h"
+#include "smoother.h"
+
+#include "peaks/processors.h"
+#include "peaks/io_buffer.h"
+
+#define PEAKS_DRIVERS_GATE_INPUT_H_
+#define PEAKS_DRIVERS_SWITCHES_H_
+enum { kNumSwitches = 2 };
+struct Switches {};
+#include "peaks/ui.h"
+
+void SetFunction(uint8_t index, peaks::Function f);
+
+#ifndef PEAKS_NVM_BASE
+#define PEAKS_NVM_BASE 0xBD100000
+#endif
+
+enum { kPeaksMagic = 0xbeefbeac };
+
+class PeaksAlgorithm : public AlgorithmQ24< PeaksAlgorithm >
+{
+public:
+    virtual const char* name() const { return "Peaks"; }
+
+    virtual void    init();
+    virtual bool    initStep( int step );
+    void            stepQ24( const int* const* inputs, int* const* outputs );
+
+    virtual void    idle();
+    virtual void    UI( const int* enc );
+    virtual void    display();
+};
+
+static PeaksAlgorithm thePeaksAlgorithm;
+
+// peaks' state is global, so there's only one
+Algorithm*  peaksAlgorithm( int slot )
+{
+    return &thePeaksAlgorithm;
+}
+
+// for the 48kHz <-> 96kHz conversions (see halfband.h)
+enum { kPeaksHalfbandTaps = 23 };
+
+// the parameters are smoothed on their way to the processors (see
+// smoother.h) - the encoders move in big steps, so those ramp over a few
+// UI ticks, and the pots are noisy, so those get a lowpass
+enum { kEncoderRampFrames = 4 * kSlowTimeRatio };
+enum { kPotSmoothingFrames = 2 * kSlowTimeRatio };
+
+struct {
+    peaks::GateFlags    gate_flags[2];
+    bool                schmittTrigger[2];
+    peaks::Settings     settings;
+    bool                lastEncSw[2];
+    int                 holdCounter[2];
+    int                 encoderValue[2];
+    int                 potValue[2];
+    uint16_t            processorParams[2][4];
+    _smoothers          params;                 // 4 * processor + parameter
+    uint16_t            appliedParams[2][4];
+    bool                writeToFlash;
+    _halfband           gateDecimators[2];
+    _halfband           outputInterpolators[2];
+} algorithmData;
+
+static void setParameter( int processor, int parameter, int value )
+{
+    smootherSetTarget( &algorithmData.params, 4 * processor + parameter, value );
+    algorithmData.processorParams[processor][parameter] = value;
+}
+
+void    PeaksAlgorithm::init()
+{
+    int step = 0;
+    while ( !initStep( step ) )
+        step += 1;
+}
+
+bool    PeaksAlgorithm::initStep( int step )
+// the processors' Init()s are the slow part, so they get a step each
+{
+    switch ( step )
+    {
+        case 0:
+            memset( &algorithmData, 0, sizeof algorithmData );
+            
+            algorithmData.lastEncSw[0] = true;
+            algorithmData.lastEncSw[1] = true;
+
+            for ( int i=0; i<2; ++i )
+            {
+                halfbandInit( &algorithmData.gateDecimators[i], kPeaksHalfbandTaps );
+                halfbandInit( &algorithmData.outputInterpolators[i], kPeaksHalfbandTaps );
+            }
+
+            smootherInit( &algorithmData.params, 2 * 4 );
+            for ( int i=0; i<2; ++i )
+            {
+                smootherConfigure( &algorithmData.params, 4*i+0, kSmoothLinear, kEncoderRampFrames );
+                smootherConfigure( &algorithmData.params, 4*i+1, kSmoothLinear, kEncoderRampFrames );
+                smootherConfigure( &algorithmData.params, 4*i+2, kSmoothOnePole, kPotSmoothingFrames );
+                smootherConfigure( &algorithmData.params, 4*i+3, kSmoothOnePole, kPotSmoothingFrames );
+            }
+            return false;
+            
+        // peaks.cc Init()
+        case 1:
+            peaks::processors[0].Init(0);
+            return false;
+        case 2:
+            peaks::processors[1].Init(1);
+            return false;
+    }
+
+    // attempt to load state from flash
+    const int* ptr = (const int*)PEAKS_NVM_BASE;
+    if ( ptr[0] == kPeaksMagic )
+    {
+        algorithmData.settings.edit_mode = ptr[1];
+        SetFunction( 0, (peaks::Function)ptr[2] );
+        SetFunction( 1, (peaks::Function)ptr[3] );
+    }
+    else
+    {
+        algorithmData.settings.edit_mode = peaks::EDIT_MODE_TWIN;
+        algorithmData.settings.function[0] = algorithmData.settings.function[1] = peaks::FUNCTION_ENVELOPE;
+    }
+    return true;
+}
+
+void    PeaksAlgorithm::stepQ24( const int* const* inputs, int* const* outputs )
+{
+    int i, j;
+
+    // disting EX runs at 96kHz, peaks at 48kHz,
+    // so each peaks block covers two of our frames
+    STATIC_ASSERT( k_minFramesPerBlock == 2 * peaks::kBlockSize, block_size_error );
+    STATIC_ASSERT( k_maxFramesPerBlock % ( 2 * peaks::kBlockSize ) == 0, max_block_size_error );
+
+    // decimate the gate inputs to peaks' rate
+    int gateInputs[2][k_maxFramesPerBlock/2];
+    for ( i=0; i<2; ++i )
+        halfbandDecimate( &algorithmData.gateDecimators[i], inputs[i], gateInputs[i], framesPerBlock/2 );
+
+    smootherUpdate( &algorithmData.params, framesPerBlock );
+
+    int s;
+    for ( s=0; s<framesPerBlock; s += 2 * peaks::kBlockSize )
+    {
+        peaks::GateFlags input[2][peaks::kBlockSize];
+
+        // the parameters as at the end of this peaks block
+        for ( j=0; j<2; ++j )
+        {
+            for ( i=0; i<4; ++i )
+            {
+                int v = smootherValueAt( &algorithmData.params, 4*j+i, s + 2 * peaks::kBlockSize - 1, framesPerBlock );
+                if ( v != algorithmData.appliedParams[j][i] )
+                {
+                    peaks::processors[j].set_parameter( i, v );
+                    algorithmData.appliedParams[j][i] = v;
+                }
+            }
+        }
+    
+        // peaks.cc TIM1_UP_IRQHandler()
+        for ( j=0; j<peaks::kBlockSize; ++j )
+        {
+            for ( i=0; i<2; ++i )
+            {
+                if ( algorithmData.schmittTrigger[i] )
+                {
+                    if ( gateInputs[i][s/2+j] < kQ24One/2 )
+                        algorithmData.schmittTrigger[i] = false;
+                }
+                else
+                {
+                    if ( gateInputs[i][s/2+j] > kQ24One )
+                        algorithmData.schmittTrigger[i] = true;
+                }
+            }
+        
+            uint32_t external_gate_inputs = 0;
+            if ( algorithmData.schmittTrigger[0] )
+                external_gate_inputs |= 1;
+            if ( algorithmData.schmittTrigger[1] )
+                external_gate_inputs |= 2;
+            uint32_t buttons = 0;
+            if ( !halfState[0].potSW )
+                buttons |= 1;
+            if ( !halfState[1].potSW )
+                buttons |= 2;
+            uint32_t gate_inputs = external_gate_inputs | buttons;
+
+            for (size_t i = 0; i < 2; ++i) {
+              algorithmData.gate_flags[i] = peaks::ExtractGateFlags(
+                  algorithmData.gate_flags[i],
+                  gate_inputs & (1 << i));
+            }
+
+            // A hack to make channel 1 aware of what's going on in channel 2. Used to
+            // reset the sequencer.
+            input[0][j] = algorithmData.gate_flags[0] \
+                | (algorithmData.gate_flags[1] << 4) \
+                | (buttons & 1 ? peaks::GATE_FLAG_FROM_BUTTON : 0);
+
+            input[1][j] = algorithmData.gate_flags[1] \
+                | (buttons & 2 ? peaks::GATE_FLAG_FROM_BUTTON : 0);
+        }
+    
+        // peaks.cc Process()
+        for ( j=0; j<2; ++j )
+        {
+            int16_t output_buffer[peaks::kBlockSize];
+            peaks::processors[j].Process( input[j], output_buffer, peaks::kBlockSize );
+        
+            // interpolate to our rate, and convert to Q8.24 volts
+            // (peaks' 0x7fff is 8V, so the scale is 2^27/0x7fff = 4096.125)
+            int samples[peaks::kBlockSize];
+            int samples96[2*peaks::kBlockSize];
+            for ( i=0; i<peaks::kBlockSize; ++i )
+                samples[i] = output_buffer[i];
+            halfbandInterpolate( &algorithmData.outputInterpolators[j], samples, samples96, peaks::kBlockSize );
+            for ( i=0; i<2*peaks::kBlockSize; ++i )
+                outputs[j][s+i] = samples96[i] * 4096 + ( samples96[i] >> 3 );
+        }
+    }
+
+    // peaks only has two outputs, so do something simple with the others
+    for ( i=0; i<framesPerBlock; ++i )
+    {
+        outputs[2][i] = inputs[2][i] + inputs[4][i];
+        outputs[3][i] = inputs[3][i] + inputs[5][i];
+    }
+}
+
+// from ui.cc
+const peaks::ProcessorFunction function_table_[peaks::FUNCTION_LAST][2] = {
+  { peaks::PROCESSOR_FUNCTION_ENVELOPE, peaks::PROCESSOR_FUNCTION_ENVELOPE },
+  { peaks::PROCESSOR_FUNCTION_LFO, peaks::PROCESSOR_FUNCTION_LFO },
+  { peaks::PROCESSOR_FUNCTION_TAP_LFO, peaks::PROCESSOR_FUNCTION_TAP_LFO },
+  { peaks::PROCESSOR_FUNCTION_BASS_DRUM, peaks::PROCESSOR_FUNCTION_SNARE_DRUM },
+
+  { peaks::PROCESSOR_FUNCTION_MINI_SEQUENCER, peaks::PROCESSOR_FUNCTION_MINI_SEQUENCER },
+  { peaks::PROCESSOR_FUNCTION_PULSE_SHAPER, peaks::PROCESSOR_FUNCTION_PULSE_SHAPER },
+  { peaks::PROCESSOR_FUNCTION_PULSE_RANDOMIZER, peaks::PROCESSOR_FUNCTION_PULSE_RANDOMIZER },
+  { peaks::PROCESSOR_FUNCTION_FM_DRUM, peaks::PROCESSOR_FUNCTION_FM_DRUM },
+};
+
+// from ui.cc
+void SetFunction(uint8_t index, peaks::Function f) {
+  if (algorithmData.settings.edit_mode == peaks::EDIT_MODE_SPLIT || algorithmData.settings.edit_mode == peaks::EDIT_MODE_TWIN) {
+    algorithmData.settings.function[0] = algorithmData.settings.function[1] = f;
+    peaks::processors[0].set_function(function_table_[f][0]);
+    peaks::processors[1].set_function(function_table_[f][1]);
+  } else {
+    algorithmData.settings.function[index] = f;
+    peaks::processors[index].set_function(function_table_[f][index]);
+  }
+}
+
+static void editModeButton( BYTE sw )
+{
+    if ( sw && !algorithmData.lastEncSw[0] )
+    {
+        if ( algorithmData.holdCounter[0] < SLOW_RATE )
+        {
+            algorithmData.settings.edit_mode ^= 1;
+            algorithmData.writeToFlash = true;
+        }
+    }
+    else if ( !sw && algorithmData.lastEncSw[0] )
+    {
+        algorithmData.holdCounter[0] = 0;
+    }
+    if ( !sw )
+    {
+        algorithmData.holdCounter[0] += 1;
+        if ( algorithmData.holdCounter[0] == SLOW_RATE )
+        {
+            algorithmData.settings.edit_mode = ( algorithmData.settings.edit_mode & 2 ) ? peaks::EDIT_MODE_TWIN : peaks::EDIT_MODE_FIRST;
+            algorithmData.writeToFlash = true;
+        }
+    }
+    algorithmData.lastEncSw[0] = sw;
+}
+
+static void functionButton( BYTE sw )
+{
+    uint8_t f = algorithmData.settings.edit_mode == peaks::EDIT_MODE_SECOND ? algorithmData.settings.function[1] : algorithmData.settings.function[0];
+    if ( sw && !algorithmData.lastEncSw[1] )
+    {
+        if ( algorithmData.holdCounter[1] < SLOW_RATE )
+        {
+            f = ( f & 4 ) | ( ( ( f & 3 ) + 1 ) & 3 );
+            SetFunction( algorithmData.settings.edit_mode - peaks::EDIT_MODE_FIRST, (peaks::Function)f );
+            algorithmData.writeToFlash = true;
+        }
+    }
+    else if ( !sw && algorithmData.lastEncSw[1] )
+    {
+        algorithmData.holdCounter[1] = 0;
+    }
+    if ( !sw )
+    {
+        algorithmData.holdCounter[1] += 1;
+        if ( algorithmData.holdCounter[1] == SLOW_RATE )
+        {
+            SetFunction( algorithmData.settings.edit_mode - peaks::EDIT_MODE_FIRST, (peaks::Function)( f ^ 4 ) );
+            algorithmData.writeToFlash = true;
+        }
+    }
+    algorithmData.lastEncSw[1] = sw;
+}
+
+static void encoder( int i, int enc )
+// peaks itself has pots
+{
+    if ( !enc )
+        return;
+    static const int kEncoderScale = 1000;
+    algorithmData.encoderValue[i] += kEncoderScale * enc;
+    APPLY_RANGE( algorithmData.encoderValue[i], 0, 65535 );
+    switch ( algorithmData.settings.edit_mode )
+    {
+        case peaks::EDIT_MODE_TWIN:
+            setParameter( 0, i, algorithmData.encoderValue[i] );
+            setParameter( 1, i, algorithmData.encoderValue[i] );
+            break;
+        case peaks::EDIT_MODE_SPLIT:
+            setParameter( 0, i, algorithmData.encoderValue[i] );
+            break;
+        case peaks::EDIT_MODE_FIRST:
+        case peaks::EDIT_MODE_SECOND:
+        {
+            int which = algorithmData.settings.edit_mode - peaks::EDIT_MODE_FIRST;
+            int v = algorithmData.processorParams[which][i] + kEncoderScale * enc;
+            APPLY_RANGE( v, 0, 65535 );
+            setParameter( which, i, v );
+        }
+            break;
+    }
+}
+
+static void pot( int i, int value )
+{
+    // this is pretty basic pot handling
+    // (the smoothing is in stepQ24())
+    // ideally the threshold for movement would be adaptive
+    // like in the actual peaks code
+    int delta = value - algorithmData.potValue[i];
+    if ( delta < 0 )
+        delta = -delta;
+    if ( delta < 1024 )
+        return;
+    algorithmData.potValue[i] = value;
+    switch ( algorithmData.settings.edit_mode )
+    {
+        case peaks::EDIT_MODE_TWIN:
+            setParameter( 0, 2+i, value );
+            setParameter( 1, 2+i, value );
+            break;
+        case peaks::EDIT_MODE_SPLIT:
+            setParameter( 1, i, value );
+            break;
+        case peaks::EDIT_MODE_FIRST:
+        case peaks::EDIT_MODE_SECOND:
+        {
+            int which = algorithmData.settings.edit_mode - peaks::EDIT_MODE_FIRST;
+            setParameter( which, 2+i, value );
+        }
+            break;
+    }
+}
+
+void    PeaksAlgorithm::UI( const int* enc )
+{
+    // in the dual mode, only its own half's controls - the encoder button
+    // picks the function, as the right one does otherwise, and the
+    // encoder and pot act as the left ones
+    if ( algorithm_isDual() )
+    {
+        int half = algorithmSlot( this );
+        functionButton( halfState[half].encSW );
+        encoder( 0, enc[half] );
+        pot( 0, adcs.Z[half].value << 1 );
+        return;
+    }
+
+    // left encoder button, then right
+    editModeButton( halfState[0].encSW );
+    functionButton( halfState[1].encSW );
+
+    int i;
+    for ( i=0; i<2; ++i )
+        encoder( i, enc[i] );
+    for ( i=0; i<2; ++i )
+        pot( i, adcs.Z[i].value << 1 );
+}
+
+void    PeaksAlgorithm::idle()
+{
+    if ( algorithmData.writeToFlash )
+    {
+        algorithmData.writeToFlash = false;
+        
+        // erase page
+        NVMADDR = PEAKS_NVM_BASE & 0x1FFFFFFF;
+        NVMOpWithAudioService( 0x4004 );
+        
+        // prepare data
+        int* ptr = (int*)pageBuffer;
+        ptr[0] = kPeaksMagic;
+        ptr[1] = algorithmData.settings.edit_mode;
+        ptr[2] = algorithmData.settings.function[0];
+        ptr[3] = algorithmData.settings.function[1];
+    
+        // write row
+        NVMSRCADDR = (uintptr_t)pageBuffer & 0x1FFFFFFF;
+        NVMADDR = ( PEAKS_NVM_BASE & 0x1FFFFFFF );
+        NVMOpWithAudioService( 0x4003 );
+    }
+}
+
+void    PeaksAlgorithm::display()
+{
+    static char const * const editModeStrings[] = {
+        "TWIN",
+        "SPLIT",
+        "EXPERT 1",
+        "EXPERT 2",
+    };
+    drawString88( 0, 0, editModeStrings[ algorithmData.settings.edit_mode ] );
+
+    static char const * const functionStrings[] = {
+        "ENVELOPE",
+        "LFO",
+        "TAP_LFO",
+        "BASSDRUM",
+        "SNARE",
+        "HIGHHAT",
+        "FM DRUM",
+        "SHAPER",
+        "RANDOMIZ",
+        "BOUNCING",
+        "MINISEQ",
+        "NUMBERS",
+    };
+
+    // sharing the display in dual mode - just the functions
+    if ( displayWindowWidth < 128 )
+    {
+        drawString88( 0, 8, functionStrings[ peaks::processors[0].function() ] );
+        drawString88( 0, 16, functionStrings[ peaks::processors[1].function() ] );
+        return;
+    }
+
+    char buff[8];
+    int i;
+    for ( i=0; i<2; ++i )
+    {
+        drawString88( 64, i*8, functionStrings[ peaks::processors[i].function() ] );
+        
+        int j;
+        for ( j=0; j<4; ++j )
+        {
+            sprintf( buff, "%04X", algorithmData.processorParams[i][j] );
+            drawString88( j*32, 16+i*8, buff );
+        }
+    }
+}
@@ -0,0 +1,89 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+
+#include "algorithm_base.h"
+#include "display.h"
+
+// Inputs 3-6 straight to outputs 1-4, through the calibration,
+// with the input voltages on the display. Handy for checking calibration,
+// and as the simplest example of an algorithm.
+
+class ThruAlgorithm : public AlgorithmQ24< ThruAlgorithm >
+{
+public:
+    virtual const char* name() const { return "Thru"; }
+
+    virtual void    init();
+    void            stepQ24( const int* const* inputs, int* const* outputs );
+
+    virtual void    display();
+
+private:
+    int             lastInputs[4];
+};
+
+static ThruAlgorithm theThruAlgorithms[kNumAlgorithmSlots];
+
+Algorithm*  thruAlgorithm( int slot )
+{
+    return &theThruAlgorithms[ slot ];
+}
+
+void    ThruAlgorithm::init()
+{
+    memset( lastInputs, 0, sizeof lastInputs );
+}
+
+void    ThruAlgorithm::stepQ24( const int* const* inputs, int* const* outputs )
+{
+    int i, j;
+    for ( j=0; j<4; ++j )
+    {
+        for ( i=0; i<framesPerBlock; ++i )
+            outputs[j][i] = inputs[2+j][i];
+        lastInputs[j] = inputs[2+j][0];
+    }
+}
+
+void    ThruAlgorithm::display()
+{
+    drawString88( 0, 0, "THRU" );
+
+    // in two columns, or one if it's sharing the display in dual mode
+    int columns = ( displayWindowWidth < 128 ) ? 1 : 2;
+    char buff[17];
+    int j;
+    for ( j=0; j<4; ++j )
+    {
+        if ( j >= 3 * columns )
+            break;
+        // millivolts
+        int mv = ( (int64_t)lastInputs[j] * 1000 ) >> 24;
+        // and clear of the dual mode's load meter
+        sprintf( buff, ( columns == 1 ) ? "%d%+6d" : "%d %+6d", 3+j, mv );
+        drawString88( ( j % columns ) * 64, 8 + ( j / columns ) * 8, buff );
+    }
+}
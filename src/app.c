@@ -26,6 +26,12 @@ SOFTWARE.
 #include "display.h"
 #include "i2c.h"
 #include "algorithm.h"
+#include "cpuload.h"
+#include "profile.h"
+#include "trace.h"
+#include "scheduler.h"
+#include "sram.h"
+#include "sramtest.h"
 
 #include "peripheral/spi/plib_spi.h"
 #include "peripheral/tmr/plib_tmr.h"
@@ -36,14 +42,22 @@ SOFTWARE.
 #include <math.h>
 #include <stdio.h>
 
-#define VirtToPhys( addr )  ( 0x1FFFFFFF & (UINT32)(addr) )
+#ifdef DISTING_HOST
+#define VirtToUncached( addr )  ( addr )
+#else
+#define VirtToUncached( addr )  ( (void*)( 0xA0000000 | VirtToPhys( addr ) ) )
+#endif
 
 const int magic
 __attribute__((address(0xBD00C370)))
  = 0xbadabef5;
 
 unsigned int time = 0;
-int slowTimeCountdown = kSlowTimeRatio;
+
+int framesPerBlock = k_minFramesPerBlock;
+static volatile int requestedFramesPerBlock = 0;
+static volatile BYTE benchmarkRequested = 0;
+static volatile BYTE sramBenchmarkRequested = 0;
 
 _adcs adcs __attribute__((aligned(16))) = { 0 };
 
@@ -51,7 +65,11 @@ _halfState halfState[2] = { 0 };
 _input_calibration inputCalibrations[6];
 BYTE pageBuffer[0x4000] __attribute__((aligned(16))) __attribute__((coherent)) = { 0 };
 
+#ifdef AUDIO_BUFFERS_CACHED
+_algorithm_blocks blocks  __attribute__((aligned(16))) = { 0 };
+#else
 _algorithm_blocks blocks  __attribute__((aligned(16))) __attribute__((coherent)) = { 0 };
+#endif
 
 // keep these close for cache locality
 short i2cRxQueueRead = -1;
@@ -78,6 +96,8 @@ BYTE doServiceAudio = 0;
 
 APP_DATA appData;
 
+static void addTasks(void);
+
 void delayMs( unsigned int ms )
 {
     while ( ms )
@@ -155,6 +175,8 @@ static inline __attribute__((always_inline)) void readAndTriggerADCs(void)
 void setupAudioDMAs( int framesPerBlock, int* blocks )
 {
     int framesPerDMA = 2 * framesPerBlock;
+    // the buffers are laid out for the largest block size
+    int stride = 2 * 2 * k_maxFramesPerBlock;
     
     // abort DMAs
     DCH6ECONSET = BIT_6;
@@ -167,7 +189,10 @@ void setupAudioDMAs( int framesPerBlock, int* blocks )
         ;
 
     // clear memory
-    memset( blocks, 0, 6 * framesPerDMA * 8 );
+    memset( blocks, 0, 6 * stride * 4 );
+#ifdef AUDIO_BUFFERS_CACHED
+    _pic32_clean_dcache( (uint32_t)blocks, 6 * stride * 4 );
+#endif
 
     // stop SPI which triggers DMA
     SPI6CONCLR = BIT_15;
@@ -175,19 +200,19 @@ void setupAudioDMAs( int framesPerBlock, int* blocks )
     // set up new DMAs
     DCH5DSA = VirtToPhys( blocks );
     DCH5DSIZ = framesPerDMA * 8;
-    blocks += framesPerDMA * 2;
+    blocks += stride;
     DCH6DSA = VirtToPhys( blocks );
     DCH6DSIZ = framesPerDMA * 8;
-    blocks += framesPerDMA * 2;
+    blocks += stride;
     DCH7DSA = VirtToPhys( blocks );
     DCH7DSIZ = framesPerDMA * 8;
-    blocks += framesPerDMA * 2;
+    blocks += stride;
     DCH3SSA = VirtToPhys( blocks );
     DCH3SSIZ = framesPerDMA * 8;
-    blocks += framesPerDMA * 2;
+    blocks += stride;
     DCH0SSA = VirtToPhys( blocks );
     DCH0SSIZ = framesPerDMA * 8;
-    blocks += framesPerDMA * 2;
+    blocks += stride;
     DCH4SSA = VirtToPhys( blocks );
     DCH4SSIZ = framesPerDMA * 8;
     
@@ -258,8 +283,8 @@ void APP_Initialize ( void )
     PLIB_SPI_Disable( SPI_ID_1 );
     PLIB_SPI_BaudRateSet( SPI_ID_1, SYS_CLK_BUS_PERIPHERAL_2, 800000 );    
     SPI1STATCLR = 0x40;
-    // ENHBUF | ON | CKE | MSTEN | DISSDI
-    SPI1CON = 0x18130;
+    // ENHBUF | ON | CKE | MSTEN | DISSDI | STXISEL=3 (for the display DMA)
+    SPI1CON = 0x1813C;
 #endif
     
     // SPI5 - display
@@ -274,8 +299,8 @@ void APP_Initialize ( void )
     // data througput is 128x32x30 bits/second = 122880
     PLIB_SPI_BaudRateSet( SPI_ID_5, SYS_CLK_BUS_PERIPHERAL_2, 800000 );
     SPI5STATCLR = 0x40;
-    // ENHBUF | ON | CKE | MSTEN | DISSDI
-    SPI5CON = 0x18130;
+    // ENHBUF | ON | CKE | MSTEN | DISSDI | STXISEL=3 (for the display DMA)
+    SPI5CON = 0x1813C;
     
     // SPI3 - audio
 
@@ -375,7 +400,7 @@ void APP_Initialize ( void )
     // SSEN | CKP | MODE16 | MODE32 | FRMPOL | ON | ENHBUF | STXISEL=3 | SRXISEL=3;
     SPI6CON = BIT_7 | BIT_6 | BIT_11 | BIT_10 | BIT_29 | BIT_15 | BIT_16 | (3<<2) | (3<<0);
     
-    setupAudioDMAs( k_framesPerBlock, blocks.f );
+    setupAudioDMAs( framesPerBlock, blocks.f );
 
     // UART2 - select
 
@@ -466,6 +491,8 @@ void APP_Initialize ( void )
     configureDisplay2();
 #endif    
 
+    setupDisplayDMAs();
+
     startupSequence();
 
     setDisplayContrast( 128 );
@@ -523,6 +550,7 @@ void __ISR(_UART2_RX_VECTOR, ipl4srs) UART2RXInterruptHandler(void)
                 if ( selectRxQueueRead == selectRxQueueWrite )
                 {
                     // queue overflow
+                    TRACE( kTraceOverflow, kTraceQueueSelectIn );
                 }
                 else
                 {
@@ -544,6 +572,7 @@ void __ISR(_UART4_RX_VECTOR, ipl1srs) UART4RXInterruptHandler(void)
         {
             // byte received
             BYTE data = U4RXREG;
+            TRACE( kTraceMIDIIn, data );
             
             // handle thru
             if ( 0 )
@@ -563,6 +592,7 @@ void __ISR(_UART4_RX_VECTOR, ipl1srs) UART4RXInterruptHandler(void)
             if ( midiRxQueueRead == midiRxQueueWrite )
             {
                 // queue overflow
+                TRACE( kTraceOverflow, kTraceQueueMIDIIn );
             }
             else
             {
@@ -636,8 +666,17 @@ void APP_Tasks ( void )
             {
                 displayMessage4x16( "Non-recoverable", "error - restart", "or proceed", "and run tests" );
             }
+            sramInit();
+#ifdef EVENT_TRACE
+            traceInit();
+#endif
+            addTasks();
             algorithm_init();
+            cpuLoadReset();
             doServiceAudio = 1;
+#ifdef AUDIO_IN_ISR
+            startAudioInterrupt();
+#endif
             displayLoop();
             break;
         }
@@ -650,15 +689,337 @@ void APP_Tasks ( void )
     }
 }
 
+int requestFramesPerBlock( int frames )
+// takes effect the next time the foreground gets round to it
+{
+    if ( frames < k_minFramesPerBlock || frames > k_maxFramesPerBlock || ( frames & ( frames - 1 ) ) )
+        return -1;
+    requestedFramesPerBlock = frames;
+    return 0;
+}
+
+static void checkFramesPerBlock(void)
+{
+    int frames = requestedFramesPerBlock;
+    if ( !frames )
+        return;
+    requestedFramesPerBlock = 0;
+    if ( frames == framesPerBlock )
+        return;
+
+    doServiceAudio = 0;
+#ifdef AUDIO_IN_ISR
+    PLIB_INT_SourceDisable( INT_ID_0, INT_SOURCE_DMA_5 );
+#endif
+
+    framesPerBlock = frames;
+    cpuLoadReset();
+    setupAudioDMAs( framesPerBlock, blocks.f );
+    CLEAR_AUDIO_INTERRUPT();
+
+#ifdef AUDIO_IN_ISR
+    startAudioInterrupt();
+#endif
+    doServiceAudio = 1;
+}
+
+static inline __attribute__((always_inline)) void invalidateAudioInputs( _algorithm_blocks* b, int ping )
+// the DMA has just filled this half, so anything the cache holds for it is stale
+{
+    size_t len = framesPerBlock * 2 * sizeof(int);
+    _pic32_clean_dcache_nowrite( (uint32_t)&b->in[0][ping], len );
+    _pic32_clean_dcache_nowrite( (uint32_t)&b->in[1][ping], len );
+    _pic32_clean_dcache_nowrite( (uint32_t)&b->in[2][ping], len );
+}
+
+static inline __attribute__((always_inline)) void writeBackAudioOutputs( _algorithm_blocks* b, int ping )
+// the DMA reads this half next, straight from memory
+{
+    size_t len = framesPerBlock * 2 * sizeof(int);
+    _pic32_clean_dcache( (uint32_t)&b->out[0][ping], len );
+    _pic32_clean_dcache( (uint32_t)&b->out[1][ping], len );
+    _pic32_clean_dcache( (uint32_t)&b->out[2][ping], len );
+}
+
+static inline __attribute__((always_inline)) void processAudioBlock( int ping )
+{
+    time += framesPerBlock;
+
+#ifdef EVENT_TRACE
+    unsigned int traceStart = cpuLoadTicks();
+#endif
+    PORTBSET = BIT_4;
+
+#ifdef AUDIO_BUFFERS_CACHED
+    invalidateAudioInputs( &blocks, ping );
+#endif
+    PROFILE_BEGIN( kProfileAlgorithmStep );
+    algorithm_step( &blocks, ping );
+    PROFILE_END( kProfileAlgorithmStep );
+#ifdef AUDIO_BUFFERS_CACHED
+    writeBackAudioOutputs( &blocks, ping );
+#endif
+
+    PORTBCLR = BIT_4;
+#ifdef EVENT_TRACE
+    TRACE( kTraceAudioBlock, cpuLoadTicks() - traceStart );
+#endif
+}
+
+void requestAudioBufferBenchmark(void)
+{
+    benchmarkRequested = 1;
+}
+
+void requestSRAMBenchmark(void)
+{
+    sramBenchmarkRequested = 1;
+}
+
+enum { kBenchmarkBlocks = 256 };
+
+static _algorithm_blocks benchBlocks __attribute__((aligned(16)));
+
+static unsigned int benchmarkBlocks( _algorithm_blocks* b, int cached )
+// average core timer ticks per block
+{
+    unsigned int total = 0;
+    int i;
+    for ( i=0; i<kBenchmarkBlocks; ++i )
+    {
+        int ping = ( i & 1 ) ? framesPerBlock*2 : 0;
+        unsigned int t0 = cpuLoadTicks();
+        if ( cached )
+            invalidateAudioInputs( b, ping );
+        algorithm_step( b, ping );
+        if ( cached )
+            writeBackAudioOutputs( b, ping );
+        total += cpuLoadTicks() - t0;
+    }
+    return total / kBenchmarkBlocks;
+}
+
+static void checkBenchmark(void)
+// times algorithm_step() on cached and uncached copies of the audio buffers,
+// and replies with the system clock cycles per block for each
+// (the audio is stopped meanwhile, since the algorithm can't run twice at once)
+{
+    if ( !benchmarkRequested )
+        return;
+    benchmarkRequested = 0;
+
+    doServiceAudio = 0;
+
+    memcpy( &benchBlocks, &blocks, sizeof benchBlocks );
+    _pic32_clean_dcache( (uint32_t)&benchBlocks, sizeof benchBlocks );
+    unsigned int uncached = 2 * benchmarkBlocks( VirtToUncached( &benchBlocks ), 0 );
+    unsigned int cached = 2 * benchmarkBlocks( &benchBlocks, 1 );
+
+    doServiceAudio = 1;
+
+    BYTE buff[8];
+    BYTE* p = put28( buff, cached );
+    p = put28( p, uncached );
+    sendBytes( 0x76, buff, p - buff );
+}
+
+static void checkSRAMBenchmark(void)
+// with the audio stopped, so that the EBI timings can be changed under it
+// (see sramBenchmark())
+{
+    if ( !sramBenchmarkRequested )
+        return;
+    sramBenchmarkRequested = 0;
+
+    doServiceAudio = 0;
+    sramBenchmark();
+    doServiceAudio = 1;
+}
+
+static inline __attribute__((always_inline)) void updateZLEDs(void)
+{
+    int oc = 512 + ( (  blocks.in[2][0] - halfState[1].A[2] ) >> 13 );
+    APPLY_RANGE( oc, 0, 1023 );
+    OC9RS = oc;
+    oc = 512 + ( ( blocks.in[2][1] - halfState[0].A[2] ) >> 13 );
+    APPLY_RANGE( oc, 0, 1023 );
+    OC8RS = oc;
+}
+
+static void readFrontPanel(void)
+{
+    int ph = PORTH;
+    int pb = PORTB;
+    halfState[0].potSW = ( pb >> 12 ) & 1;
+    halfState[1].potSW = ( ph >> 15 ) & 1;
+
+    halfState[0].encA = ( ph >> 4 ) & 1;
+    halfState[0].encB = ( ph >> 5 ) & 1;
+    halfState[0].encSW = ( ph >> 6 ) & 1;
+    halfState[1].encA = ( ph >> 12 ) & 1;
+    halfState[1].encB = ( ph >> 13 ) & 1;
+    halfState[1].encSW = ( ph >> 14 ) & 1;
+
+    int enc[2] = { 0, 0 };
+    int i;
+    for ( i=0; i<2; ++i )
+    {
+        if ( !halfState[i].encB )
+        {
+            if ( !halfState[i].encA && halfState[i].lastEncA )
+            {
+                enc[i] = 1;
+                displayBlankCountdown = kTimeToBlank;
+            }
+            else if ( halfState[i].encA && !halfState[i].lastEncA )
+            {
+                enc[i] = -1;
+                displayBlankCountdown = kTimeToBlank;
+            }
+        }
+        halfState[i].lastEncA = halfState[i].encA;
+    }
+
+    PROFILE_BEGIN( kProfileUI );
+    algorithm_UI( enc );
+    PROFILE_END( kProfileUI );
+}
+
+static _taskResult frontPanelTask(void)
+{
+    readFrontPanel();
+    return kTaskDone;
+}
+
+static _taskResult midiOutTask(void)
+{
+    if ( midiOutPending )
+    {
+        PROFILE_BEGIN( kProfileMIDIOut );
+        HandleMIDIOut();
+        PROFILE_END( kProfileMIDIOut );
+    }
+    return kTaskDone;
+}
+
+static void addTasks(void)
+// in priority order
+{
+    schedulerInit();
+    schedulerAddTask( "MIDI out", midiOutTask, kRateBlocks, 1, 5, 3 );
+    schedulerAddTask( "front panel", frontPanelTask, kRateHz, SLOW_RATE, 100, 2 );
+    schedulerAddTask( "display", displayRefreshTask, kRateHz, kDisplayRefreshRate, 2000, 1 );
+    schedulerAddTask( "blank", displayBlankTask, kRateHz, kDisplayBlankRate, 5, 0 );
+    schedulerAddTask( "SRAM test", sramTestTask, kRateBlocks, 1, 100, 0 );
+#ifdef EVENT_TRACE
+    schedulerAddTask( "trace dump", traceDumpTask, kRateBlocks, 1, 100, 0 );
+#endif
+}
+
+#ifdef AUDIO_IN_ISR
+
+void startAudioInterrupt(void)
+{
+    // CHDHIE | CHDDIE
+    DCH5INTCLR = BIT_3 | BIT_4 | BIT_5;
+    DCH5INTSET = BIT_20 | BIT_21;
+
+    PLIB_INT_VectorPrioritySet( INT_ID_0, INT_VECTOR_DMA5, INT_PRIORITY_LEVEL6 );
+    PLIB_INT_VectorSubPrioritySet( INT_ID_0, INT_VECTOR_DMA5, INT_SUBPRIORITY_LEVEL0 );
+    PLIB_INT_SourceFlagClear( INT_ID_0, INT_SOURCE_DMA_5 );
+    PLIB_INT_SourceEnable( INT_ID_0, INT_SOURCE_DMA_5 );
+}
+
+void __ISR(_DMA5_VECTOR, ipl6srs) DMA5InterruptHandler(void)
+// audio
+{
+    unsigned int t0 = cpuLoadTicks();
+    int numBlocks = 0;
+
+    int bits = DCH5INT & ( BIT_4 | BIT_5 );
+    DCH5INTCLR = bits;
+    PLIB_INT_SourceFlagClear( INT_ID_0, INT_SOURCE_DMA_5 );
+
+    // both halves waiting means one of them went by unserviced
+    if ( !doServiceAudio )
+        cpuLoadDeadlinePause();
+    else if ( bits )
+        cpuLoadDeadlineStart( t0, ( bits == ( BIT_4 | BIT_5 ) ) ? 2 : 1, cpuLoadInterruptedAddress() );
+
+    PORTJINV = BIT_11;
+    PROFILE_BEGIN( kProfileADCs );
+    readAndTriggerADCs();
+    PROFILE_END( kProfileADCs );
+    PORTJINV = BIT_11;
+
+    if ( doServiceAudio )
+    {
+        // half buffer done
+        if ( bits & BIT_4 )
+        {
+            processAudioBlock( 0 );
+            schedulerTick( framesPerBlock );
+            numBlocks += 1;
+        }
+        // whole buffer done
+        if ( bits & BIT_5 )
+        {
+            processAudioBlock( framesPerBlock*2 );
+            schedulerTick( framesPerBlock );
+            numBlocks += 1;
+        }
+    }
+
+    updateZLEDs();
+
+    // the next half buffer is done already
+    if ( numBlocks )
+        cpuLoadDeadlineEnd( DCH5INT & ( BIT_4 | BIT_5 ) );
+
+    cpuLoadMeasure( cpuLoadTicks() - t0, numBlocks );
+}
+
+void serviceForeground(void)
+// everything that used to run alongside the audio, except the audio
+{
+    // check and change algorithm(s), in the background if possible
+    if ( algorithmSwitchNeedsStop() )
+    {
+        doServiceAudio = 0;
+        algorithmApplyRequest();
+        cpuLoadReset();
+        doServiceAudio = 1;
+    }
+    algorithmSwitchService();
+
+    checkFramesPerBlock();
+    checkBenchmark();
+    checkSRAMBenchmark();
+
+    FlushMIDIRx();
+
+    schedulerService();
+
+    algorithm_idle();
+}
+
+#else
+
 void serviceAudioSingle(void)
 {
-    // check and change algorithm
-    if ( 0 )
+    // check and change algorithm(s), in the background if possible
+    if ( algorithmSwitchNeedsStop() )
     {
         doServiceAudio = 0;
-        algorithm_init();
+        algorithmApplyRequest();
+        cpuLoadReset();
         doServiceAudio = 1;
     }
+    algorithmSwitchService();
+
+    checkFramesPerBlock();
+    checkBenchmark();
+    checkSRAMBenchmark();
     
     serviceAudioInternalSingle();
     
@@ -669,95 +1030,66 @@ void serviceAudioSingle(void)
 void serviceAudioInternalSingle(void)
 // can do anything but change algorithm
 {
+    unsigned int start = cpuLoadTicks();
+
     PORTJINV = BIT_11;
+    PROFILE_BEGIN( kProfileADCs );
     readAndTriggerADCs();
+    PROFILE_END( kProfileADCs );
     PORTJINV = BIT_11;
 
     if ( doServiceAudio )
     {
+        // the full buffer flag has just been seen - the half buffer flag was
+        // cleared along with it, so only the timer can tell if that went by too
+        cpuLoadDeadlineStart( start, 1, (unsigned int)(uintptr_t)__builtin_return_address( 0 ) );
+
         int i;
         for ( i=0; i<2; ++i )
         {
-            time += k_framesPerBlock;
-
-            PORTBSET = BIT_4;
+            unsigned int t0 = cpuLoadTicks();
+            processAudioBlock( i ? 0 : (framesPerBlock*2) );
+            cpuLoadMeasure( cpuLoadTicks() - t0, 1 );
 
-            algorithm_step( &blocks, i ? 0 : (k_framesPerBlock*2) );
+            // the flag for the next block is set already
+            cpuLoadDeadlineEnd( DCH5INT & ( i ? BIT_5 : BIT_4 ) );
 
-            PORTBCLR = BIT_4;
+            schedulerTick( framesPerBlock );
             
             FlushMIDIRx();
             
             if ( i )
                 break;
 
-            DCH5INTCLR = BIT_4 | BIT_5;
+            // wait for the half buffer flag, which was cleared along with the
+            // full buffer flag, so this is the next half however long the
+            // block above took
             for ( ;; )
             {
                 int bits = DCH5INT;
                 if ( bits & BIT_4 )
                 {
                     // half buffer done
+                    DCH5INTCLR = BIT_4;
                     break;
                 }
             }
+            cpuLoadDeadlineStart( cpuLoadTicks(), 1, (unsigned int)(uintptr_t)__builtin_return_address( 0 ) );
         }
     }
+    else
+        cpuLoadDeadlinePause();
 
     // update Z LEDs
-    int oc = 512 + ( (  blocks.in[2][0] - halfState[1].A[2] ) >> 13 );
-    APPLY_RANGE( oc, 0, 1023 );
-    OC9RS = oc;
-    oc = 512 + ( ( blocks.in[2][1] - halfState[0].A[2] ) >> 13 );
-    APPLY_RANGE( oc, 0, 1023 );
-    OC8RS = oc;
-    
-    if ( midiOutPending )
-        HandleMIDIOut();
-
-    slowTimeCountdown -= 2 * k_framesPerBlock;
-    if ( slowTimeCountdown <= 0 )
-    {
-        slowTimeCountdown = kSlowTimeRatio;
-    
-        int ph = PORTH;
-        int pb = PORTB;
-        halfState[0].potSW = ( pb >> 12 ) & 1;
-        halfState[1].potSW = ( ph >> 15 ) & 1;
-        
-        halfState[0].encA = ( ph >> 4 ) & 1;
-        halfState[0].encB = ( ph >> 5 ) & 1;
-        halfState[0].encSW = ( ph >> 6 ) & 1;
-        halfState[1].encA = ( ph >> 12 ) & 1;
-        halfState[1].encB = ( ph >> 13 ) & 1;
-        halfState[1].encSW = ( ph >> 14 ) & 1;
-        
-        int enc[2] = { 0, 0 };
-        int i;
-        for ( i=0; i<2; ++i )
-        {
-            if ( !halfState[i].encB )
-            {
-                if ( !halfState[i].encA && halfState[i].lastEncA )
-                {
-                    enc[i] = 1;
-					displayBlankCountdown = kTimeToBlank;
-                }
-                else if ( halfState[i].encA && !halfState[i].lastEncA )
-                {
-                    enc[i] = -1;
-					displayBlankCountdown = kTimeToBlank;
-                }
-            }
-            halfState[i].lastEncA = halfState[i].encA;
-        }
-        
-        algorithm_UI( enc );
-    }
+    updateZLEDs();
 }
 
+#endif
+
 void FlushMIDIRx(void)
 {
+    PROFILE_BEGIN( kProfileMIDIRx );
+
     for ( ;; )
     {
         // check I2C RX
@@ -796,6 +1128,8 @@ void FlushMIDIRx(void)
             ProcessMIDIIn( data );
         }
     }
+
+    PROFILE_END( kProfileMIDIRx );
 }
 
 void __attribute__((noreturn)) _fassert(int line, const char *file, const char *expr, const char *func)
@@ -49,8 +49,20 @@ extern "C" {
 
 #define SPI1_IS_EXT_DISPLAY
 
+// run the audio from the DMA channel 5 interrupt, rather than polling for it
+#define AUDIO_IN_ISR
+
+// keep the audio DMA buffers in cached memory, with explicit cache maintenance
+// around each block, rather than in uncached (coherent) memory
+#define AUDIO_BUFFERS_CACHED
+
+// keep a rolling trace of events in the external SRAM (see trace.h)
+#define EVENT_TRACE
+
+#ifndef DISTING_HOST
 typedef long long int64_t;
 typedef unsigned long long uint64_t;
+#endif
 
 typedef unsigned char           BYTE;                           /* 8-bit unsigned  */
 typedef unsigned short int      WORD;                           /* 16-bit unsigned */
@@ -193,6 +205,18 @@ static inline __attribute__((always_inline)) void WaitForAudioInterrupt(void)
     CLEAR_AUDIO_INTERRUPT();
 }
 
+#ifdef AUDIO_IN_ISR
+
+// the audio looks after itself, so there's nothing to check
+#define CHECK_SERVICE_AUDIO {}
+
+#define CHECK_SERVICE_AUDIO_INTERNAL {}
+
+void startAudioInterrupt(void);
+void serviceForeground(void);
+
+#else
+
 void serviceAudioSingle(void);
 void serviceAudioInternalSingle(void);
 
@@ -218,8 +242,13 @@ static inline __attribute__((always_inline)) void CheckServiceAudio(void)
     }
 }
 
+#endif
+
 void delayMs( unsigned int ms );
 
+void requestAudioBufferBenchmark(void);
+void requestSRAMBenchmark(void);
+
 extern MIDIMessageHandler midiMessageHandler;
 
 extern int DefaultMIDIMessageHandler( BYTE status, BYTE channel, const BYTE* message );
@@ -227,14 +256,51 @@ extern int ProcessMIDIIn( BYTE b );
 extern int QueueMIDI3( UINT32 msg );
 extern void BlockingQueueMIDI3( UINT32 msg );
 extern void BlockingQueueMIDI1( BYTE b );
+extern int MIDIOutQueueSpace(void);
 extern int QueueMIDI2( UINT32 msg );
 extern void BlockingQueueMIDI2( UINT32 msg );
 extern int HandleMIDIOut(void);
 extern void FlushMIDIOut(void);
 void FlushMIDIRx(void);
 void sendBytes( int code, const BYTE* ptr, int count );
+// for a message too long to build in one go - its bytes go through
+// BlockingQueueMIDI1() in between
+void sendSysExStart( int code );
+void sendSysExEnd(void);
 void sendSysExMsg( const char* str );
 
+// for building SysEx messages - a value in 7 bit bytes, most significant
+// first, clamped to fit (put32() has the top 4 bits in its first byte)
+static inline BYTE* put14( BYTE* p, unsigned int v )
+{
+    if ( v > 0x3fff )
+        v = 0x3fff;
+    *p++ = ( v >> 7 ) & 0x7f;
+    *p++ = v & 0x7f;
+    return p;
+}
+
+static inline BYTE* put28( BYTE* p, unsigned int v )
+{
+    if ( v > 0xfffffff )
+        v = 0xfffffff;
+    *p++ = ( v >> 21 ) & 0x7f;
+    *p++ = ( v >> 14 ) & 0x7f;
+    *p++ = ( v >> 7 ) & 0x7f;
+    *p++ = v & 0x7f;
+    return p;
+}
+
+static inline BYTE* put32( BYTE* p, unsigned int v )
+{
+    *p++ = v >> 28;
+    *p++ = ( v >> 21 ) & 0x7f;
+    *p++ = ( v >> 14 ) & 0x7f;
+    *p++ = ( v >> 7 ) & 0x7f;
+    *p++ = v & 0x7f;
+    return p;
+}
+
 extern BYTE midiOutPending;
 extern unsigned int masterMIDIClockCounter;
 
@@ -254,10 +320,14 @@ int ProcessI2CIn( int b );
 void configureDisplay(void);
 void configureDisplay2(void);
 
+#ifndef SRAM_ADDR
 #define SRAM_ADDR (0xC0000000)
 #define SRAM_ADDR_UNCACHED (0xE0000000)
+#endif
 #define SRAM_SIZE (8*1024*1024)
 
+#define VirtToPhys( addr )  ( 0x1FFFFFFF & (UINT32)(addr) )
+
 void ReadCalibrationFromSettings(void);
 
 #define ARRAY_SIZE(X) (sizeof X/sizeof X[0])
@@ -33,9 +33,11 @@ SOFTWARE.
 #include "app.h"
 #include "display.h"
 
-unsigned int screen[128] __attribute__((coherent)) __attribute__((aligned(16))) = { 0 };
-unsigned int screen2[128] __attribute__((coherent)) __attribute__((aligned(16))) = { 0 };
-unsigned int *screen2ptr = screen2;
+// the back buffer (drawn on) and the front (being sent) swap at the end
+// of each frame (see displayRefreshTask())
+unsigned int screenBuffers[2][128] __attribute__((coherent)) __attribute__((aligned(16))) = { { 0 } };
+unsigned int *screen = screenBuffers[0];
+unsigned int *displayFront = screenBuffers[1];
 
 void sendDisplayByte( BYTE c )
 {
@@ -26,6 +26,7 @@ SOFTWARE.
 
 #include "app.h"
 #include "display.h"
+#include "convert.h"
 
 typedef struct {
     int zeroIn;
@@ -50,7 +51,9 @@ typedef struct Settings {
 
 } Settings;
 
+#ifndef SETTINGS_BASE
 #define SETTINGS_BASE 0xBD008000
+#endif
 #define nvm_settings ( (Settings*)SETTINGS_BASE )
 
 Settings settings __attribute__((aligned(16))) __attribute__((coherent));
@@ -174,6 +177,7 @@ void ReadCalibrationFromSettings(void)
             Bf = Bf / 3.0;
             halfState[d].Brf[i] = 1.0 / Bf;
             inputCalibrations[ inputMap[d][i] ].Brf = halfState[d].Brf[i];
+            convertSetInputCalibration( inputMap[d][i], zeroIn, Bf );
 
             int B = ( threeVolt - zeroIn ) / 3;
             // avoid a divide by zero
@@ -202,6 +206,7 @@ void ReadCalibrationFromSettings(void)
                 halfState[d].Dd[i] = Dd;
                 halfState[d].Ddf[i] = Dd;
                 halfState[d].Erf[i] = 1.0 / Ef;
+                convertSetOutputCalibration( 2*d+i, -Dd, 1.0 / Ef );
             }
         }
     }
@@ -0,0 +1,138 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+
+Input calibration and output conversion kernels.
+
+Each sample is a 32x32 to 64 bit multiply-add, the channel's offset
+(with its fraction) being the accumulator's starting value, and a
+rounding, saturating extraction with a per-channel shift. The shifts are
+chosen to give the gains 30 bits of precision, where the range allows.
+The gains and offsets come straight from the calibration settings, so
+they are more precise than the float ones in inputCalibrations[] and
+halfState[].
+
+With the DSP ASE these are madd and extr_rs.w, and the outputs' 24 bit
+clamp is shll_s.w, so there are no branches. The scalar versions, for
+other targets, give identical results.
+
+*/
+#include <math.h>
+#include "convert.h"
+
+_sampleConversion inputConversions[6];
+_sampleConversion outputConversions[4];
+
+static void deriveConversion( _sampleConversion* c, double gain, double offset )
+{
+    int shift = 31;
+    while ( shift > 1 && fabs( ldexp( gain, shift ) ) >= (double)( 1 << 30 ) )
+        --shift;
+    double g = ldexp( gain, shift );
+    APPLY_RANGE( g, -2147483647.0, 2147483647.0 );
+    c->gain = (int)floor( g + 0.5 );
+    c->shift = shift;
+    c->offset = (int64_t)floor( ldexp( offset, shift ) + 0.5 );
+}
+
+void    convertSetInputCalibration( int channel, double zeroCode, double codesPerVolt )
+{
+    // volts = ( code - zeroCode ) / codesPerVolt
+    double gain = kQ24One / codesPerVolt;
+    deriveConversion( &inputConversions[channel], gain, -zeroCode * gain );
+}
+
+void    convertSetOutputCalibration( int channel, double zeroCode, double codesPerVolt )
+{
+    // code = volts * codesPerVolt + zeroCode
+    deriveConversion( &outputConversions[channel], codesPerVolt / kQ24One, zeroCode );
+}
+
+#if defined(__mips_dsp)
+
+static inline __attribute__((always_inline)) int mulAdd( int x, int gain, int64_t offset, int shift )
+{
+    return __builtin_mips_extr_rs_w( __builtin_mips_madd( offset, x, gain ), shift );
+}
+
+static inline __attribute__((always_inline)) int clamp24( int x )
+{
+    return __builtin_mips_shll_s_w( x, 8 ) >> 8;
+}
+
+#else
+
+static inline __attribute__((always_inline)) int mulAdd( int x, int gain, int64_t offset, int shift )
+{
+    int64_t r = ( (int64_t)x * gain + offset + ( 1LL << ( shift - 1 ) ) ) >> shift;
+    APPLY_RANGE( r, -0x80000000LL, 0x7fffffffLL );
+    return r;
+}
+
+static inline __attribute__((always_inline)) int clamp24( int x )
+{
+    CLAMP( x );
+    return x;
+}
+
+#endif
+
+static void convertInput( const int* src, int* dst, int frames, const _sampleConversion* c )
+{
+    const int64_t offset = c->offset;
+    const int gain = c->gain;
+    const int shift = c->shift;
+    int i;
+    for ( i=0; i<frames; ++i )
+        dst[i] = mulAdd( src[ 2*i ], gain, offset, shift );
+}
+
+static void convertOutput( const int* src, int* dst, int frames, const _sampleConversion* c )
+{
+    const int64_t offset = c->offset;
+    const int gain = c->gain;
+    const int shift = c->shift;
+    int i;
+    for ( i=0; i<frames; ++i )
+        dst[ 2*i ] = clamp24( mulAdd( src[i], gain, offset, shift ) );
+}
+
+void    convertInputs( const _algorithm_blocks* blocks, int ping, int frames, int planes[6][k_maxFramesPerBlock] )
+{
+    convertInput( &blocks->in[0][ ping + 0 ], planes[0], frames, &inputConversions[0] );
+    convertInput( &blocks->in[0][ ping + 1 ], planes[1], frames, &inputConversions[1] );
+    convertInput( &blocks->in[1][ ping + 0 ], planes[2], frames, &inputConversions[2] );
+    convertInput( &blocks->in[1][ ping + 1 ], planes[3], frames, &inputConversions[3] );
+    convertInput( &blocks->in[2][ ping + 1 ], planes[4], frames, &inputConversions[4] );
+    convertInput( &blocks->in[2][ ping + 0 ], planes[5], frames, &inputConversions[5] );
+}
+
+void    convertOutputs( const int planes[4][k_maxFramesPerBlock], _algorithm_blocks* blocks, int ping, int frames )
+{
+    convertOutput( planes[0], &blocks->out[0][ ping + 1 ], frames, &outputConversions[0] );
+    convertOutput( planes[1], &blocks->out[0][ ping + 0 ], frames, &outputConversions[1] );
+    convertOutput( planes[2], &blocks->out[1][ ping + 1 ], frames, &outputConversions[2] );
+    convertOutput( planes[3], &blocks->out[1][ ping + 0 ], frames, &outputConversions[3] );
+}
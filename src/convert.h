@@ -0,0 +1,69 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef _CONVERT_H    /* Guard against multiple inclusion */
+#define _CONVERT_H
+
+#include "algorithm.h"
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Conversion between the codec samples in the DMA buffers and voltages
+// in Q8.24 fixed point, with the calibration applied.
+//
+// Inputs are  volts = ( code * gain + offset ) >> shift
+// Outputs are code  = ( volts * gain + offset ) >> shift
+// both rounded and saturated. The offset includes any fraction.
+
+enum { kQ24One = 1 << 24 };
+
+typedef struct {
+    int64_t offset;
+    int     gain;
+    int     shift;
+} _sampleConversion;
+
+extern _sampleConversion inputConversions[6];
+extern _sampleConversion outputConversions[4];
+
+// set a channel's conversion from its calibration,
+// as the code at zero volts and the codes per volt
+void    convertSetInputCalibration( int channel, double zeroCode, double codesPerVolt );
+void    convertSetOutputCalibration( int channel, double zeroCode, double codesPerVolt );
+
+// deinterleave and calibrate blocks->in into planes[channel][frame]
+void    convertInputs( const _algorithm_blocks* blocks, int ping, int frames, int planes[6][k_maxFramesPerBlock] );
+
+// convert, saturate and interleave planes[channel][frame] into blocks->out
+void    convertOutputs( const int planes[4][k_maxFramesPerBlock], _algorithm_blocks* blocks, int ping, int frames );
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CONVERT_H */
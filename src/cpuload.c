@@ -0,0 +1,270 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+
+CPU load, measured with the core timer (which runs at half the system clock)
+around the audio processing, as a fraction of the time available per block.
+
+In the dual mode each slot's algorithm is also measured, against its budget,
+a share of the block period.
+
+The audio's deadlines are checked too (see cpuload.h), and the blocks that
+were late are counted, with the scheduler task that was running at the time.
+
+*/
+#include "cpuload.h"
+#include "algorithm.h"
+
+_cpuLoad cpuLoad = { 0 };
+
+_audioDeadlines audioDeadlines = { 0 };
+
+_slotLoad slotLoads[kNumAlgorithmSlots] = {
+    { kDefaultSlotBudget },
+    { kDefaultSlotBudget },
+};
+
+void cpuLoadReset(void)
+// also needed when the block size changes
+{
+    memset( &cpuLoad, 0, sizeof cpuLoad );
+    cpuLoad.blockTicks = ( framesPerBlock * (uint64_t)SYS_CLK_FREQ/2 ) / SAMPLE_RATE;
+
+    // the period may have changed, or the audio been stopped
+    audioDeadlines.synced = 0;
+
+    int i;
+    for ( i=0; i<kNumAlgorithmSlots; ++i )
+        cpuLoadSetSlotBudget( i, slotLoads[i].budget );
+}
+
+void cpuLoadSetSlotBudget( int slot, unsigned int budget )
+// also resets the slot's measurements
+{
+    if ( slot < 0 || slot >= kNumAlgorithmSlots )
+        return;
+    APPLY_RANGE( budget, 1, 1000 );
+    memset( &slotLoads[slot], 0, sizeof slotLoads[slot] );
+    slotLoads[slot].budget = budget;
+}
+
+void cpuLoadMeasureSlot( int slot, unsigned int ticks )
+{
+    _slotLoad* s = &slotLoads[slot];
+    unsigned int budgetTicks = ( cpuLoad.blockTicks * s->budget ) / 1000;
+    if ( !budgetTicks )
+        return;
+
+    unsigned int load = ( ticks * 1000ULL ) / budgetTicks;
+    if ( load > 1000 )
+        s->overruns += 1;
+
+    int delta = ( load << 8 ) - s->smoothed;
+    s->smoothed += delta >> 8;
+    s->current = s->smoothed >> 8;
+
+    if ( load > s->peak )
+        s->peak = load;
+}
+
+void cpuLoadMeasure( unsigned int ticks, int blocks )
+{
+    if ( blocks <= 0 || !cpuLoad.blockTicks )
+        return;
+
+    unsigned int load = ( ticks * 1000ULL ) / ( blocks * cpuLoad.blockTicks );
+
+    // one pole smoothing, time constant of 256 blocks
+    int delta = ( load << 8 ) - cpuLoad.smoothed;
+    cpuLoad.smoothed += delta >> 8;
+    cpuLoad.current = cpuLoad.smoothed >> 8;
+
+    if ( load > cpuLoad.peak )
+        cpuLoad.peak = load;
+
+    int bucket = load / 100;
+    if ( bucket >= kCPULoadHistogramSize )
+        bucket = kCPULoadHistogramSize - 1;
+    cpuLoad.histogram[ bucket ] += blocks;
+}
+
+void cpuLoadDeadlineReset(void)
+{
+    unsigned int status = __builtin_disable_interrupts();
+    memset( &audioDeadlines, 0, sizeof audioDeadlines );
+    if ( status & 1 )
+        __builtin_enable_interrupts();
+}
+
+static void deadlineEvent( _deadlineKind kind, int lateness, unsigned int address )
+{
+    _audioDeadlines* d = &audioDeadlines;
+
+    int task = schedulerCurrentTask;
+    if ( kind == kDeadlineOverrun || task < 0 || task >= kMaxTasks )
+        task = kDeadlineNoTask;
+    if ( kind != kDeadlineOverrun )
+        d->byTask[ task ] += 1;
+
+    if ( lateness < 0 )
+        lateness = 0;
+    if ( lateness > d->worst )
+        d->worst = lateness;
+
+    _deadlineEvent* e = &d->events[ d->numEvents % kDeadlineEvents ];
+    e->kind = kind;
+    e->task = task;
+    e->lateness = lateness;
+    e->address = address;
+    d->numEvents += 1;
+}
+
+void cpuLoadDeadlineStart( unsigned int now, int halves, unsigned int address )
+{
+    _audioDeadlines* d = &audioDeadlines;
+    int period = cpuLoad.blockTicks;
+    if ( !period || halves <= 0 )
+        return;
+
+    if ( !d->synced )
+    {
+        d->synced = 1;
+        d->due = now + period;
+        return;
+    }
+
+    int lateness = now - d->due;
+
+    // the flags can only show one more half buffer gone by - the timer
+    // shows how many
+    int missed = halves - 1;
+    if ( lateness / period > missed )
+        missed = lateness / period;
+
+    if ( missed )
+    {
+        d->missed += missed;
+        deadlineEvent( kDeadlineMissed, lateness, address );
+    }
+    else if ( lateness > period/4 )
+    {
+        d->late += 1;
+        deadlineEvent( kDeadlineLate, lateness, address );
+    }
+
+    // a block on time gives the phase of the DMA, so resync to it,
+    // otherwise count on from when this one was due
+    if ( lateness <= period/4 )
+        d->due = now + period;
+    else
+        d->due += ( 1 + missed ) * period;
+}
+
+void cpuLoadDeadlinePause(void)
+{
+    audioDeadlines.synced = 0;
+}
+
+void cpuLoadDeadlineEnd( int overrun )
+{
+    _audioDeadlines* d = &audioDeadlines;
+    if ( !overrun || !d->synced )
+        return;
+    d->overruns += 1;
+    deadlineEvent( kDeadlineOverrun, cpuLoadTicks() - d->due, 0 );
+}
+
+void cpuLoadSendSysEx(void)
+// current & peak as 14 bit values, then the histogram counts as 28 bit values
+{
+    _cpuLoad c = cpuLoad;
+    BYTE buff[ 4 + 4 * kCPULoadHistogramSize ];
+    BYTE* p = put14( buff, c.current );
+    p = put14( p, c.peak );
+    int i;
+    for ( i=0; i<kCPULoadHistogramSize; ++i )
+        p = put28( p, c.histogram[i] );
+    sendBytes( 0x72, buff, p - buff );
+}
+
+void cpuLoadSendSlotSysEx(void)
+// for each slot, the budget, current & peak as 14 bit values,
+// then the overruns as a 28 bit value
+{
+    BYTE buff[ 10 * kNumAlgorithmSlots ];
+    BYTE* p = buff;
+    int i;
+    for ( i=0; i<kNumAlgorithmSlots; ++i )
+    {
+        _slotLoad s = slotLoads[i];
+        p = put14( p, s.budget );
+        p = put14( p, s.current );
+        p = put14( p, s.peak );
+        p = put28( p, s.overruns );
+    }
+    sendBytes( 0x79, buff, p - buff );
+}
+
+void cpuLoadSendDeadlineSysEx(void)
+// the late, missed and overrun counts as 28 bit values, and the worst
+// lateness in microseconds (14 bits), then for each scheduler task its name
+// (0 terminated) and the late and missed blocks while it was running, then
+// an empty name and the count for no task, then the latest events, oldest
+// first - each its kind, its task (0x7f for none), its lateness in
+// microseconds (14 bits) and the address it interrupted (32 bits)
+{
+    enum { kTicksPerUs = SYS_CLK_FREQ/2/1000000 };
+    enum { kMaxName = 12 };
+    _audioDeadlines d = audioDeadlines;
+    BYTE buff[ 14 + ( kMaxTasks + 1 ) * ( kMaxName + 1 + 4 ) + kDeadlineEvents * 9 ];
+    BYTE* p = buff;
+    int i, j;
+
+    p = put28( p, d.late );
+    p = put28( p, d.missed );
+    p = put28( p, d.overruns );
+    p = put14( p, d.worst / kTicksPerUs );
+
+    for ( i=0; i<numTasks; ++i )
+    {
+        for ( j=0; j<kMaxName && tasks[i].name[j]; ++j )
+            *p++ = tasks[i].name[j] & 0x7f;
+        *p++ = 0;
+        p = put28( p, d.byTask[i] );
+    }
+    *p++ = 0;
+    p = put28( p, d.byTask[ kDeadlineNoTask ] );
+
+    int n = ( d.numEvents < kDeadlineEvents ) ? d.numEvents : kDeadlineEvents;
+    for ( i=0; i<n; ++i )
+    {
+        const _deadlineEvent* e = &d.events[ ( d.numEvents - n + i ) % kDeadlineEvents ];
+        *p++ = e->kind;
+        *p++ = ( e->task == kDeadlineNoTask ) ? 0x7f : e->task;
+        p = put14( p, e->lateness / kTicksPerUs );
+        p = put32( p, e->address );
+    }
+    sendBytes( 0x63, buff, p - buff );
+}
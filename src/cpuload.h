@@ -0,0 +1,137 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef _CPULOAD_H    /* Guard against multiple inclusion */
+#define _CPULOAD_H
+
+#include "app.h"
+#include "algorithm.h"
+#include "scheduler.h"
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 10% buckets, the last one for 100% and over
+enum { kCPULoadHistogramSize = 11 };
+
+// loads are in tenths of a percent of the block period
+typedef struct {
+    unsigned int    blockTicks;         // core timer ticks per block
+    unsigned int    smoothed;           // with 8 bits of fraction
+    unsigned int    current;
+    unsigned int    peak;
+    unsigned int    histogram[kCPULoadHistogramSize];
+} _cpuLoad;
+
+extern _cpuLoad cpuLoad;
+
+// the dual mode's slots, each against its own budget
+typedef struct {
+    unsigned int    budget;             // tenths of a percent of the block period
+    unsigned int    smoothed;           // with 8 bits of fraction
+    unsigned int    current;            // tenths of a percent of the budget
+    unsigned int    peak;
+    unsigned int    overruns;           // blocks over budget
+} _slotLoad;
+
+enum { kDefaultSlotBudget = 450 };
+
+extern _slotLoad slotLoads[kNumAlgorithmSlots];
+
+void cpuLoadReset(void);
+void cpuLoadMeasure( unsigned int ticks, int blocks );
+void cpuLoadSendSysEx(void);
+
+// The audio's deadlines, checked against both the DMA flags and the core
+// timer. Each block is due when its half buffer flag is set, which is
+// one block period after the last, so a block that starts more than a
+// quarter of a period after that is late. One that starts after the
+// following flag has been set as well has missed its half buffer, which
+// is heard. One that finishes after the following flag has overrun.
+enum { kDeadlineEvents = 8 };
+
+typedef enum {
+    kDeadlineLate,
+    kDeadlineMissed,
+    kDeadlineOverrun,
+} _deadlineKind;
+
+// the task for a block that was late with no task running, or that overran
+enum { kDeadlineNoTask = kMaxTasks };
+
+typedef struct {
+    BYTE            kind;
+    BYTE            task;               // scheduler task, or kDeadlineNoTask
+    unsigned int    lateness;           // core timer ticks
+    unsigned int    address;            // where the foreground was
+} _deadlineEvent;
+
+typedef struct {
+    BYTE            synced;
+    unsigned int    due;                // when the next block's flag is due
+    unsigned int    late;
+    unsigned int    missed;             // half buffers
+    unsigned int    overruns;
+    unsigned int    worst;              // ticks late
+    unsigned int    byTask[ kMaxTasks + 1 ];
+    unsigned int    numEvents;          // the latest are kept
+    _deadlineEvent  events[ kDeadlineEvents ];
+} _audioDeadlines;
+
+extern _audioDeadlines audioDeadlines;
+
+// from the audio - when it starts, with the number of half buffers waiting
+// and where it interrupted the foreground, and when it finishes, with
+// whether the next half buffer is already waiting
+void cpuLoadDeadlineStart( unsigned int now, int halves, unsigned int address );
+void cpuLoadDeadlineEnd( int overrun );
+// the audio has been stopped on purpose, so the next block starts afresh
+void cpuLoadDeadlinePause(void);
+
+void cpuLoadDeadlineReset(void);
+void cpuLoadSendDeadlineSysEx(void);
+
+void cpuLoadSetSlotBudget( int slot, unsigned int budget );
+void cpuLoadMeasureSlot( int slot, unsigned int ticks );
+void cpuLoadSendSlotSysEx(void);
+
+static inline __attribute__((always_inline)) unsigned int cpuLoadTicks(void)
+{
+    return __builtin_mfc0( _CP0_COUNT, _CP0_COUNT_SELECT );
+}
+
+// in an interrupt handler, the address it will return to
+static inline __attribute__((always_inline)) unsigned int cpuLoadInterruptedAddress(void)
+{
+    return __builtin_mfc0( _CP0_EPC, _CP0_EPC_SELECT );
+}
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CPULOAD_H */
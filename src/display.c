@@ -39,8 +39,9 @@ SOFTWARE.
 #include "app.h"
 #include "display.h"
 #include "algorithm.h"
-
-#define kDisplayRefreshCount (SAMPLE_RATE/30)
+#include "cpuload.h"
+#include "profile.h"
+#include "trace.h"
 
 char displayMode = kDisplayModeNormal;
 
@@ -50,111 +51,248 @@ int displayIsOn = 1;
 
 char message4x16[4][17] = { 0 };
 
-const BYTE font_8x8[96][8] = {
-#include "fonts/codeman38_deluxefont/dlxfont.ttf.h"
-};
+// the bytes of the frame not yet handed to the DMAs, or -1 once it's all gone
+int displayBytesToSend = -1;
+
+// whether the displays show the front buffer, to find the columns that
+// have changed against it
+static BYTE displayFrontValid = 0;
 
-void drawChar88( int x, int y, char c )
+// the changed columns of the frame being sent, and the next to go
+static _displayWindow displayWindows[ kMaxDisplayWindows ];
+static int numDisplayWindows = 0;
+static int nextDisplayWindow = 0;
+static BYTE displaySendingCommands = 0;
+
+void displayInvalidate(void)
 {
-	int index = c - 32;
-	if ( index < 0 || index >= 96 )
-		return;
-	int i;
-	for ( i=0; i<8; ++i )
-	{
-		unsigned int xx = x + i;
-        if ( xx < 128 )
-        {
-    		unsigned int f = font_8x8[index][i];
-        	screen[xx] |= ( f << y );
-        }
-	}
+    displayFrontValid = 0;
 }
 
-void drawString88( int x, int y, const char* str )
+static int findDisplayWindows(void)
+// compares the back buffer with the front
 {
-	for ( ;; )
-	{
-		char c = *str++;
-		if ( !c )
-			break;
-		int index = c - 32;
-		if ( index < 0 || index >= 96 )
-			continue;
-		int i;
-		for ( i=0; i<8; ++i )
-		{
-			unsigned int xx = x + i;
-            if ( xx < 128 )
+    int n = 0;
+    int x;
+    if ( !displayFrontValid )
+    {
+        displayWindows[0].x0 = 0;
+        displayWindows[0].x1 = 127;
+        n = 1;
+    }
+    else
+    {
+        for ( x=0; x<128; ++x )
+        {
+            if ( screen[x] == displayFront[x] )
+                continue;
+            // close enough to the last to share its commands, or out of windows
+            if ( n && ( x - displayWindows[n-1].x1 <= kDisplayWindowGap || n == kMaxDisplayWindows ) )
             {
-                unsigned int f = font_8x8[index][i];
-                screen[xx] |= ( f << y );
+                displayWindows[n-1].x1 = x;
+                continue;
             }
-            CHECK_SERVICE_AUDIO
-		}
-		x += 8;
-	}
+            displayWindows[n].x0 = x;
+            displayWindows[n].x1 = x;
+            n += 1;
+        }
+    }
+    displayFrontValid = 1;
+    return n;
 }
 
-int displayBytesToSend = -1;
+void setupDisplayDMAs(void)
+// a channel per display, each sending a window of the front buffer to its SPI,
+// triggered by the SPI's transmit interrupt (while its FIFO isn't full) -
+// the interrupt itself stays disabled
+{
+    // CHSIRQ | SIRQEN
+    DCH1ECON = ( DMA_TRIGGER_SPI_5_TRANSMIT << 8 ) | BIT_4;
+    DCH1INT = 0;
+    DCH1DSA = VirtToPhys( &SPI5BUF );
+    DCH1DSIZ = 1;
+    DCH1CSIZ = 1;
+    // priority 0, below the audio
+    DCH1CON = 0;
 
-void displayLoop( void )
+#ifdef SPI1_IS_EXT_DISPLAY
+    // CHSIRQ | SIRQEN
+    DCH2ECON = ( DMA_TRIGGER_SPI_1_TRANSMIT << 8 ) | BIT_4;
+    DCH2INT = 0;
+    DCH2DSA = VirtToPhys( &SPI1BUF );
+    DCH2DSIZ = 1;
+    DCH2CSIZ = 1;
+    DCH2CON = 0;
+#endif
+}
+
+static inline int displayWriteDone(void)
+// the DMAs have finished, and the last bytes have left the SPI FIFOs
 {
-    int refreshCount = 0;
-    unsigned int displayLastTime = time;
-    for ( ;; )
-    {
-        CHECK_SERVICE_AUDIO
-        
-        if ( displayBytesToSend > 0 )
-        {
-            if ( SPI5STATbits.SPITBF )
-                continue;
+    if ( DCH1CONbits.CHEN || SPI5STATbits.SPIBUSY )
+        return 0;
 #ifdef SPI1_IS_EXT_DISPLAY
-            if ( SPI1STATbits.SPITBF )
-                continue;
+    if ( DCH2CONbits.CHEN || SPI1STATbits.SPIBUSY )
+        return 0;
 #endif
-            SPI5BUF = ((BYTE*)screen)[512-displayBytesToSend];
+    return 1;
+}
+
+static void sendDisplayWindowCommands( const _displayWindow* w )
+// the column and page addresses, which fit in the SPIs' FIFOs
+{
+    // instruction (not data)
+    PORTJCLR = BIT_9;
+    SPI5BUF = 0x21;
+    SPI5BUF = w->x0;
+    SPI5BUF = w->x1;
+    SPI5BUF = 0x22;
+    SPI5BUF = 0;
+    SPI5BUF = 3;
 #ifdef SPI1_IS_EXT_DISPLAY
-            SPI1BUF = ((BYTE*)screen2ptr)[512-displayBytesToSend];
+    // its columns start at 4 (see configureDisplay2())
+    PORTJCLR = BIT_2;
+    SPI1BUF = 0x21;
+    SPI1BUF = w->x0 + 4;
+    SPI1BUF = w->x1 + 4;
+    SPI1BUF = 0x22;
+    SPI1BUF = 0;
+    SPI1BUF = 3;
 #endif
-            displayBytesToSend -= 1;
-            continue;
-        }
-        else if ( displayBytesToSend == 0 )
-        {
-            if ( SPI5STATbits.SPIBUSY )
-                continue;
+}
+
+static void sendDisplayWindowData( const _displayWindow* w )
+{
+    int bytes = ( w->x1 - w->x0 + 1 ) * 4;
+
+    // data (not instruction)
+    PORTJSET = BIT_9;
+    DCH1SSA = VirtToPhys( &displayFront[ w->x0 ] );
+    DCH1SSIZ = bytes;
+    DCH1INTCLR = 0xff;
+    // CHEN - the channel turns itself off at the end of the block
+    DCH1CONSET = BIT_7;
 #ifdef SPI1_IS_EXT_DISPLAY
-            if ( SPI1STATbits.SPIBUSY )
-                continue;
+    PORTJSET = BIT_2;
+    // the external display mirrors the main one
+    DCH2SSA = VirtToPhys( &displayFront[ w->x0 ] );
+    DCH2SSIZ = bytes;
+    DCH2INTCLR = 0xff;
+    DCH2CONSET = BIT_7;
 #endif
-            // CS high
-            PORTASET = BIT_0;
+    displayBytesToSend -= bytes;
+}
+
+static void stepDisplayWrite(void)
+// with the SPIs idle - each window's commands, then its data, then
+// the chip selects go high at the end
+{
+    if ( displaySendingCommands )
+    {
+        displaySendingCommands = 0;
+        sendDisplayWindowData( &displayWindows[ nextDisplayWindow++ ] );
+    }
+    else if ( nextDisplayWindow < numDisplayWindows )
+    {
+        displaySendingCommands = 1;
+        sendDisplayWindowCommands( &displayWindows[ nextDisplayWindow ] );
+    }
+    else
+    {
+        // CS high
+        PORTASET = BIT_0;
 #ifdef SPI1_IS_EXT_DISPLAY
-            PORTJSET = BIT_3;
+        PORTJSET = BIT_3;
 #endif
-            displayBytesToSend = -1;
-        }
-        
-        unsigned int thisTime = time;
-        int dt = thisTime - displayLastTime;
-        refreshCount -= dt;
-        if ( refreshCount <= 0 )
-        {
-            updateDisplay();
-            
-            displayBytesToSend = 512;
-            // CS low
-            PORTACLR = BIT_0;
+        displayBytesToSend = -1;
+        TRACE( kTraceDisplayEnd, 0 );
+    }
+}
+
+static void startDisplayWrite(void)
+{
+    displayBytesToSend = 0;
+    int i;
+    for ( i=0; i<numDisplayWindows; ++i )
+        displayBytesToSend += ( displayWindows[i].x1 - displayWindows[i].x0 + 1 ) * 4;
+    nextDisplayWindow = 0;
+    displaySendingCommands = 0;
+
+    // CS low
+    PORTACLR = BIT_0;
 #ifdef SPI1_IS_EXT_DISPLAY
-            PORTJCLR = BIT_3;
+    PORTJCLR = BIT_3;
 #endif
-            refreshCount = kDisplayRefreshCount;
-        }
-        
-        displayLastTime = thisTime;
+    stepDisplayWrite();
+}
+
+void displayLoop( void )
+// runs the foreground, while the DMAs send the front buffer
+// (which is refreshed by displayRefreshTask())
+{
+    for ( ;; )
+    {
+#ifdef AUDIO_IN_ISR
+        serviceForeground();
+#else
+        CHECK_SERVICE_AUDIO
+        schedulerService();
+#endif
+        allowDisplayWrite();
+    }
+}
+
+// whether the back buffer holds the next frame, waiting for the front to go
+static BYTE displayFrameDrawn = 0;
+
+static void updateDisplayPower( void );
+
+_taskResult displayRefreshTask(void)
+// draws the next frame into the back buffer while the last is still being
+// sent from the front, then swaps them once it has gone
+{
+    if ( !displayFrameDrawn )
+    {
+        PROFILE_BEGIN( kProfileDisplay );
+        updateDisplay();
+        PROFILE_END( kProfileDisplay );
+        displayFrameDrawn = 1;
+        // the swap in a slice of its own
+        return kTaskMore;
+    }
+
+    // if the last one is still going, try again next period - waiting
+    // in progress would keep the lower priority tasks from running
+    if ( displayBytesToSend >= 0 )
+        return kTaskDone;
+    displayFrameDrawn = 0;
+
+    // the SPIs are free for commands now
+    updateDisplayPower();
+
+    numDisplayWindows = findDisplayWindows();
+    unsigned int* back = displayFront;
+    displayFront = screen;
+    screen = back;
+
+    // nothing to send if nothing has changed
+    if ( numDisplayWindows )
+    {
+        TRACE( kTraceDisplayStart, 0 );
+        startDisplayWrite();
     }
+    return kTaskDone;
+}
+
+_taskResult displayBlankTask(void)
+{
+    if ( displayBlankCountdown > 0 )
+    {
+        displayBlankCountdown -= SAMPLE_RATE / kDisplayBlankRate;
+        if ( displayBlankCountdown < 0 )
+            displayBlankCountdown = 0;
+    }
+    return kTaskDone;
 }
 
 void clearScreenWithAudioService(void)
@@ -252,17 +390,16 @@ void copyScreenWithAudioService( unsigned int* dst, const unsigned int* src )
     }
 }
 
-void updateDisplay( void )
+static void updateDisplayPower( void )
 {
     if ( displayIsOn )
     {
-        displayBlankCountdown -= kDisplayRefreshCount;
-        if ( displayBlankCountdown <= 0 )
+        // counted down by displayBlankTask()
+        if ( !displayBlankCountdown )
         {
             // turn it off
             turnOffDisplay();
             displayIsOn = 0;
-            displayBlankCountdown = 0;
         }
     }
     else
@@ -275,10 +412,12 @@ void updateDisplay( void )
             displayIsOn = 1;
         }
     }
-    
-    int i;
+}
 
-    screen2ptr = screen;
+void updateDisplay( void )
+// draws into the back buffer
+{
+    int i;
 
     unsigned int clear = 0;
     for ( i=0; i<128; ++i )
@@ -305,13 +444,61 @@ void updateDisplay( void )
             for ( i=0; i<4; ++i )
                 drawString88( 0, i*8, message4x16[i] );
             break;
+        case kDisplayModeCPULoad:
+        {
+            char buff[32];
+            sprintf( buff, "CPU %3d%% PK %3d%%", cpuLoad.current / 10, cpuLoad.peak / 10 );
+            drawString88( 0, 0, buff );
+
+            // histogram below, scaled to the busiest bucket
+            unsigned int most = 1;
+            for ( i=0; i<kCPULoadHistogramSize; ++i )
+            {
+                if ( cpuLoad.histogram[i] > most )
+                    most = cpuLoad.histogram[i];
+            }
+            for ( i=0; i<kCPULoadHistogramSize; ++i )
+            {
+                int h = ( cpuLoad.histogram[i] * 24ULL ) / most;
+                if ( cpuLoad.histogram[i] && !h )
+                    h = 1;
+                if ( h )
+                    orScreen( i*11 + 1, i*11 + 9, 0xffffffff << ( 32 - h ) );
+            }
+            break;
+        }
+        case kDisplayModeDeadlines:
+        {
+            // the counts, then the latest event's task and lateness
+            const _audioDeadlines* d = &audioDeadlines;
+            char buff[32];
+            sprintf( buff, "LATE %11u", d->late );
+            drawString88( 0, 0, buff );
+            sprintf( buff, "MISSED %9u", d->missed );
+            drawString88( 0, 8, buff );
+            sprintf( buff, "OVERRUN %8u", d->overruns );
+            drawString88( 0, 16, buff );
+            if ( d->numEvents )
+            {
+                const _deadlineEvent* e = &d->events[ ( d->numEvents - 1 ) % kDeadlineEvents ];
+                const char* name = "-";
+                if ( e->kind == kDeadlineOverrun )
+                    name = "audio";
+                else if ( e->task < numTasks )
+                    name = tasks[ e->task ].name;
+                sprintf( buff, "%-10.10s%4uus", name, e->lateness / (unsigned int)( SYS_CLK_FREQ/2/1000000 ) );
+                drawString88( 0, 24, buff );
+            }
+            break;
+        }
     }            
 }
 
 void startupSequence()
 {
-    memset( screen, 0, sizeof screen );
+    memset( screenBuffers, 0, sizeof screenBuffers );
     copyToDisplay( screen );
+    displayInvalidate();
     delayMs( 17 );
 }
 
@@ -325,83 +512,29 @@ void displayMessage4x16( const char* msg1, const char* msg2, const char* msg3, c
 }
 
 void allowDisplayWrite(void)
+// the DMAs send the windows by themselves - this moves on to the next
+// window, or finishes the frame, once they have
 {
-    if ( displayBytesToSend > 0 )
-    {
-        while ( SPI5STATbits.SPITBF )
-            ;
-        SPI5BUF = ((const BYTE*)screen)[512-displayBytesToSend];
-#ifdef SPI1_IS_EXT_DISPLAY
-        while ( SPI1STATbits.SPITBF )
-            ;
-        SPI1BUF = ((const BYTE*)screen2ptr)[512-displayBytesToSend];
-#endif
-        displayBytesToSend -= 1;
-    }
+    if ( displayBytesToSend >= 0 && displayWriteDone() )
+        stepDisplayWrite();
 }
 
 void flushDisplayWrite(void)
 {
-    if ( displayBytesToSend >= 0 )
+    while ( displayBytesToSend >= 0 )
     {
-        while ( displayBytesToSend > 0 )
-        {
-            while ( SPI5STATbits.SPITBF )
-                ;
-            SPI5BUF = ((const BYTE*)screen)[512-displayBytesToSend];
-#ifdef SPI1_IS_EXT_DISPLAY
-            while ( SPI1STATbits.SPITBF )
-                ;
-            SPI1BUF = ((const BYTE*)screen2ptr)[512-displayBytesToSend];
-#endif
-            displayBytesToSend -= 1;
-        }
-        while ( SPI5STATbits.SPIBUSY )
+        while ( !displayWriteDone() )
             ;
-        // CS high
-        PORTASET = BIT_0;
-#ifdef SPI1_IS_EXT_DISPLAY
-        while ( SPI1STATbits.SPIBUSY )
-            ;
-        // CS high
-        PORTJSET = BIT_3;
-#endif
-        displayBytesToSend = -1;
+        stepDisplayWrite();
     }
 }
 
 void flushDisplayWriteWithAudioService(void)
 {
-    if ( displayBytesToSend >= 0 )
+    while ( displayBytesToSend >= 0 )
     {
-        while ( displayBytesToSend > 0 )
-        {
-#ifdef SPI1_IS_EXT_DISPLAY
-            while ( SPI5STATbits.SPITBF | SPI1STATbits.SPITBF )
-                CHECK_SERVICE_AUDIO_INTERNAL
-#else
-            while ( SPI5STATbits.SPITBF )
-                CHECK_SERVICE_AUDIO_INTERNAL
-#endif
-            SPI5BUF = ((const BYTE*)screen)[512-displayBytesToSend];
-#ifdef SPI1_IS_EXT_DISPLAY
-            SPI1BUF = ((const BYTE*)screen2ptr)[512-displayBytesToSend];
-#endif
-            displayBytesToSend -= 1;
-            CHECK_SERVICE_AUDIO_INTERNAL
-        }
-#ifdef SPI1_IS_EXT_DISPLAY
-        while ( SPI5STATbits.SPIBUSY | SPI1STATbits.SPIBUSY )
+        while ( !displayWriteDone() )
             CHECK_SERVICE_AUDIO_INTERNAL
-#else
-        while ( SPI5STATbits.SPIBUSY )
-            CHECK_SERVICE_AUDIO_INTERNAL
-#endif
-        // CS high
-        PORTASET = BIT_0;
-#ifdef SPI1_IS_EXT_DISPLAY
-        PORTJSET = BIT_3;
-#endif
-        displayBytesToSend = -1;
+        stepDisplayWrite();
     }
 }
@@ -25,13 +25,17 @@ SOFTWARE.
 #ifndef _DISPLAY_H
 #define _DISPLAY_H
 
+#include "scheduler.h"
+#include "text.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-extern unsigned int screen[128];
-extern unsigned int screen2[128];
-extern unsigned int *screen2ptr;
+extern unsigned int screenBuffers[2][128];
+// the back buffer, drawn on while the front goes to the displays
+extern unsigned int *screen;
+extern unsigned int *displayFront;
 
 extern int kTimeToBlank;
 extern int displayBlankCountdown;
@@ -42,9 +46,17 @@ extern char message4x16[4][17];
 enum {
 	kDisplayModeNormal,
     kDisplayModeMessage4x16,
+    kDisplayModeCPULoad,
+    kDisplayModeDeadlines,
 };
 extern char displayMode;
 
+// the text (see text.h) is offset and clipped to this window,
+// so that each algorithm in the dual mode draws in its own half
+extern int displayWindowX;
+extern int displayWindowWidth;
+void setDisplayWindow( int x, int width );
+
 void startupSequence(void);
 
 extern void copyToDisplay( const void* buffer );
@@ -70,6 +82,34 @@ extern void forceUpdateDisplay(void);
 extern void updateDisplay( void );
 extern void displayLoop( void );
 
+// for the scheduler (see scheduler.h) - the refresh draws the screen and
+// starts sending it, and the blank counts displayBlankCountdown down
+enum { kDisplayRefreshRate = 60 };
+enum { kDisplayBlankRate = 1 };
+_taskResult displayRefreshTask(void);
+_taskResult displayBlankTask(void);
+
+// the screen goes to the displays by DMA (channel 1, and 2 for the
+// external display) - set up once the SPIs are
+void setupDisplayDMAs(void);
+
+// Only the columns that have changed since the last frame are sent, as
+// windows set with the controllers' column (0x21) and page (0x22)
+// addresses. Windows closer than kDisplayWindowGap columns are merged,
+// since each costs six command bytes and a wait for the SPIs to go idle.
+enum { kMaxDisplayWindows = 4 };
+enum { kDisplayWindowGap = 4 };
+
+typedef struct {
+    BYTE    x0;
+    BYTE    x1;     // inclusive
+} _displayWindow;
+
+extern int displayBytesToSend;
+
+// for after something else has written to the displays - the next frame
+// is sent whole
+void displayInvalidate(void);
 void allowDisplayWrite(void);
 void flushDisplayWrite(void);
 void flushDisplayWriteWithAudioService(void);
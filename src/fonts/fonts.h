@@ -0,0 +1,373 @@
+// Generated by host/fontgen.c from codeman38_deluxefont/dlxfont.ttf.h
+// ('make fonts' in host/) - don't edit.
+
+static const unsigned int font8x8Columns[768] = {
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x5f, 0x5f, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x7, 0x7, 0x0, 0x7, 0x7, 0x0, 0x0,
+    0x14, 0x7f, 0x7f, 0x14, 0x7f, 0x7f, 0x14, 0x0,
+    0x24, 0x2e, 0x6b, 0x6b, 0x3a, 0x12, 0x0, 0x0,
+    0x46, 0x66, 0x30, 0x18, 0xc, 0x66, 0x62, 0x0,
+    0x30, 0x7a, 0x4f, 0x5d, 0x37, 0x7a, 0x48, 0x0,
+    0x4, 0x7, 0x3, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x1c, 0x3e, 0x63, 0x41, 0x0, 0x0, 0x0,
+    0x0, 0x41, 0x63, 0x3e, 0x1c, 0x0, 0x0, 0x0,
+    0x8, 0x2a, 0x3e, 0x1c, 0x1c, 0x3e, 0x2a, 0x8,
+    0x8, 0x8, 0x3e, 0x3e, 0x8, 0x8, 0x0, 0x0,
+    0x0, 0x80, 0xe0, 0x60, 0x0, 0x0, 0x0, 0x0,
+    0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x0, 0x0,
+    0x0, 0x0, 0x60, 0x60, 0x0, 0x0, 0x0, 0x0,
+    0x60, 0x30, 0x18, 0xc, 0x6, 0x3, 0x1, 0x0,
+    0x3e, 0x7f, 0x71, 0x59, 0x4d, 0x7f, 0x3e, 0x0,
+    0x0, 0x42, 0x7f, 0x7f, 0x40, 0x0, 0x0, 0x0,
+    0x61, 0x71, 0x59, 0x49, 0x4f, 0x46, 0x0, 0x0,
+    0x41, 0x41, 0x49, 0x49, 0x7f, 0x36, 0x0, 0x0,
+    0x18, 0x1c, 0x16, 0x13, 0x7f, 0x7f, 0x10, 0x0,
+    0x47, 0x47, 0x45, 0x45, 0x7d, 0x39, 0x0, 0x0,
+    0x3c, 0x7e, 0x4b, 0x49, 0x79, 0x31, 0x0, 0x0,
+    0x61, 0x71, 0x19, 0xd, 0x7, 0x3, 0x0, 0x0,
+    0x36, 0x7f, 0x49, 0x49, 0x7f, 0x36, 0x0, 0x0,
+    0x6, 0x4f, 0x49, 0x49, 0x7f, 0x3e, 0x0, 0x0,
+    0x0, 0x0, 0x66, 0x66, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x80, 0xe6, 0x66, 0x0, 0x0, 0x0, 0x0,
+    0x8, 0x1c, 0x36, 0x63, 0x41, 0x0, 0x0, 0x0,
+    0x24, 0x24, 0x24, 0x24, 0x24, 0x24, 0x0, 0x0,
+    0x0, 0x41, 0x63, 0x36, 0x1c, 0x8, 0x0, 0x0,
+    0x1, 0x1, 0x59, 0x59, 0xf, 0x6, 0x0, 0x0,
+    0x3e, 0x7f, 0x41, 0x5d, 0x5d, 0x1f, 0x1e, 0x0,
+    0x7c, 0x7e, 0x13, 0x13, 0x7e, 0x7c, 0x0, 0x0,
+    0x7f, 0x7f, 0x49, 0x49, 0x7f, 0x36, 0x0, 0x0,
+    0x3e, 0x7f, 0x41, 0x41, 0x41, 0x41, 0x0, 0x0,
+    0x7f, 0x7f, 0x41, 0x41, 0x7f, 0x3e, 0x0, 0x0,
+    0x7f, 0x7f, 0x49, 0x49, 0x49, 0x41, 0x0, 0x0,
+    0x7f, 0x7f, 0x9, 0x9, 0x9, 0x1, 0x0, 0x0,
+    0x3e, 0x7f, 0x41, 0x51, 0x71, 0x71, 0x0, 0x0,
+    0x7f, 0x7f, 0x8, 0x8, 0x7f, 0x7f, 0x0, 0x0,
+    0x0, 0x41, 0x7f, 0x7f, 0x41, 0x0, 0x0, 0x0,
+    0x40, 0x40, 0x40, 0x41, 0x7f, 0x3f, 0x1, 0x0,
+    0x7f, 0x7f, 0x8, 0x1c, 0x36, 0x63, 0x41, 0x0,
+    0x7f, 0x7f, 0x40, 0x40, 0x40, 0x40, 0x0, 0x0,
+    0x7f, 0x7f, 0x6, 0xc, 0x6, 0x7f, 0x7f, 0x0,
+    0x7f, 0x7f, 0x6, 0xc, 0x18, 0x7f, 0x7f, 0x0,
+    0x3e, 0x7f, 0x41, 0x41, 0x7f, 0x3e, 0x0, 0x0,
+    0x7f, 0x7f, 0x9, 0x9, 0xf, 0x6, 0x0, 0x0,
+    0x3e, 0x7f, 0x41, 0x21, 0x7f, 0x5e, 0x0, 0x0,
+    0x7f, 0x7f, 0x19, 0x39, 0x6f, 0x46, 0x0, 0x0,
+    0x46, 0x4f, 0x49, 0x49, 0x79, 0x31, 0x0, 0x0,
+    0x1, 0x1, 0x7f, 0x7f, 0x1, 0x1, 0x0, 0x0,
+    0x3f, 0x7f, 0x40, 0x40, 0x7f, 0x7f, 0x0, 0x0,
+    0x1f, 0x3f, 0x60, 0x60, 0x3f, 0x1f, 0x0, 0x0,
+    0x7f, 0x7f, 0x30, 0x18, 0x30, 0x7f, 0x7f, 0x0,
+    0x63, 0x77, 0x1c, 0x8, 0x1c, 0x77, 0x63, 0x0,
+    0x47, 0x4f, 0x48, 0x48, 0x7f, 0x3f, 0x0, 0x0,
+    0x61, 0x71, 0x59, 0x4d, 0x47, 0x43, 0x41, 0x0,
+    0x0, 0x7f, 0x7f, 0x41, 0x41, 0x0, 0x0, 0x0,
+    0x1, 0x3, 0x6, 0xc, 0x18, 0x30, 0x60, 0x0,
+    0x0, 0x41, 0x41, 0x7f, 0x7f, 0x0, 0x0, 0x0,
+    0x8, 0xc, 0x6, 0x3, 0x6, 0xc, 0x8, 0x0,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x0, 0x0, 0x3, 0x7, 0x4, 0x0, 0x0, 0x0,
+    0x24, 0x74, 0x54, 0x54, 0x7c, 0x78, 0x0, 0x0,
+    0x7f, 0x7f, 0x44, 0x44, 0x7c, 0x38, 0x0, 0x0,
+    0x38, 0x7c, 0x44, 0x44, 0x44, 0x44, 0x0, 0x0,
+    0x38, 0x7c, 0x44, 0x44, 0x7f, 0x7f, 0x0, 0x0,
+    0x38, 0x7c, 0x54, 0x54, 0x5c, 0x58, 0x0, 0x0,
+    0x8, 0x7e, 0x7f, 0x9, 0x9, 0x1, 0x0, 0x0,
+    0x98, 0xbc, 0xa4, 0xa4, 0xfc, 0x7c, 0x0, 0x0,
+    0x7f, 0x7f, 0x4, 0x4, 0x7c, 0x78, 0x0, 0x0,
+    0x0, 0x0, 0x7d, 0x7d, 0x0, 0x0, 0x0, 0x0,
+    0x80, 0x80, 0x80, 0xfd, 0x7d, 0x0, 0x0, 0x0,
+    0x7f, 0x7f, 0x10, 0x38, 0x6c, 0x44, 0x0, 0x0,
+    0x0, 0x1, 0x7f, 0x7f, 0x0, 0x0, 0x0, 0x0,
+    0x7c, 0x7c, 0x8, 0x18, 0x8, 0x7c, 0x7c, 0x0,
+    0x7c, 0x7c, 0x4, 0x4, 0x7c, 0x78, 0x0, 0x0,
+    0x38, 0x7c, 0x44, 0x44, 0x7c, 0x38, 0x0, 0x0,
+    0xfc, 0xfc, 0x44, 0x44, 0x7c, 0x38, 0x0, 0x0,
+    0x38, 0x7c, 0x44, 0x44, 0xfc, 0xfc, 0x0, 0x0,
+    0x7c, 0x7c, 0x8, 0x4, 0x4, 0x4, 0x0, 0x0,
+    0x48, 0x5c, 0x54, 0x54, 0x74, 0x24, 0x0, 0x0,
+    0x4, 0x3f, 0x7f, 0x44, 0x44, 0x44, 0x0, 0x0,
+    0x3c, 0x7c, 0x40, 0x40, 0x7c, 0x7c, 0x0, 0x0,
+    0x1c, 0x3c, 0x60, 0x60, 0x3c, 0x1c, 0x0, 0x0,
+    0x7c, 0x7c, 0x20, 0x30, 0x20, 0x7c, 0x7c, 0x0,
+    0x44, 0x6c, 0x38, 0x10, 0x38, 0x6c, 0x44, 0x0,
+    0x9c, 0xbc, 0xa0, 0xa0, 0xfc, 0x7c, 0x0, 0x0,
+    0x44, 0x64, 0x74, 0x5c, 0x4c, 0x44, 0x0, 0x0,
+    0x8, 0x8, 0x3e, 0x77, 0x41, 0x41, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x77, 0x77, 0x0, 0x0, 0x0,
+    0x41, 0x41, 0x77, 0x3e, 0x8, 0x8, 0x0, 0x0,
+    0x2, 0x3, 0x1, 0x3, 0x2, 0x3, 0x1, 0x0,
+    0x70, 0x78, 0x4c, 0x46, 0x4c, 0x78, 0x70, 0x0,
+};
+
+static const WORD font8x8Offsets[96] = {
+    0, 8, 16, 24, 32, 40, 48, 56, 64, 72, 80, 88,
+    96, 104, 112, 120, 128, 136, 144, 152, 160, 168, 176, 184,
+    192, 200, 208, 216, 224, 232, 240, 248, 256, 264, 272, 280,
+    288, 296, 304, 312, 320, 328, 336, 344, 352, 360, 368, 376,
+    384, 392, 400, 408, 416, 424, 432, 440, 448, 456, 464, 472,
+    480, 488, 496, 504, 512, 520, 528, 536, 544, 552, 560, 568,
+    576, 584, 592, 600, 608, 616, 624, 632, 640, 648, 656, 664,
+    672, 680, 688, 696, 704, 712, 720, 728, 736, 744, 752, 760,
+};
+
+static const BYTE font8x8Widths[96] = {
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+};
+
+static const unsigned int fontProportionalColumns[547] = {
+    0x0, 0x0, 0x0, 0x5f, 0x5f, 0x7, 0x7, 0x0,
+    0x7, 0x7, 0x14, 0x7f, 0x7f, 0x14, 0x7f, 0x7f,
+    0x14, 0x24, 0x2e, 0x6b, 0x6b, 0x3a, 0x12, 0x46,
+    0x66, 0x30, 0x18, 0xc, 0x66, 0x62, 0x30, 0x7a,
+    0x4f, 0x5d, 0x37, 0x7a, 0x48, 0x4, 0x7, 0x3,
+    0x1c, 0x3e, 0x63, 0x41, 0x41, 0x63, 0x3e, 0x1c,
+    0x8, 0x2a, 0x3e, 0x1c, 0x1c, 0x3e, 0x2a, 0x8,
+    0x8, 0x8, 0x3e, 0x3e, 0x8, 0x8, 0x80, 0xe0,
+    0x60, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x60,
+    0x60, 0x60, 0x30, 0x18, 0xc, 0x6, 0x3, 0x1,
+    0x3e, 0x7f, 0x71, 0x59, 0x4d, 0x7f, 0x3e, 0x42,
+    0x7f, 0x7f, 0x40, 0x61, 0x71, 0x59, 0x49, 0x4f,
+    0x46, 0x41, 0x41, 0x49, 0x49, 0x7f, 0x36, 0x18,
+    0x1c, 0x16, 0x13, 0x7f, 0x7f, 0x10, 0x47, 0x47,
+    0x45, 0x45, 0x7d, 0x39, 0x3c, 0x7e, 0x4b, 0x49,
+    0x79, 0x31, 0x61, 0x71, 0x19, 0xd, 0x7, 0x3,
+    0x36, 0x7f, 0x49, 0x49, 0x7f, 0x36, 0x6, 0x4f,
+    0x49, 0x49, 0x7f, 0x3e, 0x66, 0x66, 0x80, 0xe6,
+    0x66, 0x8, 0x1c, 0x36, 0x63, 0x41, 0x24, 0x24,
+    0x24, 0x24, 0x24, 0x24, 0x41, 0x63, 0x36, 0x1c,
+    0x8, 0x1, 0x1, 0x59, 0x59, 0xf, 0x6, 0x3e,
+    0x7f, 0x41, 0x5d, 0x5d, 0x1f, 0x1e, 0x7c, 0x7e,
+    0x13, 0x13, 0x7e, 0x7c, 0x7f, 0x7f, 0x49, 0x49,
+    0x7f, 0x36, 0x3e, 0x7f, 0x41, 0x41, 0x41, 0x41,
+    0x7f, 0x7f, 0x41, 0x41, 0x7f, 0x3e, 0x7f, 0x7f,
+    0x49, 0x49, 0x49, 0x41, 0x7f, 0x7f, 0x9, 0x9,
+    0x9, 0x1, 0x3e, 0x7f, 0x41, 0x51, 0x71, 0x71,
+    0x7f, 0x7f, 0x8, 0x8, 0x7f, 0x7f, 0x41, 0x7f,
+    0x7f, 0x41, 0x40, 0x40, 0x40, 0x41, 0x7f, 0x3f,
+    0x1, 0x7f, 0x7f, 0x8, 0x1c, 0x36, 0x63, 0x41,
+    0x7f, 0x7f, 0x40, 0x40, 0x40, 0x40, 0x7f, 0x7f,
+    0x6, 0xc, 0x6, 0x7f, 0x7f, 0x7f, 0x7f, 0x6,
+    0xc, 0x18, 0x7f, 0x7f, 0x3e, 0x7f, 0x41, 0x41,
+    0x7f, 0x3e, 0x7f, 0x7f, 0x9, 0x9, 0xf, 0x6,
+    0x3e, 0x7f, 0x41, 0x21, 0x7f, 0x5e, 0x7f, 0x7f,
+    0x19, 0x39, 0x6f, 0x46, 0x46, 0x4f, 0x49, 0x49,
+    0x79, 0x31, 0x1, 0x1, 0x7f, 0x7f, 0x1, 0x1,
+    0x3f, 0x7f, 0x40, 0x40, 0x7f, 0x7f, 0x1f, 0x3f,
+    0x60, 0x60, 0x3f, 0x1f, 0x7f, 0x7f, 0x30, 0x18,
+    0x30, 0x7f, 0x7f, 0x63, 0x77, 0x1c, 0x8, 0x1c,
+    0x77, 0x63, 0x47, 0x4f, 0x48, 0x48, 0x7f, 0x3f,
+    0x61, 0x71, 0x59, 0x4d, 0x47, 0x43, 0x41, 0x7f,
+    0x7f, 0x41, 0x41, 0x1, 0x3, 0x6, 0xc, 0x18,
+    0x30, 0x60, 0x41, 0x41, 0x7f, 0x7f, 0x8, 0xc,
+    0x6, 0x3, 0x6, 0xc, 0x8, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x3, 0x7, 0x4,
+    0x24, 0x74, 0x54, 0x54, 0x7c, 0x78, 0x7f, 0x7f,
+    0x44, 0x44, 0x7c, 0x38, 0x38, 0x7c, 0x44, 0x44,
+    0x44, 0x44, 0x38, 0x7c, 0x44, 0x44, 0x7f, 0x7f,
+    0x38, 0x7c, 0x54, 0x54, 0x5c, 0x58, 0x8, 0x7e,
+    0x7f, 0x9, 0x9, 0x1, 0x98, 0xbc, 0xa4, 0xa4,
+    0xfc, 0x7c, 0x7f, 0x7f, 0x4, 0x4, 0x7c, 0x78,
+    0x7d, 0x7d, 0x80, 0x80, 0x80, 0xfd, 0x7d, 0x7f,
+    0x7f, 0x10, 0x38, 0x6c, 0x44, 0x1, 0x7f, 0x7f,
+    0x7c, 0x7c, 0x8, 0x18, 0x8, 0x7c, 0x7c, 0x7c,
+    0x7c, 0x4, 0x4, 0x7c, 0x78, 0x38, 0x7c, 0x44,
+    0x44, 0x7c, 0x38, 0xfc, 0xfc, 0x44, 0x44, 0x7c,
+    0x38, 0x38, 0x7c, 0x44, 0x44, 0xfc, 0xfc, 0x7c,
+    0x7c, 0x8, 0x4, 0x4, 0x4, 0x48, 0x5c, 0x54,
+    0x54, 0x74, 0x24, 0x4, 0x3f, 0x7f, 0x44, 0x44,
+    0x44, 0x3c, 0x7c, 0x40, 0x40, 0x7c, 0x7c, 0x1c,
+    0x3c, 0x60, 0x60, 0x3c, 0x1c, 0x7c, 0x7c, 0x20,
+    0x30, 0x20, 0x7c, 0x7c, 0x44, 0x6c, 0x38, 0x10,
+    0x38, 0x6c, 0x44, 0x9c, 0xbc, 0xa0, 0xa0, 0xfc,
+    0x7c, 0x44, 0x64, 0x74, 0x5c, 0x4c, 0x44, 0x8,
+    0x8, 0x3e, 0x77, 0x41, 0x41, 0x77, 0x77, 0x41,
+    0x41, 0x77, 0x3e, 0x8, 0x8, 0x2, 0x3, 0x1,
+    0x3, 0x2, 0x3, 0x1, 0x70, 0x78, 0x4c, 0x46,
+    0x4c, 0x78, 0x70,
+};
+
+static const WORD fontProportionalOffsets[96] = {
+    0, 3, 5, 10, 17, 23, 30, 37, 40, 44, 48, 56,
+    62, 65, 71, 73, 80, 87, 91, 97, 103, 110, 116, 122,
+    128, 134, 140, 142, 145, 150, 156, 161, 167, 174, 180, 186,
+    192, 198, 204, 210, 216, 222, 226, 233, 240, 246, 253, 260,
+    266, 272, 278, 284, 290, 296, 302, 308, 315, 322, 328, 335,
+    339, 346, 350, 357, 365, 368, 374, 380, 386, 392, 398, 404,
+    410, 416, 418, 423, 429, 432, 439, 445, 451, 457, 463, 469,
+    475, 481, 487, 493, 500, 507, 513, 519, 525, 527, 533, 540,
+};
+
+static const BYTE fontProportionalWidths[96] = {
+    3, 2, 5, 7, 6, 7, 7, 3, 4, 4, 8, 6, 3, 6, 2, 7,
+    7, 4, 6, 6, 7, 6, 6, 6, 6, 6, 2, 3, 5, 6, 5, 6,
+    7, 6, 6, 6, 6, 6, 6, 6, 6, 4, 7, 7, 6, 7, 7, 6,
+    6, 6, 6, 6, 6, 6, 6, 7, 7, 6, 7, 4, 7, 4, 7, 8,
+    3, 6, 6, 6, 6, 6, 6, 6, 6, 2, 5, 6, 3, 7, 6, 6,
+    6, 6, 6, 6, 6, 6, 6, 7, 7, 6, 6, 6, 2, 6, 7, 7,
+};
+
+static const unsigned int fontLargeColumns[1094] = {
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x33ff, 0x33ff,
+    0x33ff, 0x33ff, 0x3f, 0x3f, 0x3f, 0x3f, 0x0, 0x0,
+    0x3f, 0x3f, 0x3f, 0x3f, 0x330, 0x330, 0x3fff, 0x3fff,
+    0x3fff, 0x3fff, 0x330, 0x330, 0x3fff, 0x3fff, 0x3fff, 0x3fff,
+    0x330, 0x330, 0xc30, 0xc30, 0xcfc, 0xcfc, 0x3ccf, 0x3ccf,
+    0x3ccf, 0x3ccf, 0xfcc, 0xfcc, 0x30c, 0x30c, 0x303c, 0x303c,
+    0x3c3c, 0x3c3c, 0xf00, 0xf00, 0x3c0, 0x3c0, 0xf0, 0xf0,
+    0x3c3c, 0x3c3c, 0x3c0c, 0x3c0c, 0xf00, 0xf00, 0x3fcc, 0x3fcc,
+    0x30ff, 0x30ff, 0x33f3, 0x33f3, 0xf3f, 0xf3f, 0x3fcc, 0x3fcc,
+    0x30c0, 0x30c0, 0x30, 0x30, 0x3f, 0x3f, 0xf, 0xf,
+    0x3f0, 0x3f0, 0xffc, 0xffc, 0x3c0f, 0x3c0f, 0x3003, 0x3003,
+    0x3003, 0x3003, 0x3c0f, 0x3c0f, 0xffc, 0xffc, 0x3f0, 0x3f0,
+    0xc0, 0xc0, 0xccc, 0xccc, 0xffc, 0xffc, 0x3f0, 0x3f0,
+    0x3f0, 0x3f0, 0xffc, 0xffc, 0xccc, 0xccc, 0xc0, 0xc0,
+    0xc0, 0xc0, 0xc0, 0xc0, 0xffc, 0xffc, 0xffc, 0xffc,
+    0xc0, 0xc0, 0xc0, 0xc0, 0xc000, 0xc000, 0xfc00, 0xfc00,
+    0x3c00, 0x3c00, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0,
+    0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0x3c00, 0x3c00,
+    0x3c00, 0x3c00, 0x3c00, 0x3c00, 0xf00, 0xf00, 0x3c0, 0x3c0,
+    0xf0, 0xf0, 0x3c, 0x3c, 0xf, 0xf, 0x3, 0x3,
+    0xffc, 0xffc, 0x3fff, 0x3fff, 0x3f03, 0x3f03, 0x33c3, 0x33c3,
+    0x30f3, 0x30f3, 0x3fff, 0x3fff, 0xffc, 0xffc, 0x300c, 0x300c,
+    0x3fff, 0x3fff, 0x3fff, 0x3fff, 0x3000, 0x3000, 0x3c03, 0x3c03,
+    0x3f03, 0x3f03, 0x33c3, 0x33c3, 0x30c3, 0x30c3, 0x30ff, 0x30ff,
+    0x303c, 0x303c, 0x3003, 0x3003, 0x3003, 0x3003, 0x30c3, 0x30c3,
+    0x30c3, 0x30c3, 0x3fff, 0x3fff, 0xf3c, 0xf3c, 0x3c0, 0x3c0,
+    0x3f0, 0x3f0, 0x33c, 0x33c, 0x30f, 0x30f, 0x3fff, 0x3fff,
+    0x3fff, 0x3fff, 0x300, 0x300, 0x303f, 0x303f, 0x303f, 0x303f,
+    0x3033, 0x3033, 0x3033, 0x3033, 0x3ff3, 0x3ff3, 0xfc3, 0xfc3,
+    0xff0, 0xff0, 0x3ffc, 0x3ffc, 0x30cf, 0x30cf, 0x30c3, 0x30c3,
+    0x3fc3, 0x3fc3, 0xf03, 0xf03, 0x3c03, 0x3c03, 0x3f03, 0x3f03,
+    0x3c3, 0x3c3, 0xf3, 0xf3, 0x3f, 0x3f, 0xf, 0xf,
+    0xf3c, 0xf3c, 0x3fff, 0x3fff, 0x30c3, 0x30c3, 0x30c3, 0x30c3,
+    0x3fff, 0x3fff, 0xf3c, 0xf3c, 0x3c, 0x3c, 0x30ff, 0x30ff,
+    0x30c3, 0x30c3, 0x30c3, 0x30c3, 0x3fff, 0x3fff, 0xffc, 0xffc,
+    0x3c3c, 0x3c3c, 0x3c3c, 0x3c3c, 0xc000, 0xc000, 0xfc3c, 0xfc3c,
+    0x3c3c, 0x3c3c, 0xc0, 0xc0, 0x3f0, 0x3f0, 0xf3c, 0xf3c,
+    0x3c0f, 0x3c0f, 0x3003, 0x3003, 0xc30, 0xc30, 0xc30, 0xc30,
+    0xc30, 0xc30, 0xc30, 0xc30, 0xc30, 0xc30, 0xc30, 0xc30,
+    0x3003, 0x3003, 0x3c0f, 0x3c0f, 0xf3c, 0xf3c, 0x3f0, 0x3f0,
+    0xc0, 0xc0, 0x3, 0x3, 0x3, 0x3, 0x33c3, 0x33c3,
+    0x33c3, 0x33c3, 0xff, 0xff, 0x3c, 0x3c, 0xffc, 0xffc,
+    0x3fff, 0x3fff, 0x3003, 0x3003, 0x33f3, 0x33f3, 0x33f3, 0x33f3,
+    0x3ff, 0x3ff, 0x3fc, 0x3fc, 0x3ff0, 0x3ff0, 0x3ffc, 0x3ffc,
+    0x30f, 0x30f, 0x30f, 0x30f, 0x3ffc, 0x3ffc, 0x3ff0, 0x3ff0,
+    0x3fff, 0x3fff, 0x3fff, 0x3fff, 0x30c3, 0x30c3, 0x30c3, 0x30c3,
+    0x3fff, 0x3fff, 0xf3c, 0xf3c, 0xffc, 0xffc, 0x3fff, 0x3fff,
+    0x3003, 0x3003, 0x3003, 0x3003, 0x3003, 0x3003, 0x3003, 0x3003,
+    0x3fff, 0x3fff, 0x3fff, 0x3fff, 0x3003, 0x3003, 0x3003, 0x3003,
+    0x3fff, 0x3fff, 0xffc, 0xffc, 0x3fff, 0x3fff, 0x3fff, 0x3fff,
+    0x30c3, 0x30c3, 0x30c3, 0x30c3, 0x30c3, 0x30c3, 0x3003, 0x3003,
+    0x3fff, 0x3fff, 0x3fff, 0x3fff, 0xc3, 0xc3, 0xc3, 0xc3,
+    0xc3, 0xc3, 0x3, 0x3, 0xffc, 0xffc, 0x3fff, 0x3fff,
+    0x3003, 0x3003, 0x3303, 0x3303, 0x3f03, 0x3f03, 0x3f03, 0x3f03,
+    0x3fff, 0x3fff, 0x3fff, 0x3fff, 0xc0, 0xc0, 0xc0, 0xc0,
+    0x3fff, 0x3fff, 0x3fff, 0x3fff, 0x3003, 0x3003, 0x3fff, 0x3fff,
+    0x3fff, 0x3fff, 0x3003, 0x3003, 0x3000, 0x3000, 0x3000, 0x3000,
+    0x3000, 0x3000, 0x3003, 0x3003, 0x3fff, 0x3fff, 0xfff, 0xfff,
+    0x3, 0x3, 0x3fff, 0x3fff, 0x3fff, 0x3fff, 0xc0, 0xc0,
+    0x3f0, 0x3f0, 0xf3c, 0xf3c, 0x3c0f, 0x3c0f, 0x3003, 0x3003,
+    0x3fff, 0x3fff, 0x3fff, 0x3fff, 0x3000, 0x3000, 0x3000, 0x3000,
+    0x3000, 0x3000, 0x3000, 0x3000, 0x3fff, 0x3fff, 0x3fff, 0x3fff,
+    0x3c, 0x3c, 0xf0, 0xf0, 0x3c, 0x3c, 0x3fff, 0x3fff,
+    0x3fff, 0x3fff, 0x3fff, 0x3fff, 0x3fff, 0x3fff, 0x3c, 0x3c,
+    0xf0, 0xf0, 0x3c0, 0x3c0, 0x3fff, 0x3fff, 0x3fff, 0x3fff,
+    0xffc, 0xffc, 0x3fff, 0x3fff, 0x3003, 0x3003, 0x3003, 0x3003,
+    0x3fff, 0x3fff, 0xffc, 0xffc, 0x3fff, 0x3fff, 0x3fff, 0x3fff,
+    0xc3, 0xc3, 0xc3, 0xc3, 0xff, 0xff, 0x3c, 0x3c,
+    0xffc, 0xffc, 0x3fff, 0x3fff, 0x3003, 0x3003, 0xc03, 0xc03,
+    0x3fff, 0x3fff, 0x33fc, 0x33fc, 0x3fff, 0x3fff, 0x3fff, 0x3fff,
+    0x3c3, 0x3c3, 0xfc3, 0xfc3, 0x3cff, 0x3cff, 0x303c, 0x303c,
+    0x303c, 0x303c, 0x30ff, 0x30ff, 0x30c3, 0x30c3, 0x30c3, 0x30c3,
+    0x3fc3, 0x3fc3, 0xf03, 0xf03, 0x3, 0x3, 0x3, 0x3,
+    0x3fff, 0x3fff, 0x3fff, 0x3fff, 0x3, 0x3, 0x3, 0x3,
+    0xfff, 0xfff, 0x3fff, 0x3fff, 0x3000, 0x3000, 0x3000, 0x3000,
+    0x3fff, 0x3fff, 0x3fff, 0x3fff, 0x3ff, 0x3ff, 0xfff, 0xfff,
+    0x3c00, 0x3c00, 0x3c00, 0x3c00, 0xfff, 0xfff, 0x3ff, 0x3ff,
+    0x3fff, 0x3fff, 0x3fff, 0x3fff, 0xf00, 0xf00, 0x3c0, 0x3c0,
+    0xf00, 0xf00, 0x3fff, 0x3fff, 0x3fff, 0x3fff, 0x3c0f, 0x3c0f,
+    0x3f3f, 0x3f3f, 0x3f0, 0x3f0, 0xc0, 0xc0, 0x3f0, 0x3f0,
+    0x3f3f, 0x3f3f, 0x3c0f, 0x3c0f, 0x303f, 0x303f, 0x30ff, 0x30ff,
+    0x30c0, 0x30c0, 0x30c0, 0x30c0, 0x3fff, 0x3fff, 0xfff, 0xfff,
+    0x3c03, 0x3c03, 0x3f03, 0x3f03, 0x33c3, 0x33c3, 0x30f3, 0x30f3,
+    0x303f, 0x303f, 0x300f, 0x300f, 0x3003, 0x3003, 0x3fff, 0x3fff,
+    0x3fff, 0x3fff, 0x3003, 0x3003, 0x3003, 0x3003, 0x3, 0x3,
+    0xf, 0xf, 0x3c, 0x3c, 0xf0, 0xf0, 0x3c0, 0x3c0,
+    0xf00, 0xf00, 0x3c00, 0x3c00, 0x3003, 0x3003, 0x3003, 0x3003,
+    0x3fff, 0x3fff, 0x3fff, 0x3fff, 0xc0, 0xc0, 0xf0, 0xf0,
+    0x3c, 0x3c, 0xf, 0xf, 0x3c, 0x3c, 0xf0, 0xf0,
+    0xc0, 0xc0, 0xc000, 0xc000, 0xc000, 0xc000, 0xc000, 0xc000,
+    0xc000, 0xc000, 0xc000, 0xc000, 0xc000, 0xc000, 0xc000, 0xc000,
+    0xc000, 0xc000, 0xf, 0xf, 0x3f, 0x3f, 0x30, 0x30,
+    0xc30, 0xc30, 0x3f30, 0x3f30, 0x3330, 0x3330, 0x3330, 0x3330,
+    0x3ff0, 0x3ff0, 0x3fc0, 0x3fc0, 0x3fff, 0x3fff, 0x3fff, 0x3fff,
+    0x3030, 0x3030, 0x3030, 0x3030, 0x3ff0, 0x3ff0, 0xfc0, 0xfc0,
+    0xfc0, 0xfc0, 0x3ff0, 0x3ff0, 0x3030, 0x3030, 0x3030, 0x3030,
+    0x3030, 0x3030, 0x3030, 0x3030, 0xfc0, 0xfc0, 0x3ff0, 0x3ff0,
+    0x3030, 0x3030, 0x3030, 0x3030, 0x3fff, 0x3fff, 0x3fff, 0x3fff,
+    0xfc0, 0xfc0, 0x3ff0, 0x3ff0, 0x3330, 0x3330, 0x3330, 0x3330,
+    0x33f0, 0x33f0, 0x33c0, 0x33c0, 0xc0, 0xc0, 0x3ffc, 0x3ffc,
+    0x3fff, 0x3fff, 0xc3, 0xc3, 0xc3, 0xc3, 0x3, 0x3,
+    0xc3c0, 0xc3c0, 0xcff0, 0xcff0, 0xcc30, 0xcc30, 0xcc30, 0xcc30,
+    0xfff0, 0xfff0, 0x3ff0, 0x3ff0, 0x3fff, 0x3fff, 0x3fff, 0x3fff,
+    0x30, 0x30, 0x30, 0x30, 0x3ff0, 0x3ff0, 0x3fc0, 0x3fc0,
+    0x3ff3, 0x3ff3, 0x3ff3, 0x3ff3, 0xc000, 0xc000, 0xc000, 0xc000,
+    0xc000, 0xc000, 0xfff3, 0xfff3, 0x3ff3, 0x3ff3, 0x3fff, 0x3fff,
+    0x3fff, 0x3fff, 0x300, 0x300, 0xfc0, 0xfc0, 0x3cf0, 0x3cf0,
+    0x3030, 0x3030, 0x3, 0x3, 0x3fff, 0x3fff, 0x3fff, 0x3fff,
+    0x3ff0, 0x3ff0, 0x3ff0, 0x3ff0, 0xc0, 0xc0, 0x3c0, 0x3c0,
+    0xc0, 0xc0, 0x3ff0, 0x3ff0, 0x3ff0, 0x3ff0, 0x3ff0, 0x3ff0,
+    0x3ff0, 0x3ff0, 0x30, 0x30, 0x30, 0x30, 0x3ff0, 0x3ff0,
+    0x3fc0, 0x3fc0, 0xfc0, 0xfc0, 0x3ff0, 0x3ff0, 0x3030, 0x3030,
+    0x3030, 0x3030, 0x3ff0, 0x3ff0, 0xfc0, 0xfc0, 0xfff0, 0xfff0,
+    0xfff0, 0xfff0, 0x3030, 0x3030, 0x3030, 0x3030, 0x3ff0, 0x3ff0,
+    0xfc0, 0xfc0, 0xfc0, 0xfc0, 0x3ff0, 0x3ff0, 0x3030, 0x3030,
+    0x3030, 0x3030, 0xfff0, 0xfff0, 0xfff0, 0xfff0, 0x3ff0, 0x3ff0,
+    0x3ff0, 0x3ff0, 0xc0, 0xc0, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x30c0, 0x30c0, 0x33f0, 0x33f0, 0x3330, 0x3330,
+    0x3330, 0x3330, 0x3f30, 0x3f30, 0xc30, 0xc30, 0x30, 0x30,
+    0xfff, 0xfff, 0x3fff, 0x3fff, 0x3030, 0x3030, 0x3030, 0x3030,
+    0x3030, 0x3030, 0xff0, 0xff0, 0x3ff0, 0x3ff0, 0x3000, 0x3000,
+    0x3000, 0x3000, 0x3ff0, 0x3ff0, 0x3ff0, 0x3ff0, 0x3f0, 0x3f0,
+    0xff0, 0xff0, 0x3c00, 0x3c00, 0x3c00, 0x3c00, 0xff0, 0xff0,
+    0x3f0, 0x3f0, 0x3ff0, 0x3ff0, 0x3ff0, 0x3ff0, 0xc00, 0xc00,
+    0xf00, 0xf00, 0xc00, 0xc00, 0x3ff0, 0x3ff0, 0x3ff0, 0x3ff0,
+    0x3030, 0x3030, 0x3cf0, 0x3cf0, 0xfc0, 0xfc0, 0x300, 0x300,
+    0xfc0, 0xfc0, 0x3cf0, 0x3cf0, 0x3030, 0x3030, 0xc3f0, 0xc3f0,
+    0xcff0, 0xcff0, 0xcc00, 0xcc00, 0xcc00, 0xcc00, 0xfff0, 0xfff0,
+    0x3ff0, 0x3ff0, 0x3030, 0x3030, 0x3c30, 0x3c30, 0x3f30, 0x3f30,
+    0x33f0, 0x33f0, 0x30f0, 0x30f0, 0x3030, 0x3030, 0xc0, 0xc0,
+    0xc0, 0xc0, 0xffc, 0xffc, 0x3f3f, 0x3f3f, 0x3003, 0x3003,
+    0x3003, 0x3003, 0x3f3f, 0x3f3f, 0x3f3f, 0x3f3f, 0x3003, 0x3003,
+    0x3003, 0x3003, 0x3f3f, 0x3f3f, 0xffc, 0xffc, 0xc0, 0xc0,
+    0xc0, 0xc0, 0xc, 0xc, 0xf, 0xf, 0x3, 0x3,
+    0xf, 0xf, 0xc, 0xc, 0xf, 0xf, 0x3, 0x3,
+    0x3f00, 0x3f00, 0x3fc0, 0x3fc0, 0x30f0, 0x30f0, 0x303c, 0x303c,
+    0x30f0, 0x30f0, 0x3fc0, 0x3fc0, 0x3f00, 0x3f00,
+};
+
+static const WORD fontLargeOffsets[96] = {
+    0, 6, 10, 20, 34, 46, 60, 74, 80, 88, 96, 112,
+    124, 130, 142, 146, 160, 174, 182, 194, 206, 220, 232, 244,
+    256, 268, 280, 284, 290, 300, 312, 322, 334, 348, 360, 372,
+    384, 396, 408, 420, 432, 444, 452, 466, 480, 492, 506, 520,
+    532, 544, 556, 568, 580, 592, 604, 616, 630, 644, 656, 670,
+    678, 692, 700, 714, 730, 736, 748, 760, 772, 784, 796, 808,
+    820, 832, 836, 846, 858, 864, 878, 890, 902, 914, 926, 938,
+    950, 962, 974, 986, 1000, 1014, 1026, 1038, 1050, 1054, 1066, 1080,
+};
+
+static const BYTE fontLargeWidths[96] = {
+    6, 4, 10, 14, 12, 14, 14, 6, 8, 8, 16, 12, 6, 12, 4, 14,
+    14, 8, 12, 12, 14, 12, 12, 12, 12, 12, 4, 6, 10, 12, 10, 12,
+    14, 12, 12, 12, 12, 12, 12, 12, 12, 8, 14, 14, 12, 14, 14, 12,
+    12, 12, 12, 12, 12, 12, 12, 14, 14, 12, 14, 8, 14, 8, 14, 16,
+    6, 12, 12, 12, 12, 12, 12, 12, 12, 4, 10, 12, 6, 14, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 14, 14, 12, 12, 12, 4, 12, 14, 14,
+};
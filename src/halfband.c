@@ -0,0 +1,138 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+
+Polyphase half-band interpolator and decimator.
+
+The coefficients are Kaiser windowed sinc designs, in Q31, for the non-zero
+taps on one side of the centre, innermost first. They're scaled by two
+(the interpolator's gain) and sum to exactly one half, so DC passes unchanged.
+The centre tap is always one half, and is applied with a shift.
+
+Each filter is a 32x32 to 64 bit multiply-accumulate per pair of taps,
+the symmetric pairs of samples being added first; on the PIC32MZ these are
+madd instructions into the DSP accumulators.
+
+The history is stored twice, so the filter window never wraps.
+
+*/
+#include <stdint.h>
+#include "halfband.h"
+
+static const int coefs7[2] = {
+    1533456996, -459715172
+};
+static const int coefs11[3] = {
+    1238932874, -412977625, 247786575
+};
+static const int coefs15[4] = {
+    1396935917, -425073465, 210144101, -108264729
+};
+static const int coefs19[5] = {
+    1325679241, -414133401, 217090318, -124677340, 69783006
+};
+static const int coefs23[6] = {
+    1367212543, -424465214, 219772653, -123936996, 67797699, -32638861
+};
+static const int coefs27[7] = {
+    1349446607, -424407334, 225963977, -133712472, 79299998, -44270340, 21421388
+};
+static const int coefs31[8] = {
+    1360077273, -427678749, 227753475, -135038162, 80640379, -45908601, 23492803, -9596594
+};
+
+static const int* const coefTables[ kHalfbandMaxPairs - kHalfbandMinPairs + 1 ] = {
+    coefs7, coefs11, coefs15, coefs19, coefs23, coefs27, coefs31
+};
+
+int     halfbandInit( _halfband* h, int taps )
+{
+    int pairs = ( taps + 1 ) / 4;
+    if ( taps != 4 * pairs - 1 || pairs < kHalfbandMinPairs || pairs > kHalfbandMaxPairs )
+        return -1;
+    h->coefs = coefTables[ pairs - kHalfbandMinPairs ];
+    h->pairs = pairs;
+    h->pos = 0;
+    int i;
+    for ( i=0; i<sizeof h->history/sizeof h->history[0]; ++i )
+        h->history[i] = 0;
+    return 0;
+}
+
+void    halfbandInterpolate( _halfband* h, const int* in, int* out, int count )
+{
+    const int* g = h->coefs;
+    const int P = h->pairs;
+    const int N = 2 * P;
+    int* history = h->history;
+    int pos = h->pos;
+    int i, k;
+    for ( i=0; i<count; ++i )
+    {
+        // x[0] is the newest sample
+        pos = ( pos ? pos : N ) - 1;
+        history[ pos ] = history[ pos + N ] = in[i];
+        const int* x = &history[ pos ];
+
+        // the even phase is the filter, the odd phase is just the centre tap
+        int64_t acc = 1 << 30;
+        for ( k=0; k<P; ++k )
+            acc += (int64_t)g[k] * ( x[ P-1-k ] + x[ P+k ] );
+        out[ 2*i+0 ] = acc >> 31;
+        out[ 2*i+1 ] = x[ P-1 ];
+    }
+    h->pos = pos;
+}
+
+void    halfbandDecimate( _halfband* h, const int* in, int* out, int count )
+{
+    const int* g = h->coefs;
+    const int P = h->pairs;
+    const int N = 4 * P;
+    const int c = 2 * P - 1;
+    int* history = h->history;
+    int pos = h->pos;
+    int i, k;
+    for ( i=0; i<count; ++i )
+    {
+        pos = ( pos ? pos : N ) - 1;
+        history[ pos ] = history[ pos + N ] = in[ 2*i+0 ];
+        pos = ( pos ? pos : N ) - 1;
+        history[ pos ] = history[ pos + N ] = in[ 2*i+1 ];
+        const int* x = &history[ pos ];
+
+        // the coefficients are twice the filter's, hence the extra shift
+        int64_t acc = ( (int64_t)x[c] << 31 ) + ( 1LL << 31 );
+        for ( k=0; k<P; ++k )
+            acc += (int64_t)g[k] * ( x[ c-1-2*k ] + x[ c+1+2*k ] );
+        out[i] = acc >> 32;
+    }
+    h->pos = pos;
+}
+
+int     halfbandLatency( const _halfband* h )
+{
+    return 2 * h->pairs - 1;
+}
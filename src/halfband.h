@@ -0,0 +1,68 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef _HALFBAND_H    /* Guard against multiple inclusion */
+#define _HALFBAND_H
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Polyphase half-band filters, for converting between 48kHz and 96kHz.
+// Samples are 32 bit integers, which must leave one bit of headroom
+// (24 bit codec samples or 16 bit Peaks samples are fine).
+//
+// The filters have 4n-1 taps, of which only the centre and n either side
+// are non-zero, for n from kHalfbandMinPairs to kHalfbandMaxPairs
+// (7 to 31 taps).
+
+enum { kHalfbandMinPairs = 2 };
+enum { kHalfbandMaxPairs = 8 };
+
+typedef struct {
+    const int*  coefs;
+    int         pairs;
+    int         pos;
+    int         history[ 2 * 4 * kHalfbandMaxPairs ];
+} _halfband;
+
+// returns 0, or -1 if there's no filter with that many taps
+int     halfbandInit( _halfband* h, int taps );
+
+// count samples in, 2*count samples out
+void    halfbandInterpolate( _halfband* h, const int* in, int* out, int count );
+
+// 2*count samples in, count samples out
+void    halfbandDecimate( _halfband* h, const int* in, int* out, int count );
+
+// delay, in samples at the higher rate
+int     halfbandLatency( const _halfband* h );
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HALFBAND_H */
@@ -28,6 +28,8 @@ SOFTWARE.
 #include "peripheral/int/plib_int.h"
 #include "i2c.h"
 #include "display.h"
+#include "algorithm.h"
+#include "trace.h"
 
 #define GetSystemClock()           (SYS_CLK_FREQ)
 #define GetPeripheralClock()       (SYS_CLK_BUS_PERIPHERAL_2)
@@ -511,11 +513,13 @@ void __ISR(_I2C4_SLAVE_VECTOR, ipl3srs) I2C4SlaveInterruptHandler(void)
             // read, not write
             if ( i2cResponseIndex < i2cResponseSize )
             {
+                TRACE( kTraceI2COut, i2cResponse[ i2cResponseIndex ] );
                 I2C4TRN = i2cResponse[ i2cResponseIndex++ ];
                 I2C4CONSET = BIT_12;        // SCLREL
             }
             else
             {
+                TRACE( kTraceI2COut, 0x100 );
                 I2C4CONCLR = BIT_15;
                 asm volatile ( "nop" );
                 asm volatile ( "nop" );
@@ -528,6 +532,7 @@ void __ISR(_I2C4_SLAVE_VECTOR, ipl3srs) I2C4SlaveInterruptHandler(void)
             if ( i2cRxQueueRead == i2cRxQueueWrite )
             {
                 // queue overflow
+                TRACE( kTraceOverflow, kTraceQueueI2CIn );
             }
             else
             {
@@ -541,11 +546,13 @@ void __ISR(_I2C4_SLAVE_VECTOR, ipl3srs) I2C4SlaveInterruptHandler(void)
             if ( !I2C4STATbits.D_A )
             {
                 // address received
+                TRACE( kTraceI2CAddress, data );
                 {
                     // byte received
                     if ( i2cRxQueueRead == i2cRxQueueWrite )
                     {
                         // queue overflow
+                        TRACE( kTraceOverflow, kTraceQueueI2CIn );
                     }
                     else
                     {
@@ -556,11 +563,13 @@ void __ISR(_I2C4_SLAVE_VECTOR, ipl3srs) I2C4SlaveInterruptHandler(void)
             }
             else
             {
+                TRACE( kTraceI2CIn, data );
                 {
                     // byte received
                     if ( i2cRxQueueRead == i2cRxQueueWrite )
                     {
                         // queue overflow
+                        TRACE( kTraceOverflow, kTraceQueueI2CIn );
                     }
                     else
                     {
@@ -681,9 +690,11 @@ void ProcessI2C3byteCommand(void)
     }
     else if ( cmd == kI2C_dual_load_algorithm )
     {
+        requestDualAlgorithm( i2cMsg[1], i2cMsg[2] );
     }
     else if ( cmd == kI2C_dual_load_algorithms )
     {
+        requestDualAlgorithms( i2cMsg[1], i2cMsg[2] );
     }
     else if ( cmd >= kI2C_dual_load_preset && cmd <= kI2C_dual_takeover_z )
     {
@@ -698,12 +709,19 @@ void ProcessI2C2byteCommand(void)
     int cmd = i2cMsg[0];
     if ( ( cmd == kI2C_voice_note_off )
         || ( cmd == kI2C_note_off )
-        || ( cmd >= kI2C_WAV_Recorder_record && cmd <= kI2C_WAV_Recorder_play )
-        || ( cmd == kI2C_Looper_get_state ) ) 
+        || ( cmd >= kI2C_WAV_Recorder_record && cmd <= kI2C_WAV_Recorder_play ) ) 
     {
     }
+    else if ( cmd == kI2C_Looper_get_state )
+    {
+        int state = algorithm_looperState( i2cMsg[1] );
+        i2cResponse[0] = ( state < 0 ) ? 0 : state;
+        i2cResponseIndex = 0;
+        i2cResponseSize = 1;
+    }
     else if ( cmd == kI2C_load_algorithm )
     {
+        requestAlgorithm( i2cMsg[1] );
     }
     else if ( cmd >= kI2C_get_parameter_value && cmd <= kI2C_get_parameter_max )
     {
@@ -719,6 +737,10 @@ void ProcessI2C2byteCommand(void)
     }
     else if ( cmd == kI2C_dual_get_current_algorithm )
     {
+        i2cResponse[0] = algorithm_currentInSlot( i2cMsg[1] );
+        i2cResponseIndex = 0;
+        // nothing for a slot that doesn't exist
+        i2cResponseSize = ( i2cMsg[1] < kNumAlgorithmSlots ) ? 1 : 0;
     }
 }
 
@@ -726,10 +748,13 @@ void ProcessI2C1byteCommand(void)
 {
     int cmd = i2cMsg[0];
     if ( ( cmd == kI2C_all_notes_off )
-        || ( cmd == kI2C_Augustus_Loop_send_clock )
-        || ( cmd == kI2C_Looper_clear ) )
+        || ( cmd == kI2C_Augustus_Loop_send_clock ) )
     {
     }    
+    else if ( cmd == kI2C_Looper_clear )
+    {
+        algorithm_looperClear();
+    }
     else if ( cmd == kI2C_reset_preset )
     {
     }
@@ -742,15 +767,15 @@ void ProcessI2C1byteCommand(void)
     }
     else if ( cmd == kI2C_get_current_algorithm )
     {
-        i2cResponse[0] = 1;
+        i2cResponse[0] = algorithm_current();
         i2cResponseIndex = 0;
         i2cResponseSize = 1;
     }
     else if ( cmd == kI2C_dual_get_current_algorithms )
     {
         {
-            i2cResponse[0] = 0;
-            i2cResponse[1] = 0;
+            i2cResponse[0] = algorithm_currentInSlot( 0 );
+            i2cResponse[1] = algorithm_currentInSlot( 1 );
             i2cResponseIndex = 0;
             i2cResponseSize = 2;
         }
@@ -28,7 +28,14 @@ SOFTWARE.
 #include <math.h>
 
 #include "app.h"
+#include "algorithm.h"
+#include "cpuload.h"
 #include "display.h"
+#include "profile.h"
+#include "trace.h"
+#include "scheduler.h"
+#include "sram.h"
+#include "sramtest.h"
 
 int ProcessMIDI( BYTE b );
 
@@ -184,7 +191,7 @@ int DefaultMIDIMessageHandler( BYTE status, BYTE channel, const BYTE* message )
     return ret;
 }
 
-void sendBytes( int code, const BYTE* ptr, int count )
+void sendSysExStart( int code )
 {
     flushDisplayWrite();
     
@@ -192,13 +199,24 @@ void sendBytes( int code, const BYTE* ptr, int count )
     int i;
     for ( i=0; i<sizeof header; ++i )
         BlockingQueueMIDI1( header[i] );
+}
+
+void sendSysExEnd(void)
+{
+    BlockingQueueMIDI1( 0xF7 );
+}
+
+void sendBytes( int code, const BYTE* ptr, int count )
+{
+    sendSysExStart( code );
     
+    int i;
     for ( i=0; i<count; ++i )
     {
         BlockingQueueMIDI1( ptr[i] & 0x7f );
     }
     
-    BlockingQueueMIDI1( 0xF7 );
+    sendSysExEnd();
 }
 
 void sendSysExMsg( const char* str )
@@ -298,21 +316,120 @@ void ProcessNativeSysEx( const BYTE* sysex, int sysexCount )
         case 0x60:
             // algorithm specific message
             break;
+#ifdef PROFILE_REGIONS
+        case 0x61:
+            // request the profiled regions' timings, optionally resetting them
+            profileSendSysEx();
+            if ( sysexCount > 8 && msg[0] == 1 )
+                profileReset();
+            break;
+#endif
+#ifdef EVENT_TRACE
+        case 0x62:
+            // event trace - 0 to stop, 1 to start, 2 to start and stop after
+            // an overflow, 3 to dump the latest events (a count, 14 bits, MS first)
+            if ( sysexCount > 8 )
+                traceCommand( msg[0], ( sysexCount > 10 ) ? ( ( msg[1] << 7 ) | msg[2] ) : 0 );
+            break;
+#endif
+        case 0x63:
+            // request the audio's late, missed and overrun blocks, optionally resetting them
+            cpuLoadSendDeadlineSysEx();
+            if ( sysexCount > 8 && msg[0] == 1 )
+                cpuLoadDeadlineReset();
+            break;
+        case 0x70:
+            // set audio block size
+            if ( sysexCount > 8 )
+                requestFramesPerBlock( msg[0] );
+            break;
         case 0x71:
             // request screen as chars
             break;
+        case 0x72:
+            // request CPU load
+            cpuLoadSendSysEx();
+            if ( sysexCount > 8 && msg[0] == 1 )
+                cpuLoadReset();
+            break;
         case 0x73:
             // request parameter name
             break;
         case 0x74:
             // request parameter value
             break;
+        case 0x75:
+            // show CPU load (1) or the audio's deadlines (2)
+            if ( sysexCount > 8 )
+            {
+                if ( msg[0] == 2 )
+                    displayMode = kDisplayModeDeadlines;
+                else
+                    displayMode = msg[0] ? kDisplayModeCPULoad : kDisplayModeNormal;
+            }
+            break;
+        case 0x76:
+            // benchmark audio buffers
+            requestAudioBufferBenchmark();
+            break;
         case 0x77:
             // text entry
             break;
         case 0x78:
             // remote control
             break;
+        case 0x79:
+            // request slot loads, optionally setting the budgets (in percent) first
+            if ( sysexCount > 9 )
+            {
+                cpuLoadSetSlotBudget( 0, msg[0] * 10 );
+                cpuLoadSetSlotBudget( 1, msg[1] * 10 );
+            }
+            cpuLoadSendSlotSysEx();
+            break;
+        case 0x7A:
+            // set slot routing: slot, 0 for an input or 1 for an output,
+            // the algorithm's input/output, the module's (0x7f for none)
+            if ( sysexCount > 11 && msg[0] < kNumAlgorithmSlots )
+            {
+                _algorithmRouting* r = &algorithmRouting[ msg[0] ];
+                BYTE channel = ( msg[3] == 0x7f ) ? kRouteNone : msg[3];
+                if ( msg[1] == 0 && msg[2] < 6 && ( channel < 6 || channel == kRouteNone ) )
+                    r->input[ msg[2] ] = channel;
+                else if ( msg[1] == 1 && msg[2] < 4 && ( channel < 4 || channel == kRouteNone ) )
+                    r->output[ msg[2] ] = channel;
+            }
+            break;
+        case 0x7B:
+            // set the algorithm crossfade length, in blocks (14 bits, MS first)
+            if ( sysexCount > 9 )
+                algorithm_setCrossfadeBlocks( ( msg[0] << 7 ) | msg[1] );
+            break;
+        case 0x7C:
+            // request scheduler task stats, optionally resetting them
+            schedulerSendSysEx();
+            if ( sysexCount > 8 && msg[0] == 1 )
+                schedulerResetStats();
+            break;
+        case 0x7D:
+            // request external SRAM usage
+            sramSendSysEx();
+            break;
+        case 0x7E:
+            // benchmark the external SRAM
+            requestSRAMBenchmark();
+            break;
+        case 0x7F:
+            // external SRAM march test - 1 to start, 0 to stop, then report
+            if ( sysexCount > 8 )
+            {
+                if ( msg[0] )
+                    sramTestStart();
+                else
+                    sramTestStop();
+            }
+            sramTestSendSysEx();
+            break;
     }
 }
 
@@ -397,6 +514,15 @@ int QueueMIDI1( BYTE b )
     return 1;
 }
 
+int MIDIOutQueueSpace(void)
+// the bytes that will go in without blocking
+{
+    int n = midiQueueReadPos - midiQueueWritePos;
+    if ( n < 0 )
+        n += kMidiQueueSize;
+    return n;
+}
+
 void BlockingQueueMIDI1( BYTE b )
 {
     for ( ;; )
@@ -491,6 +617,7 @@ int HandleMIDIOut()
 	BYTE b = midiQueue[ nextRead ];
 
     U4TXREG = b;
+    TRACE( kTraceMIDIOut, b );
     
     return 1;
 }
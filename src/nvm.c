@@ -43,14 +43,18 @@ You can execute code from one page while writing to the other page without stall
 
 */
 #include "nvm.h"
+#include "profile.h"
+#include "trace.h"
 
 #include "peripheral/nvm/plib_nvm.h"
 
 unsigned int NVMUnlock (unsigned int nvmop)
 {
+    PROFILE_BEGIN( kProfileNVMWrite );
+    TRACE( kTraceNVMStart, nvmop );
     unsigned int status;
     // Suspend or Disable all Interrupts
-    asm volatile ("di %0" : "=r" (status));
+    status = __builtin_disable_interrupts();
 
     // disable audio SPI
     SPI3CONCLR = BIT_15;
@@ -89,11 +93,11 @@ unsigned int NVMUnlock (unsigned int nvmop)
     // Restore Interrupts
     if ( status & 0x00000001 )
     {
-        asm volatile ("ei %0" : "=r" (status));
+        status = __builtin_enable_interrupts();
     }
     else
     {
-        asm volatile ("di %0" : "=r" (status));
+        status = __builtin_disable_interrupts();
     }
 
     // enable audio SPI
@@ -103,6 +107,8 @@ unsigned int NVMUnlock (unsigned int nvmop)
 
     // Disable NVM write enable
     NVMCONCLR = 0x0004000;
+    TRACE( kTraceNVMEnd, 0 );
+    PROFILE_END( kProfileNVMWrite );
     // Return WRERR and LVDERR Error Status Bits
     return (NVMCON & 0x3000);
 }
@@ -137,9 +143,11 @@ void NVMWriteRow( void* ptr, const DWORD* data )
 
 unsigned int NVMOpWithAudioService( unsigned int nvmop )
 {
+    PROFILE_BEGIN( kProfileNVMWriteAudio );
+    TRACE( kTraceNVMStart, nvmop );
     unsigned int status;
     // Suspend or Disable all Interrupts
-    asm volatile ( "di %0" : "=r" (status) );
+    status = __builtin_disable_interrupts();
     
     // Disable DMA
     int dma_susp;
@@ -168,7 +176,7 @@ unsigned int NVMOpWithAudioService( unsigned int nvmop )
     // Restore Interrupts
     if ( status & 0x00000001 )
     {
-        asm volatile ( "ei %0" : "=r" (status) );
+        status = __builtin_enable_interrupts();
     }
 
     // Wait for operation to complete
@@ -179,6 +187,8 @@ unsigned int NVMOpWithAudioService( unsigned int nvmop )
 
     // Disable NVM write enable
     NVMCONCLR = 0x0004000;
+    TRACE( kTraceNVMEnd, 0 );
+    PROFILE_END( kProfileNVMWriteAudio );
 
     // Return WRERR and LVDERR Error Status Bits
     return (NVMCON & 0x3000);
@@ -0,0 +1,88 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+
+Where the cycles go, on a live module without a debugger (see profile.h).
+The regions are timed around their calls, in app.c, display.c and nvm.c.
+
+*/
+#include "profile.h"
+
+#ifdef PROFILE_REGIONS
+
+_profileStats profileStats[kNumProfileRegions];
+
+static const char* const profileNames[kNumProfileRegions] = {
+    "ADCs",
+    "algorithm",
+    "MIDI in",
+    "MIDI out",
+    "UI",
+    "display",
+    "NVM",
+    "NVM audio",
+};
+
+void    profileReset(void)
+{
+    // so the audio doesn't record into a half cleared region
+    unsigned int status = __builtin_disable_interrupts();
+    memset( profileStats, 0, sizeof profileStats );
+    if ( status & 1 )
+        __builtin_enable_interrupts();
+}
+
+void    profileSendSysEx(void)
+// the histogram size, then for each region, its name (0 terminated), count,
+// and min, mean and max in system clock cycles, then its histogram - bucket i
+// counts the times of 2^(i+1) cycles and more - all as 28 bit values
+{
+    enum { kMaxName = 12 };
+    BYTE buff[ 1 + kNumProfileRegions * ( kMaxName + 1 + 4*4 + kProfileHistogramSize*4 ) ];
+    BYTE* p = buff;
+    int i, j;
+    *p++ = kProfileHistogramSize;
+    for ( i=0; i<kNumProfileRegions; ++i )
+    {
+        // a copy, since the audio may be adding to it
+        unsigned int status = __builtin_disable_interrupts();
+        _profileStats s = profileStats[i];
+        if ( status & 1 )
+            __builtin_enable_interrupts();
+
+        for ( j=0; j<kMaxName && profileNames[i][j]; ++j )
+            *p++ = profileNames[i][j] & 0x7f;
+        *p++ = 0;
+        p = put28( p, s.count );
+        p = put28( p, 2 * s.min );
+        p = put28( p, s.count ? 2 * (unsigned int)( s.total / s.count ) : 0 );
+        p = put28( p, 2 * s.max );
+        for ( j=0; j<kProfileHistogramSize; ++j )
+            p = put28( p, s.histogram[j] );
+    }
+    sendBytes( 0x61, buff, p - buff );
+}
+
+#endif
@@ -0,0 +1,104 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef _PROFILE_H    /* Guard against multiple inclusion */
+#define _PROFILE_H
+
+#include "app.h"
+#include "cpuload.h"
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Named regions of the firmware's hot paths, timed with the core timer
+// when PROFILE_REGIONS is defined. The default_4_0 build configuration
+// defines it; the release (for_bootloader) build doesn't, and then
+// PROFILE_BEGIN() and PROFILE_END() compile to nothing.
+//
+// Each region keeps its count, min, total and max in core timer ticks,
+// and a histogram by powers of two. SysEx message 0x61 reports them.
+
+typedef enum {
+    kProfileADCs,               // readAndTriggerADCs()
+    kProfileAlgorithmStep,      // algorithm_step()
+    kProfileMIDIRx,             // FlushMIDIRx()
+    kProfileMIDIOut,            // HandleMIDIOut()
+    kProfileUI,                 // algorithm_UI()
+    kProfileDisplay,            // updateDisplay()
+    kProfileNVMWrite,           // NVMUnlock(), for an erase or write
+    kProfileNVMWriteAudio,      // NVMOpWithAudioService()
+    kNumProfileRegions
+} _profileRegion;
+
+// bucket i for times of 2^i ticks and more, the last for everything over
+enum { kProfileHistogramSize = 24 };
+
+typedef struct {
+    unsigned int    count;
+    unsigned int    min;
+    unsigned int    max;
+    uint64_t        total;
+    unsigned int    histogram[kProfileHistogramSize];
+} _profileStats;
+
+#ifdef PROFILE_REGIONS
+
+extern _profileStats profileStats[kNumProfileRegions];
+
+void    profileReset(void);
+void    profileSendSysEx(void);
+
+static inline __attribute__((always_inline)) void profileRecord( _profileRegion r, unsigned int ticks )
+{
+    _profileStats* s = &profileStats[r];
+    int b = ticks ? 31 - __builtin_clz( ticks ) : 0;
+    if ( b >= kProfileHistogramSize )
+        b = kProfileHistogramSize - 1;
+    s->histogram[b] += 1;
+    if ( !s->count || ticks < s->min )
+        s->min = ticks;
+    if ( ticks > s->max )
+        s->max = ticks;
+    s->total += ticks;
+    s->count += 1;
+}
+
+#define PROFILE_BEGIN( r )      unsigned int profileStart_##r = cpuLoadTicks()
+#define PROFILE_END( r )        profileRecord( r, cpuLoadTicks() - profileStart_##r )
+
+#else
+
+#define PROFILE_BEGIN( r )
+#define PROFILE_END( r )
+
+#endif
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PROFILE_H */
@@ -0,0 +1,159 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "scheduler.h"
+#include "cpuload.h"
+
+_task tasks[kMaxTasks];
+int numTasks = 0;
+volatile int schedulerCurrentTask = -1;
+
+void    schedulerInit(void)
+{
+    memset( tasks, 0, sizeof tasks );
+    numTasks = 0;
+}
+
+int     schedulerAddTask( const char* name, _taskFunction function, _taskRate rateType, int rate, int budgetUs, int priority )
+{
+    if ( numTasks >= kMaxTasks || rate < 1 )
+        return -1;
+    _task* t = &tasks[ numTasks ];
+    memset( t, 0, sizeof *t );
+    t->name = name;
+    t->function = function;
+    t->rateType = rateType;
+    t->priority = priority;
+    t->rate = rate;
+    t->countdown = ( rateType == kRateHz ) ? SAMPLE_RATE : rate;
+    t->budget = budgetUs * ( SYS_CLK_FREQ/2/1000000 );
+    return numTasks++;
+}
+
+void    schedulerTick( int frames )
+{
+    int i;
+    for ( i=0; i<numTasks; ++i )
+    {
+        _task* t = &tasks[i];
+        int period;
+        if ( t->rateType == kRateHz )
+        {
+            // counting in 1/rate frames, so there's no rounding
+            t->countdown -= frames * t->rate;
+            period = SAMPLE_RATE;
+        }
+        else
+        {
+            t->countdown -= 1;
+            period = t->rate;
+        }
+        // the block may be longer than the period
+        while ( t->countdown <= 0 )
+        {
+            t->countdown += period;
+            t->dueCount += 1;
+        }
+    }
+}
+
+int     schedulerService(void)
+{
+    // a task may service the audio, which may come back here
+    static BYTE running = 0;
+    if ( running )
+        return 0;
+
+    _task* task = NULL;
+    int i;
+    for ( i=0; i<numTasks; ++i )
+    {
+        _task* t = &tasks[i];
+        if ( !t->inProgress && t->dueCount == t->handledCount )
+            continue;
+        if ( !task || t->priority > task->priority )
+            task = t;
+    }
+    if ( !task )
+        return 0;
+
+    if ( !task->inProgress )
+    {
+        unsigned int due = task->dueCount;
+        task->missed += due - task->handledCount - 1;
+        task->handledCount = due;
+        task->runs += 1;
+    }
+
+    running = 1;
+    schedulerCurrentTask = task - tasks;
+    unsigned int t0 = cpuLoadTicks();
+    task->inProgress = ( task->function() == kTaskMore );
+    unsigned int ticks = cpuLoadTicks() - t0;
+    schedulerCurrentTask = -1;
+    running = 0;
+
+    if ( ticks > task->worst )
+        task->worst = ticks;
+    if ( ticks > task->budget )
+        task->overruns += 1;
+    return 1;
+}
+
+void    schedulerResetStats(void)
+{
+    int i;
+    for ( i=0; i<numTasks; ++i )
+    {
+        tasks[i].runs = 0;
+        tasks[i].overruns = 0;
+        tasks[i].missed = 0;
+        tasks[i].worst = 0;
+    }
+}
+
+void    schedulerSendSysEx(void)
+// for each task, its name (0 terminated), priority, budget and worst
+// slice in microseconds, and runs, overruns and missed periods
+{
+    enum { kTicksPerUs = SYS_CLK_FREQ/2/1000000 };
+    enum { kMaxName = 12 };
+    BYTE buff[ kMaxTasks * ( kMaxName + 1 + 1 + 2*2 + 3*4 ) ];
+    BYTE* p = buff;
+    int i, j;
+    for ( i=0; i<numTasks; ++i )
+    {
+        const _task* t = &tasks[i];
+        for ( j=0; j<kMaxName && t->name[j]; ++j )
+            *p++ = t->name[j] & 0x7f;
+        *p++ = 0;
+        *p++ = t->priority & 0x7f;
+        p = put14( p, t->budget / kTicksPerUs );
+        p = put14( p, t->worst / kTicksPerUs );
+        p = put28( p, t->runs );
+        p = put28( p, t->overruns );
+        p = put28( p, t->missed );
+    }
+    sendBytes( 0x7C, buff, p - buff );
+}
@@ -0,0 +1,107 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef _SCHEDULER_H    /* Guard against multiple inclusion */
+#define _SCHEDULER_H
+
+#include "app.h"
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Runs everything that happens at a rate other than the audio's.
+//
+// Time is counted by the audio, which calls schedulerTick() for each
+// block it processes, so the schedule follows the audio exactly. The
+// foreground calls schedulerService() each time round, and that runs
+// one task - the highest priority one that's due, or the first added
+// of those - so nothing waits for more than one task to finish.
+//
+// A task with more to do than fits its budget does some of it and
+// returns kTaskMore, to be called again at its priority the next time
+// round, until it returns kTaskDone. Lower priority tasks don't run
+// until then, so a task that's only waiting on the hardware should return
+// kTaskDone and look again next period. Each slice is timed against the
+// budget. The slices over budget, and the periods that came round again
+// before the task had run, are counted and reported by SysEx 0x7C.
+
+enum { kMaxTasks = 8 };
+
+typedef enum {
+    kTaskDone,
+    kTaskMore,
+} _taskResult;
+
+typedef enum {
+    kRateBlocks,            // every so many audio blocks
+    kRateHz,                // so many times a second
+} _taskRate;
+
+typedef _taskResult (*_taskFunction)(void);
+
+typedef struct {
+    const char*             name;
+    _taskFunction           function;
+    BYTE                    rateType;
+    BYTE                    priority;           // higher goes first
+    BYTE                    inProgress;         // returned kTaskMore
+    int                     rate;
+    int                     countdown;          // blocks, or frames times the rate
+    unsigned int            budget;             // core timer ticks per slice
+    volatile unsigned int   dueCount;           // only the audio writes this
+    unsigned int            handledCount;       // and only the foreground this
+
+    unsigned int            runs;
+    unsigned int            overruns;           // slices over budget
+    unsigned int            missed;             // periods that went by without a run
+    unsigned int            worst;              // ticks
+} _task;
+
+extern _task tasks[kMaxTasks];
+extern int numTasks;
+
+// the index of the task that's running, or -1
+extern volatile int schedulerCurrentTask;
+
+// add the tasks before the audio starts - returns the task's index, or -1
+void    schedulerInit(void);
+int     schedulerAddTask( const char* name, _taskFunction function, _taskRate rateType, int rate, int budgetUs, int priority );
+
+// from the audio, for each block
+void    schedulerTick( int frames );
+
+// from the foreground - returns 1 if a task ran
+int     schedulerService(void);
+
+void    schedulerResetStats(void);
+void    schedulerSendSysEx(void);
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SCHEDULER_H */
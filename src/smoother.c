@@ -0,0 +1,143 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+
+Parameter smoothers.
+
+Both kinds of smoother are the same sum, so that smootherUpdate() has no
+branches on the type:
+
+    value += clamp( target - value, -step, step ) + ( ( target - value ) * coeff ) >> 16
+
+A linear smoother has coeff 0, and a step that covers the distance in
+its ramp time (set when the target changes). A one-pole has step 0, and
+a coefficient of frames per block over its time constant. If the block
+size changes, the coefficients are worked out again and the steps are
+scaled to it, so the ramps keep their times.
+
+*/
+#include "smoother.h"
+
+void    smootherInit( _smoothers* s, int count )
+{
+    memset( s, 0, sizeof *s );
+    APPLY_RANGE( count, 0, kMaxSmoothers );
+    s->count = count;
+    int i;
+    for ( i=0; i<kMaxSmoothers; ++i )
+        s->frames[i] = 1;
+}
+
+static int onePoleCoeff( int frames, int blockFrames )
+{
+    if ( frames <= blockFrames )
+        return 1 << 16;
+    return ( blockFrames << 16 ) / frames;
+}
+
+void    smootherConfigure( _smoothers* s, int i, _smoothingType type, int frames )
+{
+    if ( frames < 1 )
+        frames = 1;
+    s->type[i] = type;
+    s->frames[i] = frames;
+    s->step[i] = 0;
+    s->coeff[i] = ( type == kSmoothOnePole && s->blockFrames ) ? onePoleCoeff( frames, s->blockFrames ) : 0;
+}
+
+void    smootherSetTarget( _smoothers* s, int i, int target )
+{
+    target <<= kSmootherFracBits;
+    if ( s->type[i] == kSmoothLinear )
+    {
+        int64_t d = (int64_t)target - s->value[i];
+        if ( d < 0 )
+            d = -d;
+        // for the block size of the last update, or the current one
+        // before there's been one
+        int blockFrames = s->blockFrames ? s->blockFrames : framesPerBlock;
+        int64_t step = ( d * blockFrames ) / s->frames[i];
+        if ( step > d )
+            step = d;
+        s->step[i] = step ? (int)step : 1;
+    }
+    s->target[i] = target;
+}
+
+void    smootherJump( _smoothers* s, int i, int value )
+{
+    value <<= kSmootherFracBits;
+    s->target[i] = value;
+    s->value[i] = value;
+    s->previous[i] = value;
+}
+
+void    smootherUpdate( _smoothers* s, int frames )
+{
+    int i;
+    if ( frames != s->blockFrames )
+    {
+        int old = s->blockFrames ? s->blockFrames : framesPerBlock;
+        s->blockFrames = frames;
+        for ( i=0; i<s->count; ++i )
+        {
+            if ( s->type[i] == kSmoothOnePole )
+                s->coeff[i] = onePoleCoeff( s->frames[i], frames );
+            else if ( s->step[i] && old != frames )
+            {
+                // the same rate per frame
+                int64_t step = ( (int64_t)s->step[i] * frames ) / old;
+                if ( step > 0x7fffffff )
+                    step = 0x7fffffff;
+                s->step[i] = step ? (int)step : 1;
+            }
+        }
+    }
+
+    for ( i=0; i<s->count; ++i )
+    {
+        int v = s->value[i];
+        int d = s->target[i] - v;
+        int step = s->step[i];
+        int linear = d > step ? step : ( d < -step ? -step : d );
+        int pole = (int)( ( (int64_t)d * s->coeff[i] ) >> 16 );
+        s->previous[i] = v;
+        s->value[i] = v + linear + pole;
+    }
+}
+
+void    smootherInterpolate( const _smoothers* s, int i, int* out, int frames )
+{
+    int p = s->previous[i];
+    int inc = ( s->value[i] - p ) / frames;
+    int f;
+    for ( f=0; f<frames-1; ++f )
+    {
+        p += inc;
+        out[f] = p >> kSmootherFracBits;
+    }
+    // exactly, whatever the rounding
+    out[frames-1] = s->value[i] >> kSmootherFracBits;
+}
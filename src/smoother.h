@@ -0,0 +1,105 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef _SMOOTHER_H    /* Guard against multiple inclusion */
+#define _SMOOTHER_H
+
+#include "algorithm.h"
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Parameter smoothing, between the UI (which moves the targets at
+// SLOW_RATE, or whenever an encoder clicks) and the audio, which calls
+// smootherUpdate() once per block and reads the values back, either as
+// they are at the end of the block, or interpolated at any frame within
+// it.
+//
+// A smoother either ramps linearly to its target, taking a fixed time
+// however far it has to go, or follows it with a one-pole lowpass. The
+// times are in frames, so don't depend on the block size.
+//
+// The values are integers spanning up to 16 bits (0 to 65535, or
+// -32768 to 32767), held with kSmootherFracBits of fraction. Each field
+// is an array across all the smoothers, so the update is one branch-free
+// pass over them.
+
+enum { kMaxSmoothers = 16 };
+enum { kSmootherFracBits = 15 };
+
+typedef enum {
+    kSmoothLinear,
+    kSmoothOnePole,
+} _smoothingType;
+
+typedef struct {
+    int     value[kMaxSmoothers];
+    int     previous[kMaxSmoothers];    // at the start of the block
+    int     target[kMaxSmoothers];
+    int     step[kMaxSmoothers];        // per block if linear, otherwise 0
+    int     coeff[kMaxSmoothers];       // Q16 per block if one-pole, otherwise 0
+    int     frames[kMaxSmoothers];      // ramp time, or time constant
+    BYTE    type[kMaxSmoothers];
+    int     count;
+    int     blockFrames;                // that the steps and coefficients are for
+} _smoothers;
+
+// all at 0, and linear with no ramp (so they jump) until configured
+void    smootherInit( _smoothers* s, int count );
+void    smootherConfigure( _smoothers* s, int i, _smoothingType type, int frames );
+
+// from the foreground
+void    smootherSetTarget( _smoothers* s, int i, int target );
+// straight to the value, with no smoothing
+void    smootherJump( _smoothers* s, int i, int value );
+
+// from the audio, once per block
+void    smootherUpdate( _smoothers* s, int frames );
+
+// at the end of the block
+static inline int smootherValue( const _smoothers* s, int i )
+{
+    return s->value[i] >> kSmootherFracBits;
+}
+
+// at the given frame of the block (frames being a power of two),
+// interpolating across the block
+static inline int smootherValueAt( const _smoothers* s, int i, int frame, int frames )
+{
+    int p = s->previous[i];
+    int d = s->value[i] - p;
+    return ( p + (int)( ( (int64_t)d * ( frame + 1 ) ) >> __builtin_ctz( frames ) ) ) >> kSmootherFracBits;
+}
+
+// every frame of the block, for per-sample parameters
+void    smootherInterpolate( const _smoothers* s, int i, int* out, int frames );
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SMOOTHER_H */
@@ -0,0 +1,261 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+
+External SRAM allocation.
+
+Everything here is O(1): an arena only moves its pointer forwards (or back
+to the start), and a pool's free blocks are a linked list through the
+blocks themselves. Nothing is ever searched, so an allocation takes the
+same time however full the SRAM is, and none of it touches the SRAM
+except sramAllocZeroed(), and the pools' links.
+
+*/
+#include "sram.h"
+
+_sramArena sramArenas[kSramRegions];
+
+#ifdef DISTING_HOST
+unsigned int sramBurstWordsRead = 0;
+unsigned int sramBurstWordsWritten = 0;
+unsigned int sramBurstPagesRead = 0;
+#endif
+
+static unsigned int regionSize( int i )
+{
+    // the SRAM's configuration register is written through the last
+    // word (see APP_Initialize()), so leave that alone, and the trace
+    if ( i == kSramRegions-1 )
+        return kSramRegionSize - kSramAlign - kSramTraceBytes;
+    return kSramRegionSize;
+}
+
+void    sramInit(void)
+{
+    int i;
+    memset( sramArenas, 0, sizeof sramArenas );
+    for ( i=0; i<kSramRegions; ++i )
+    {
+        sramArenas[i].base = SRAM_ADDR + i * kSramRegionSize;
+        sramArenas[i].size = regionSize( i );
+    }
+}
+
+_sramArena* sramClaimRegion( const char* owner )
+{
+    return sramClaimRegions( owner, 1 );
+}
+
+_sramArena* sramClaimRegions( const char* owner, int count )
+{
+    int n, i, j;
+    for ( n=count; n>=1; --n )
+    {
+        for ( i=0; i+n<=kSramRegions; ++i )
+        {
+            for ( j=i; j<i+n; ++j )
+                if ( sramArenas[j].owner )
+                    break;
+            if ( j < i+n )
+                continue;
+
+            _sramArena* a = &sramArenas[i];
+            for ( j=i; j<i+n; ++j )
+            {
+                sramArenas[j].owner = owner;
+                sramArenas[j].size = 0;
+                sramArenas[j].used = 0;
+                sramArenas[j].peak = 0;
+                sramArenas[j].failures = 0;
+                sramArenas[j].regions = 0;
+                a->size += regionSize( j );
+            }
+            a->regions = n;
+            return a;
+        }
+    }
+    return NULL;
+}
+
+void    sramReleaseRegion( _sramArena* a )
+{
+    int i;
+    int first = a - sramArenas;
+    for ( i=first; i<first+a->regions; ++i )
+    {
+        sramArenas[i].owner = NULL;
+        sramArenas[i].size = regionSize( i );
+        sramArenas[i].used = 0;
+    }
+    a->regions = 0;
+}
+
+void*   sramAlloc( _sramArena* a, unsigned int bytes, unsigned int align )
+{
+    if ( !a )
+        return NULL;
+    if ( !align )
+        align = kSramAlign;
+    unsigned int start = ( a->used + align - 1 ) & ~( align - 1 );
+    if ( start > a->size || bytes > a->size - start )
+    {
+        a->failures += 1;
+        return NULL;
+    }
+    a->used = start + bytes;
+    if ( a->used > a->peak )
+        a->peak = a->used;
+    return (void*)( a->base + start );
+}
+
+void*   sramAllocZeroed( _sramArena* a, unsigned int bytes, unsigned int align )
+{
+    void* p = sramAlloc( a, bytes, align );
+    if ( p )
+        memset( p, 0, bytes );
+    return p;
+}
+
+void    sramReset( _sramArena* a )
+{
+    a->used = 0;
+}
+
+int     sramPoolInit( _sramPool* p, _sramArena* a, unsigned int blockSize, int count )
+{
+    memset( p, 0, sizeof *p );
+    // room for the link, and keeping each block aligned
+    if ( blockSize < sizeof(void*) )
+        blockSize = sizeof(void*);
+    blockSize = ( blockSize + kSramAlign - 1 ) & ~( kSramAlign - 1 );
+    BYTE* blocks = (BYTE*)sramAlloc( a, blockSize * count, 0 );
+    if ( !blocks )
+        return -1;
+
+    p->blockSize = blockSize;
+    p->count = count;
+    p->free = count;
+    p->minFree = count;
+    int i;
+    for ( i=count-1; i>=0; --i )
+    {
+        void* b = blocks + i * blockSize;
+        *(void**)b = p->freeList;
+        p->freeList = b;
+    }
+    return 0;
+}
+
+void*   sramPoolAlloc( _sramPool* p )
+{
+    void* b = p->freeList;
+    if ( !b )
+        return NULL;
+    p->freeList = *(void**)b;
+    p->free -= 1;
+    if ( p->free < p->minFree )
+        p->minFree = p->free;
+    return b;
+}
+
+void    sramPoolFree( _sramPool* p, void* block )
+{
+    *(void**)block = p->freeList;
+    p->freeList = block;
+    p->free += 1;
+}
+
+void    sramBurstRead( unsigned int* dst, const unsigned int* src, int words )
+{
+#ifdef DISTING_HOST
+    sramBurstWordsRead += words;
+    sramBurstPagesRead += ( ( (uintptr_t)( src + words ) + kSramPageBytes - 1 ) / kSramPageBytes ) - (uintptr_t)src / kSramPageBytes;
+#endif
+    // up to the start of a page
+    while ( words > 0 && ( (uintptr_t)src & ( kSramPageBytes - 1 ) ) )
+    {
+        *dst++ = *src++;
+        words -= 1;
+    }
+    // then a page at a time, all the reads together
+    while ( words >= 8 )
+    {
+        unsigned int w0 = src[0], w1 = src[1], w2 = src[2], w3 = src[3];
+        unsigned int w4 = src[4], w5 = src[5], w6 = src[6], w7 = src[7];
+        dst[0] = w0; dst[1] = w1; dst[2] = w2; dst[3] = w3;
+        dst[4] = w4; dst[5] = w5; dst[6] = w6; dst[7] = w7;
+        src += 8;
+        dst += 8;
+        words -= 8;
+    }
+    while ( words-- > 0 )
+        *dst++ = *src++;
+}
+
+void    sramBurstWrite( unsigned int* dst, const unsigned int* src, int words )
+{
+#ifdef DISTING_HOST
+    sramBurstWordsWritten += words;
+#endif
+    while ( words > 0 && ( (uintptr_t)dst & ( kSramPageBytes - 1 ) ) )
+    {
+        *dst++ = *src++;
+        words -= 1;
+    }
+    while ( words >= 8 )
+    {
+        unsigned int w0 = src[0], w1 = src[1], w2 = src[2], w3 = src[3];
+        unsigned int w4 = src[4], w5 = src[5], w6 = src[6], w7 = src[7];
+        dst[0] = w0; dst[1] = w1; dst[2] = w2; dst[3] = w3;
+        dst[4] = w4; dst[5] = w5; dst[6] = w6; dst[7] = w7;
+        src += 8;
+        dst += 8;
+        words -= 8;
+    }
+    while ( words-- > 0 )
+        *dst++ = *src++;
+}
+
+void    sramSendSysEx(void)
+// for each region, its owner (0 terminated, empty if free), then its
+// size, bytes used, peak and failed allocations as 28 bit values
+{
+    enum { kMaxOwner = 12 };
+    BYTE buff[ kSramRegions * ( kMaxOwner + 1 + 4*4 ) ];
+    BYTE* p = buff;
+    int i, j;
+    for ( i=0; i<kSramRegions; ++i )
+    {
+        const _sramArena* a = &sramArenas[i];
+        for ( j=0; a->owner && j<kMaxOwner && a->owner[j]; ++j )
+            *p++ = a->owner[j] & 0x7f;
+        *p++ = 0;
+        p = put28( p, a->size );
+        p = put28( p, a->used );
+        p = put28( p, a->peak );
+        p = put28( p, a->failures );
+    }
+    sendBytes( 0x7D, buff, p - buff );
+}
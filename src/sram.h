@@ -0,0 +1,145 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef _SRAM_H    /* Guard against multiple inclusion */
+#define _SRAM_H
+
+#include "app.h"
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The external SRAM, for algorithms' big buffers.
+//
+// It's divided into fixed regions, each with an arena that allocates by
+// bumping a pointer, and is reset in one go. algorithm.cc gives each
+// running algorithm that asks for SRAM (see Algorithm::sramRegions()) a
+// region, reset before its init(), and takes it back at the next change
+// once the algorithm has stopped. Algorithms that don't ask hold none.
+// There are enough for a region in each slot of the dual mode, plus two
+// more for the algorithms being initialised while the old ones run on
+// (see algorithmSwitchService()). If the old ones hold what the new ones
+// need - an algorithm can ask for all four - the change stops the audio
+// instead, and the old regions are given back first.
+//
+// Allocations are returned as cached pointers. sramUncached() gives the
+// same memory without the cache, for buffers the DMA touches, or that
+// are written in one place and read in another without a cache flush.
+// Don't mix the two views without writing back or invalidating the
+// cache in between.
+//
+// A pool divides an allocation into fixed size blocks (such as the
+// pieces of a delay line), which are taken and given back in any order.
+//
+// An algorithm that needs more than a region (see
+// Algorithm::sramRegions()) is given adjacent ones, as one arena in the
+// first. The others are marked with the same owner, and a size of 0.
+//
+// Streaming audio to and from the SRAM is quickest in runs of whole EBI
+// pages, where the reads after the first in each page take TPRC rather
+// than TRC. sramBurstRead() and sramBurstWrite() copy a run of words a
+// page at a time, and are best used on the uncached view, which doesn't
+// flush everything else out of the cache.
+
+enum { kSramRegions = 4 };
+enum { kSramRegionSize = SRAM_SIZE / kSramRegions };
+
+// the default alignment, which is a cache line
+enum { kSramAlign = 16 };
+
+// the EBI page, of 16 halfwords (PAGESIZE in EBISMT0, see APP_Initialize())
+enum { kSramPageBytes = 32 };
+
+// the top of the SRAM is kept out of the last region - the event trace
+// (see trace.h), then the SRAM's configuration register
+enum { kSramTraceBytes = 128 * 1024 };
+#define SRAM_TRACE_ADDR ( SRAM_ADDR_UNCACHED + SRAM_SIZE - kSramAlign - kSramTraceBytes )
+
+typedef struct {
+    const char*     owner;              // or NULL if free
+    uintptr_t       base;               // cached address
+    unsigned int    size;
+    unsigned int    used;
+    unsigned int    peak;               // since claimed
+    unsigned int    failures;           // allocations that didn't fit
+    BYTE            regions;            // adjacent regions in the arena
+} _sramArena;
+
+typedef struct {
+    void*           freeList;           // linked through the first word of each block
+    unsigned int    blockSize;
+    int             count;
+    int             free;
+    int             minFree;            // the low water mark
+} _sramPool;
+
+extern _sramArena sramArenas[kSramRegions];
+
+void    sramInit(void);
+
+// a free region, reset, or NULL if there isn't one
+_sramArena* sramClaimRegion( const char* owner );
+// as many adjacent free regions as there are, up to count
+_sramArena* sramClaimRegions( const char* owner, int count );
+void    sramReleaseRegion( _sramArena* a );
+
+// NULL if it doesn't fit - align is a power of two, or 0 for kSramAlign
+void*   sramAlloc( _sramArena* a, unsigned int bytes, unsigned int align );
+void*   sramAllocZeroed( _sramArena* a, unsigned int bytes, unsigned int align );
+void    sramReset( _sramArena* a );
+
+// returns 0, or -1 if the blocks don't fit in the arena
+int     sramPoolInit( _sramPool* p, _sramArena* a, unsigned int blockSize, int count );
+void*   sramPoolAlloc( _sramPool* p );
+void    sramPoolFree( _sramPool* p, void* block );
+
+// words, from or to the SRAM
+void    sramBurstRead( unsigned int* dst, const unsigned int* src, int words );
+void    sramBurstWrite( unsigned int* dst, const unsigned int* src, int words );
+
+void    sramSendSysEx(void);
+
+#ifdef DISTING_HOST
+// the traffic through the bursts, which the looper benchmark reports
+extern unsigned int sramBurstWordsRead, sramBurstWordsWritten, sramBurstPagesRead;
+#endif
+
+static inline __attribute__((always_inline)) void* sramUncached( void* p )
+{
+    return (void*)( (uintptr_t)p - SRAM_ADDR + SRAM_ADDR_UNCACHED );
+}
+
+static inline __attribute__((always_inline)) void* sramCached( void* p )
+{
+    return (void*)( (uintptr_t)p - SRAM_ADDR_UNCACHED + SRAM_ADDR );
+}
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SRAM_H */
@@ -0,0 +1,401 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+
+External SRAM test and benchmark.
+
+The march test is March C-:
+
+    up/down(w0); up(r0,w1); up(r1,w0); down(r0,w1); down(r1,w0); up/down(r0)
+
+run once for each data background (0 being the background, and 1 its
+complement), which between them put every pair of bits in a word through
+all four combinations, so that coupling within a word shows up too.
+
+*/
+#include "sramtest.h"
+#include "cpuload.h"
+#include "system_config/default/framework/system/devcon/src/sys_devcon_local.h"
+
+_sramTest sramTest = { kSramTestIdle };
+
+static const _sramTiming kTimings[] = {
+    { 6, 1, 1, 3, 2 },              // as set up by APP_Initialize()
+    { 8, 2, 1, 4, 3 },
+    { 5, 1, 1, 2, 1 },
+};
+
+// sequentially, twice the size of the data cache, so that it's all misses
+enum { kBenchBytes = 32 * 1024 };
+// and randomly, over an area well beyond the cache
+enum { kBenchRandomAccesses = 4096 };
+enum { kBenchRandomBytes = 256 * 1024 };
+
+enum { kD, kNotD, kNone };
+
+static const struct {
+    BYTE    read;
+    BYTE    write;
+    BYTE    down;
+} kMarch[] = {
+    { kNone, kD, 0 },
+    { kD, kNotD, 0 },
+    { kNotD, kD, 0 },
+    { kD, kNotD, 1 },
+    { kNotD, kD, 1 },
+    { kD, kNone, 0 },
+};
+
+static const unsigned int kBackgrounds[] = {
+    0x00000000, 0x55555555, 0x33333333, 0x0f0f0f0f, 0x00ff00ff, 0x0000ffff,
+};
+
+// words per call in a region of the test's own,
+// and in one of an algorithm's with the interrupts off
+enum { kSliceWords = 1024 };
+enum { kChunkWords = 16 };
+
+static unsigned int restoreInterrupts( unsigned int status )
+{
+    if ( status & 0x00000001 )
+        return __builtin_enable_interrupts();
+    return __builtin_disable_interrupts();
+}
+
+//
+// benchmark
+//
+
+static unsigned int kBytesPerSecond( unsigned int bytes, unsigned int ticks )
+// in KB/s
+{
+    if ( !ticks )
+        ticks = 1;
+    return ( (uint64_t)bytes * ( SYS_CLK_FREQ/2 ) ) / ( (uint64_t)ticks * 1024 );
+}
+
+static unsigned int nextRandom( unsigned int* seed )
+{
+    *seed = *seed * 1664525 + 1013904223;
+    return *seed >> 8;
+}
+
+static unsigned int timeSequentialWrite( unsigned int* p, int cached, unsigned int seed )
+{
+    volatile unsigned int* v = p;
+    unsigned int status = __builtin_disable_interrupts();
+    unsigned int t0 = cpuLoadTicks();
+    int i;
+    for ( i=0; i<kBenchBytes/4; ++i )
+        v[i] = i ^ seed;
+    // which hasn't been written until it's out of the cache
+    if ( cached )
+        _pic32_clean_dcache( (uint32_t)(uintptr_t)p, kBenchBytes );
+    unsigned int ticks = cpuLoadTicks() - t0;
+    restoreInterrupts( status );
+    return ticks;
+}
+
+static unsigned int timeSequentialRead( unsigned int* p, int cached, unsigned int seed, unsigned int* errors )
+// and checks what the write left
+{
+    volatile unsigned int* v = p;
+    if ( cached )
+        _pic32_clean_dcache_nowrite( (uint32_t)(uintptr_t)p, kBenchBytes );
+    unsigned int status = __builtin_disable_interrupts();
+    unsigned int t0 = cpuLoadTicks();
+    unsigned int bad = 0;
+    int i;
+    for ( i=0; i<kBenchBytes/4; ++i )
+        bad += ( v[i] != ( i ^ seed ) );
+    unsigned int ticks = cpuLoadTicks() - t0;
+    restoreInterrupts( status );
+    *errors += bad;
+    return ticks;
+}
+
+// where the random reads go, so that they aren't optimised away
+static volatile unsigned int randomSum;
+
+static unsigned int timeRandom( unsigned int* p, int cached, int write )
+{
+    volatile unsigned int* v = p;
+    unsigned int seed = 1;
+    unsigned int sum = 0;
+    if ( cached )
+        _pic32_clean_dcache( (uint32_t)(uintptr_t)p, kBenchRandomBytes );
+    unsigned int status = __builtin_disable_interrupts();
+    unsigned int t0 = cpuLoadTicks();
+    int i;
+    if ( write )
+    {
+        for ( i=0; i<kBenchRandomAccesses; ++i )
+            v[ nextRandom( &seed ) & ( kBenchRandomBytes/4 - 1 ) ] = i;
+        if ( cached )
+            _pic32_clean_dcache( (uint32_t)(uintptr_t)p, kBenchRandomBytes );
+    }
+    else
+    {
+        for ( i=0; i<kBenchRandomAccesses; ++i )
+            sum += v[ nextRandom( &seed ) & ( kBenchRandomBytes/4 - 1 ) ];
+    }
+    unsigned int ticks = cpuLoadTicks() - t0;
+    restoreInterrupts( status );
+    randomSum = sum;
+    return ticks;
+}
+
+void    sramBenchmark(void)
+// for each timing, its five values, then for page mode off and on, and for
+// the uncached and cached views, sequential read, sequential write, random
+// read and random write in KB/s as 28 bit values, and the words that
+// didn't read back as written as a 14 bit value - or nothing, if there
+// isn't a free region to use
+{
+    BYTE buff[ ARRAY_SIZE( kTimings ) * ( 5 + 2 * 2 * ( 4*4 + 2 ) ) ];
+    BYTE* p = buff;
+
+    _sramArena* a = sramClaimRegion( "benchmark" );
+    if ( !a )
+    {
+        sendBytes( 0x7E, buff, 0 );
+        return;
+    }
+    unsigned int* cached = (unsigned int*)a->base;
+    unsigned int* uncached = (unsigned int*)sramUncached( cached );
+
+    unsigned int saved = EBISMT0;
+    int t, pageMode, c;
+    for ( t=0; t<ARRAY_SIZE( kTimings ); ++t )
+    {
+        const _sramTiming* timing = &kTimings[t];
+        *p++ = timing->trc;
+        *p++ = timing->tas;
+        *p++ = timing->twr;
+        *p++ = timing->twp;
+        *p++ = timing->tprc;
+        for ( pageMode=0; pageMode<2; ++pageMode )
+        {
+            // PAGESIZE and TBTA as APP_Initialize()
+            EBISMT0 = ( 2 << 24 ) | ( timing->tprc << 19 ) | ( 0 << 16 ) | ( timing->twp << 10 )
+                    | ( timing->twr << 8 ) | ( timing->tas << 6 ) | ( timing->trc << 0 );
+            EBISMT0bits.PAGEMODE = pageMode;
+
+            for ( c=0; c<2; ++c )
+            {
+                unsigned int* m = c ? cached : uncached;
+                unsigned int seed = ( t << 8 ) | ( pageMode << 4 ) | c;
+                unsigned int errors = 0;
+                unsigned int w = timeSequentialWrite( m, c, seed );
+                unsigned int r = timeSequentialRead( m, c, seed, &errors );
+                p = put28( p, kBytesPerSecond( kBenchBytes, r ) );
+                p = put28( p, kBytesPerSecond( kBenchBytes, w ) );
+                p = put28( p, kBytesPerSecond( 4 * kBenchRandomAccesses, timeRandom( m, c, 0 ) ) );
+                p = put28( p, kBytesPerSecond( 4 * kBenchRandomAccesses, timeRandom( m, c, 1 ) ) );
+                p = put14( p, errors );
+            }
+        }
+    }
+    EBISMT0 = saved;
+
+    sramReleaseRegion( a );
+    sendBytes( 0x7E, buff, p - buff );
+}
+
+//
+// march test
+//
+
+static void checkWord( volatile unsigned int* w, unsigned int expected )
+{
+    unsigned int v = *w;
+    if ( v == expected )
+        return;
+    if ( !sramTest.errors )
+    {
+        sramTest.failedOffset = (uintptr_t)w - SRAM_ADDR_UNCACHED;
+        sramTest.expected = expected;
+        sramTest.actual = v;
+    }
+    sramTest.errors += 1;
+}
+
+static void march( volatile unsigned int* base, unsigned int words, int element, unsigned int from, unsigned int count, unsigned int d )
+// words from..from+count of the element's order
+{
+    int read = kMarch[ element ].read;
+    int write = kMarch[ element ].write;
+    unsigned int r = ( read == kNotD ) ? ~d : d;
+    unsigned int w = ( write == kNotD ) ? ~d : d;
+    unsigned int i;
+    for ( i=from; i<from+count; ++i )
+    {
+        volatile unsigned int* p = base + ( kMarch[ element ].down ? words - 1 - i : i );
+        if ( read != kNone )
+            checkWord( p, r );
+        if ( write != kNone )
+            *p = w;
+    }
+}
+
+static void marchChunk( volatile unsigned int* chunk, unsigned int words, unsigned int d )
+// all of it, putting back what was there
+{
+    unsigned int saved[kChunkWords];
+    unsigned int i;
+    int e;
+    unsigned int status = __builtin_disable_interrupts();
+    // anything the algorithm has in the cache goes out first,
+    // so it can't be written back over the test
+    _pic32_clean_dcache( (uint32_t)(uintptr_t)sramCached( (void*)chunk ), words * 4 );
+    for ( i=0; i<words; ++i )
+        saved[i] = chunk[i];
+    for ( e=0; e<ARRAY_SIZE( kMarch ); ++e )
+        march( chunk, words, e, 0, words, d );
+    for ( i=0; i<words; ++i )
+        chunk[i] = saved[i];
+    restoreInterrupts( status );
+}
+
+static volatile unsigned int* regionWords( int region, unsigned int* words )
+// a region's arena, or after the last, the event trace (see sram.h)
+{
+    if ( region == kSramRegions )
+    {
+        *words = kSramTraceBytes / 4;
+        return (volatile unsigned int*)SRAM_TRACE_ADDR;
+    }
+    const _sramArena* a = &sramArenas[ region ];
+    *words = a->size / 4;
+    return (volatile unsigned int*)sramUncached( (void*)a->base );
+}
+
+static void releaseRegions(void)
+{
+    int i;
+    for ( i=0; i<kSramRegions; ++i )
+        if ( sramTest.claimed & ( 1 << i ) )
+            sramReleaseRegion( &sramArenas[i] );
+    sramTest.claimed = 0;
+}
+
+void    sramTestStart(void)
+{
+    if ( sramTest.state == kSramTestRunning )
+        return;
+    unsigned int passes = sramTest.passes;
+    memset( &sramTest, 0, sizeof sramTest );
+    sramTest.passes = passes;
+    for ( ;; )
+    {
+        _sramArena* a = sramClaimRegion( "test" );
+        if ( !a )
+            break;
+        sramTest.claimed |= 1 << ( a - sramArenas );
+    }
+    sramTest.state = kSramTestRunning;
+}
+
+void    sramTestStop(void)
+{
+    if ( sramTest.state != kSramTestRunning )
+        return;
+    releaseRegions();
+    sramTest.state = kSramTestStopped;
+}
+
+_taskResult sramTestTask(void)
+{
+    if ( sramTest.state != kSramTestRunning )
+        return kTaskDone;
+
+    unsigned int words;
+    volatile unsigned int* base = regionWords( sramTest.region, &words );
+    unsigned int d = kBackgrounds[ sramTest.background ];
+    unsigned int n;
+
+    if ( sramTest.claimed & ( 1 << sramTest.region ) )
+    {
+        // each element across the whole region
+        n = words - sramTest.index;
+        if ( n > kSliceWords )
+            n = kSliceWords;
+        march( base, words, sramTest.element, sramTest.index, n, d );
+        sramTest.index += n;
+        if ( sramTest.index < words )
+            return kTaskMore;
+        sramTest.index = 0;
+        if ( ++sramTest.element < ARRAY_SIZE( kMarch ) )
+            return kTaskMore;
+        sramTest.element = 0;
+    }
+    else
+    {
+        // an algorithm's, or the trace, so all the elements a chunk at a time
+        unsigned int first = sramTest.index * kChunkWords;
+        n = words - first;
+        if ( n > kChunkWords )
+            n = kChunkWords;
+        marchChunk( base + first, n, d );
+        sramTest.index += 1;
+        if ( first + n < words )
+            return kTaskMore;
+        sramTest.index = 0;
+    }
+
+    if ( ++sramTest.background < ARRAY_SIZE( kBackgrounds ) )
+        return kTaskMore;
+    sramTest.background = 0;
+    if ( ++sramTest.region <= kSramRegions )
+        return kTaskMore;
+
+    releaseRegions();
+    sramTest.passes += 1;
+    sramTest.state = sramTest.errors ? kSramTestFailed : kSramTestPassed;
+    return kTaskDone;
+}
+
+void    sramTestSendSysEx(void)
+// the state, the regions tested destructively (a bit each), the region
+// (kSramRegions for the trace), background and element under test, then the word or chunk, passes,
+// errors, and the first error's offset, expected and actual values as
+// 28 bit values - the last two are 32 bit values, so 5 bytes each
+{
+    BYTE buff[ 5 + 4*4 + 2*5 ];
+    BYTE* p = buff;
+    const _sramTest t = sramTest;
+    *p++ = t.state;
+    *p++ = t.claimed;
+    *p++ = t.region;
+    *p++ = t.background;
+    *p++ = t.element;
+    p = put28( p, t.index );
+    p = put28( p, t.passes );
+    p = put28( p, t.errors );
+    p = put28( p, t.failedOffset );
+    p = put32( p, t.expected );
+    p = put32( p, t.actual );
+    sendBytes( 0x7F, buff, p - buff );
+}
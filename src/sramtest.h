@@ -0,0 +1,101 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef _SRAMTEST_H    /* Guard against multiple inclusion */
+#define _SRAMTEST_H
+
+#include "sram.h"
+#include "scheduler.h"
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Testing and benchmarking the external SRAM.
+//
+// sramBenchmark() times sequential and random reads and writes of a free
+// region, through the cached and uncached views, with the EBI's page mode
+// off and on, and for each of a table of EBISMT0 timings. It takes a
+// second or so, with the audio paused (see checkSRAMBenchmark() in
+// app.c), and replies with SysEx 0x7E.
+//
+// The march test (March C-, with each of the data backgrounds a 32 bit
+// word needs) runs in the background, as a scheduler task. It takes the
+// free regions for itself, and marches across each in turn. The regions
+// that running algorithms own are tested a few words at a time instead,
+// with the interrupts off while each chunk is saved, marched and put back,
+// so that the algorithms never see it. The event trace's area, after the
+// last region, is tested the same way, so the whole array is covered but
+// for the word holding the SRAM's configuration. An algorithm change stops it
+// before the new algorithms claim their regions (see
+// algorithmApplyRequest() and algorithmSwitchService()).
+// SysEx 0x7F starts or stops it, and reports on it.
+
+// the timings benchmarked, in EBI clocks (see EBISMT0 in the datasheet)
+typedef struct {
+    BYTE    trc;            // read cycle
+    BYTE    tas;            // address setup
+    BYTE    twr;            // write recovery
+    BYTE    twp;            // write pulse
+    BYTE    tprc;           // page read cycle
+} _sramTiming;
+
+enum {
+    kSramTestIdle,
+    kSramTestRunning,
+    kSramTestPassed,
+    kSramTestFailed,
+    kSramTestStopped,       // by request, or an algorithm change
+};
+
+typedef struct {
+    BYTE            state;
+    BYTE            claimed;            // a bit per region, taken for the test
+    BYTE            region;             // kSramRegions for the trace
+    BYTE            background;
+    BYTE            element;
+    unsigned int    index;              // word, or chunk in an owned region
+    unsigned int    passes;             // of the whole array
+    unsigned int    errors;
+    unsigned int    failedOffset;       // the first error, from SRAM_ADDR
+    unsigned int    expected;
+    unsigned int    actual;
+} _sramTest;
+
+extern _sramTest sramTest;
+
+void    sramBenchmark(void);
+
+void    sramTestStart(void);
+void    sramTestStop(void);
+_taskResult sramTestTask(void);
+void    sramTestSendSysEx(void);
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SRAMTEST_H */
@@ -0,0 +1,123 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "app.h"
+#include "display.h"
+#include "text.h"
+
+#include "fonts/fonts.h"
+
+const _font font8x8 = { 8, 0, font8x8Widths, font8x8Offsets, font8x8Columns };
+const _font fontProportional = { 8, 1, fontProportionalWidths, fontProportionalOffsets, fontProportionalColumns };
+const _font fontLarge = { 16, 2, fontLargeWidths, fontLargeOffsets, fontLargeColumns };
+
+int displayWindowX = 0;
+int displayWindowWidth = 128;
+
+void setDisplayWindow( int x, int width )
+{
+    displayWindowX = x;
+    displayWindowWidth = width;
+}
+
+static inline __attribute__((always_inline)) void blitGlyph( const unsigned int* src, int width, int x, int y )
+{
+    // the glyph's columns that are inside the window
+    int i0 = 0;
+    int i1 = width;
+    if ( x < 0 )
+        i0 = -x;
+    if ( x + width > displayWindowWidth )
+        i1 = displayWindowWidth - x;
+    if ( i0 >= i1 )
+        return;
+
+    unsigned int* dst = screen + displayWindowX;
+    int i;
+    if ( y >= 0 )
+    {
+        if ( y > 31 )
+            return;
+        for ( i=i0; i<i1; ++i )
+            dst[ x + i ] |= src[i] << y;
+    }
+    else
+    {
+        if ( y < -31 )
+            return;
+        for ( i=i0; i<i1; ++i )
+            dst[ x + i ] |= src[i] >> -y;
+    }
+}
+
+int drawCharFont( const _font* font, int x, int y, char c )
+{
+    int index = c - kFontFirstChar;
+    if ( index < 0 || index >= kFontGlyphs )
+        return x;
+    int width = font->widths[ index ];
+    blitGlyph( font->columns + font->offsets[ index ], width, x, y );
+    return x + width + font->spacing;
+}
+
+int drawStringFont( const _font* font, int x, int y, const char* str )
+{
+    for ( ;; )
+    {
+        char c = *str++;
+        if ( !c )
+            break;
+        x = drawCharFont( font, x, y, c );
+        CHECK_SERVICE_AUDIO
+    }
+    return x;
+}
+
+int stringWidthFont( const _font* font, const char* str )
+{
+    int x = 0;
+    for ( ;; )
+    {
+        char c = *str++;
+        if ( !c )
+            break;
+        int index = c - kFontFirstChar;
+        if ( index >= 0 && index < kFontGlyphs )
+            x += font->widths[ index ] + font->spacing;
+    }
+    // no spacing after the last glyph
+    if ( x )
+        x -= font->spacing;
+    return x;
+}
+
+void drawChar88( int x, int y, char c )
+{
+    drawCharFont( &font8x8, x, y, c );
+}
+
+void drawString88( int x, int y, const char* str )
+{
+    drawStringFont( &font8x8, x, y, str );
+}
@@ -0,0 +1,66 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef _TEXT_H
+#define _TEXT_H
+
+#include "app.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Fonts are rasterised ahead of time by host/fontgen.c into a word per
+// glyph column, with the glyph's top row in bit 0. Drawing a glyph at a
+// given row is then one shift and OR per column of the screen, and the
+// clipping to the display window (see display.h) is done once per glyph.
+//
+// Each font covers the 96 characters from ' '.
+
+enum { kFontFirstChar = 32 };
+enum { kFontGlyphs = 96 };
+
+typedef struct {
+    BYTE                height;     // in pixels, up to 32
+    BYTE                spacing;    // blank columns after each glyph
+    const BYTE*         widths;     // of each glyph, in columns
+    const WORD*         offsets;    // of each glyph's first column in columns
+    const unsigned int* columns;
+} _font;
+
+extern const _font font8x8;             // as drawString88()
+extern const _font fontProportional;    // 8 high
+extern const _font fontLarge;           // 16 high
+
+// return the x after the last glyph
+int drawCharFont( const _font* font, int x, int y, char c );
+int drawStringFont( const _font* font, int x, int y, const char* str );
+
+int stringWidthFont( const _font* font, const char* str );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _TEXT_H */
@@ -0,0 +1,172 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+
+The event trace (see trace.h). Events come from the interrupts as well as
+the foreground, so each one is written with the interrupts off.
+
+*/
+#include "trace.h"
+#include "cpuload.h"
+
+#ifdef EVENT_TRACE
+
+#define traceBuffer ( (volatile _traceRecord*)SRAM_TRACE_ADDR )
+
+volatile BYTE traceRunning = 0;
+
+// the events written since the trace was started
+static volatile unsigned int traceCount = 0;
+// to stop after an overflow, or 0
+static volatile BYTE traceArmed = 0;
+static volatile unsigned int traceStopAt = 0;
+
+void    traceInit(void)
+{
+    traceCount = 0;
+    traceArmed = 0;
+    traceStopAt = 0;
+    traceRunning = 1;
+}
+
+void    traceEvent( _traceEventType type, unsigned int arg )
+{
+    unsigned int status = __builtin_disable_interrupts();
+    if ( traceRunning )
+    {
+        unsigned int n = traceCount;
+        volatile _traceRecord* r = &traceBuffer[ n & ( kTraceEvents-1 ) ];
+        r->time = cpuLoadTicks();
+        r->event = ( type << 24 ) | ( arg & 0xffffff );
+        traceCount = n + 1;
+        if ( type == kTraceOverflow && traceArmed )
+        {
+            traceArmed = 0;
+            traceStopAt = n + kTraceEvents/2;
+        }
+        else if ( traceStopAt && n + 1 == traceStopAt )
+        {
+            traceStopAt = 0;
+            traceRunning = 0;
+        }
+    }
+    if ( status & 1 )
+        __builtin_enable_interrupts();
+}
+
+// a dump that's still going out (see traceDumpTask())
+static struct {
+    BYTE            active;
+    BYTE            running;            // to go back to afterwards
+    unsigned int    written;
+    unsigned int    count;
+    unsigned int    next;
+} traceDump = { 0 };
+
+enum { kTicksPerUs = SYS_CLK_FREQ/2/1000000 };
+
+static void sendTraceMessage( BYTE running, unsigned int first, int n )
+// the header, then n events from first
+{
+    BYTE buff[ 1 + 1 + 3*4 + kTraceEventsPerMessage*10 ];
+    BYTE* p = buff;
+    *p++ = running | ( traceArmed << 1 );
+    *p++ = kTicksPerUs;
+    p = put28( p, traceDump.written );
+    p = put28( p, traceDump.count );
+    p = put28( p, first );
+    int i;
+    for ( i=0; i<n; ++i )
+    {
+        volatile _traceRecord* r = &traceBuffer[ ( traceDump.written - traceDump.count + first + i ) & ( kTraceEvents-1 ) ];
+        p = put32( p, r->time );
+        *p++ = ( r->event >> 24 ) & 0x7f;
+        p = put28( p, r->event & 0xffffff );
+    }
+    sendBytes( 0x62, buff, p - buff );
+}
+
+void    traceCommand( int command, int count )
+// 0 stops the trace, 1 (re)starts it, 2 restarts it to stop half a buffer
+// after the next overflow, and 3 dumps the latest count events (all of them
+// for 0). Any of them cuts short a dump that's still going.
+{
+    if ( traceDump.active )
+    {
+        traceDump.active = 0;
+        traceRunning = traceDump.running;
+    }
+
+    if ( command == 0 )
+        traceRunning = 0;
+    else if ( command == 1 || command == 2 )
+    {
+        traceRunning = 0;
+        traceInit();
+        traceArmed = ( command == 2 );
+    }
+
+    BYTE running = traceRunning;
+    unsigned int written = traceCount;
+    unsigned int n = written < kTraceEvents ? written : kTraceEvents;
+    if ( command != 3 )
+        n = 0;
+    else if ( count && count < n )
+        n = count;
+
+    traceDump.running = running;
+    traceDump.written = written;
+    traceDump.count = n;
+    traceDump.next = 0;
+    if ( n )
+    {
+        // no more events until it's gone, or the dump would be all MIDI out
+        traceRunning = 0;
+        traceDump.active = 1;
+    }
+    sendTraceMessage( running, 0, 0 );
+}
+
+_taskResult traceDumpTask(void)
+// a message at a time, once there's room for it in the MIDI queue
+{
+    enum { kMessageBytes = 7 + 1 + 1 + 3*4 + kTraceEventsPerMessage*10 + 1 };
+
+    if ( !traceDump.active || MIDIOutQueueSpace() < kMessageBytes )
+        return kTaskDone;
+    int n = traceDump.count - traceDump.next;
+    if ( n > kTraceEventsPerMessage )
+        n = kTraceEventsPerMessage;
+    sendTraceMessage( traceDump.running, traceDump.next, n );
+    traceDump.next += n;
+    if ( traceDump.next >= traceDump.count )
+    {
+        traceDump.active = 0;
+        traceRunning = traceDump.running;
+    }
+    return kTaskDone;
+}
+
+#endif
@@ -0,0 +1,110 @@
+/*
+MIT License
+
+Copyright (c) 2023 Expert Sleepers Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef _TRACE_H    /* Guard against multiple inclusion */
+#define _TRACE_H
+
+#include "app.h"
+#include "sram.h"
+#include "scheduler.h"
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A rolling trace of timestamped events, for glitches too rare to catch
+// on a scope. The events go into a ring buffer at the top of the external
+// SRAM (see kSramTraceBytes), two words each: the core timer, and the event
+// type in the top byte with its argument below. It runs from startup
+// when EVENT_TRACE is defined (see app.h), and otherwise TRACE() compiles to
+// nothing.
+//
+// SysEx message 0x62 stops and starts it, or arms it to stop half a buffer
+// after the next queue overflow, so that the overflow is in the middle,
+// and dumps the latest events. host/trace_json turns a dump into a
+// Chrome trace (or Perfetto) JSON file.
+//
+// Each 0x62 message has whether the trace is running or armed (a bit each),
+// the core timer ticks per microsecond, the events written since it
+// started, the number in the dump and the first in this message as 28 bit
+// values, then its events, oldest first: the time as a 32 bit value
+// (5 bytes), the type, and the argument (28 bits). The reply to a command
+// has none. A dump follows it in messages of kTraceEventsPerMessage events,
+// sent by traceDumpTask() as the MIDI output has room, with the trace
+// stopped until the last has gone.
+
+typedef enum {
+    kTraceAudioBlock = 1,       // at the end of a block - its duration in ticks
+    kTraceMIDIIn,               // the byte
+    kTraceMIDIOut,              // the byte
+    kTraceI2CAddress,           // the address byte, with read in bit 0
+    kTraceI2CIn,                // the byte
+    kTraceI2COut,               // the byte, or 0x100 if there was none
+    kTraceDisplayStart,
+    kTraceDisplayEnd,
+    kTraceNVMStart,             // the NVMCON operation
+    kTraceNVMEnd,
+    kTraceOverflow,             // the queue (below)
+} _traceEventType;
+
+typedef enum {
+    kTraceQueueMIDIIn,
+    kTraceQueueSelectIn,
+    kTraceQueueI2CIn,
+} _traceQueue;
+
+typedef struct {
+    unsigned int    time;       // core timer ticks
+    unsigned int    event;      // type << 24 | argument
+} _traceRecord;
+
+enum { kTraceEvents = kSramTraceBytes / sizeof( _traceRecord ) };
+
+// 10 bytes each
+enum { kTraceEventsPerMessage = 16 };
+
+#ifdef EVENT_TRACE
+
+extern volatile BYTE traceRunning;
+
+void    traceInit(void);
+void    traceEvent( _traceEventType type, unsigned int arg );
+void    traceCommand( int command, int count );
+_taskResult traceDumpTask(void);
+
+#define TRACE( type, arg )      { if ( traceRunning ) traceEvent( type, arg ); }
+
+#else
+
+#define TRACE( type, arg )      {}
+
+#endif
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _TRACE_H */